@@ -26,6 +26,20 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - thread_queue_size_max field added to OptionsContext,
+ * set_input_stats_callback() method declared
+ * - ifile_packet_release() declared
+ * - sched_idx field added to OutputStream, ost_sched_update() and
+ * ost_set_unavailable() declared
+ * - loop_cache_size field added to OptionsContext
+ * - set_output_stats_callback() method declared
+ * - concat_prefetch and concat_prefetch_size fields added to OptionsContext
+ * - digest field added to OptionsContext
+ * - seek_index field added to OptionsContext
+ * - set_file_cache_policy() and add_file_cache_options() methods declared
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -171,6 +185,7 @@ typedef struct OptionsContext {
     int64_t start_time_eof;
     int seek_timestamp;
     const char *format;
+    const char *digest;
 
     SpecifierOpt *codec_names;
     int nb_codec_names;
@@ -192,11 +207,16 @@ typedef struct OptionsContext {
     /* input options */
     int64_t input_ts_offset;
     int loop;
+    int64_t loop_cache_size;
     int rate_emu;
     float readrate;
     double readrate_initial_burst;
     int accurate_seek;
+    int seek_index;
     int thread_queue_size;
+    int thread_queue_size_max;
+    int concat_prefetch;
+    int64_t concat_prefetch_size;
     int input_sync_ref;
     int find_stream_info;
 
@@ -641,6 +661,8 @@ typedef struct OutputStream {
         finished;    /* no more packets should be written for this stream */
     int unavailable; /* true if the steram is unavailable (possibly temporarily)
                       */
+    /* position of the stream in the output scheduling heap */
+    int sched_idx;
 
     // init_output_stream() has been called for this stream
     // The encoder and the bitstream filters have been initialized and the
@@ -923,6 +945,20 @@ void ifile_close(InputFile **f);
  * - a negative error code on failure
  */
 int ifile_get_packet(InputFile *f, AVPacket **pkt);
+/**
+ * Return a packet obtained from ifile_get_packet() to the demuxer for reuse.
+ */
+void ifile_packet_release(InputFile *f, AVPacket **pkt);
+
+/**
+ * Reposition the stream in the output scheduling order after its
+ * last_mux_dts or filter last_pts changed.
+ */
+void ost_sched_update(OutputStream *ost);
+/**
+ * Mark the stream as unavailable until more input has been read.
+ */
+void ost_set_unavailable(OutputStream *ost);
 
 int ist_output_add(InputStream *ist, OutputStream *ost);
 int ist_filter_add(InputStream *ist, InputFilter *ifilter, int is_simple);
@@ -984,6 +1020,22 @@ typedef struct EncStatsFile {
 
 void set_report_callback(void (*callback)(int, float, float, int64_t, double,
                                           double, double));
+void set_input_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                               uint64_t, double, double, int,
+                                               int, int, uint64_t, uint64_t,
+                                               uint64_t, const char *,
+                                               const char *));
+void set_output_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                                uint64_t, uint64_t,
+                                                const char *, const char *));
+void set_file_cache_policy(int fadvise, int direct);
 void cancel_operation(long id);
 
+/**
+ * Adds the file_fadvise and file_direct options selected with
+ * set_file_cache_policy() to opts, if filename is opened with file:.
+ */
+int add_file_cache_options(AVDictionary **opts, const char *filename,
+                           int output);
+
 #endif /* FFTOOLS_FFMPEG_H */
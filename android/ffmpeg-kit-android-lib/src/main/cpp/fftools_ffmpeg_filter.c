@@ -28,6 +28,11 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - output scheduling heap updated when filter last_pts changes,
+ * ost_set_unavailable() used
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -2222,6 +2227,7 @@ static int fg_output_step(OutputFilterPriv *ofp, int flush) {
     if (frame->pts != AV_NOPTS_VALUE) {
         ost->filter->last_pts =
             av_rescale_q(frame->pts, frame->time_base, AV_TIME_BASE_Q);
+        ost_sched_update(ost);
 
         if (debug_ts)
             av_log(fgp, AV_LOG_INFO,
@@ -2590,7 +2596,7 @@ int fg_transcode_step(FilterGraph *graph, InputStream **best_ist) {
 
     if (!*best_ist)
         for (i = 0; i < graph->nb_outputs; i++)
-            graph->outputs[i]->ost->unavailable = 1;
+            ost_set_unavailable(graph->outputs[i]->ost);
 
     return 0;
 }
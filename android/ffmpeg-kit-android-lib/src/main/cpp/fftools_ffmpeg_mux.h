@@ -27,6 +27,12 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - bytes_written field added to Muxer
+ * - digest field added to Muxer
+ * - pos_max field added to Muxer
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -48,6 +54,7 @@
 #include <stdatomic.h>
 #include <stdint.h>
 
+#include "fftools_digest_io.h"
 #include "fftools_thread_queue.h"
 
 #include "libavformat/avformat.h"
@@ -182,6 +189,12 @@ typedef struct Muxer {
     /* filesize limit expressed in bytes */
     int64_t limit_filesize;
     atomic_int_least64_t last_filesize;
+    /* highest position reached in the output AVIOContext */
+    int64_t pos_max;
+    /* bytes written through the output AVIOContext, set by of_write_trailer */
+    int64_t bytes_written;
+    /* hashes the output while it is written, see the digest option */
+    DigestIO *digest;
     int header_written;
 
     SyncQueue *sq_mux;
@@ -33,6 +33,18 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - set_ffprobe_record_callback() added, delivers packets and frames as
+ * FFprobeRecord batches instead of printing them
+ * - write_seek_index option added, writes a keyframe index sidecar file of
+ * the input
+ * - binary writer added
+ * - json_escape_str scans for characters to escape 16 bytes at a time and
+ * copies the rest in bulk
+ * - count_threads option added, counts frames and packets of time ranges in
+ * parallel
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -86,6 +98,7 @@
 #include "libavutil/hash.h"
 #include "libavutil/hdr_dynamic_metadata.h"
 #include "libavutil/hdr_dynamic_vivid_metadata.h"
+#include "libavutil/intmath.h"
 #include "libavutil/intreadwrite.h"
 #include "libavutil/libm.h"
 #include "libavutil/mastering_display_metadata.h"
@@ -100,8 +113,16 @@
 #include "libswscale/swscale.h"
 
 #include "ffmpegkit_exception.h"
+#include "fftools_ffprobe_record.h"
+#include "fftools_seek_index.h"
 #include "libavutil/thread.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #if !HAVE_THREADS
 #ifdef pthread_mutex_lock
 #undef pthread_mutex_lock
@@ -156,6 +177,15 @@ __thread int do_show_pixel_formats = 0;
 __thread int do_show_pixel_format_flags = 0;
 __thread int do_show_pixel_format_components = 0;
 __thread int do_show_log = 0;
+__thread int do_write_seek_index = 0;
+__thread int count_threads = 0;
+
+__thread FFprobeRecordCallback ffprobe_record_callback = NULL;
+__thread void *ffprobe_record_opaque = NULL;
+__thread FFprobeRecord *ffprobe_records = NULL;
+__thread int nb_ffprobe_records = 0;
+
+__thread SeekIndex *seek_index = NULL;
 
 __thread int do_show_chapter_tags = 0;
 __thread int do_show_format_tags = 0;
@@ -2126,23 +2156,81 @@ static av_cold int json_init(WriterContext *wctx) {
     return 0;
 }
 
+static inline int json_needs_escape(unsigned char c) {
+    return c < 32 || c == '"' || c == '\\';
+}
+
+/**
+ * Return the first character in [p, end) that needs escaping or end. Most
+ * names and values need no escaping at all, so 16 characters are checked at
+ * a time where SIMD is available.
+ */
+static const char *json_find_escape(const char *p, const char *end) {
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(31);
+
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                 _mm_cmpeq_epi8(v, backslash));
+        int mask;
+
+        /* unsigned v <= 31 */
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+        mask = _mm_movemask_epi8(m);
+        if (mask)
+            return p + ff_ctz(mask);
+        p += 16;
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(32);
+
+    /* the exact position is found by the scalar loop below */
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)p);
+        uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote),
+                                         vceqq_u8(v, backslash)),
+                                vcltq_u8(v, space));
+        uint64x2_t m64 = vreinterpretq_u64_u8(m);
+        if (vgetq_lane_u64(m64, 0) | vgetq_lane_u64(m64, 1))
+            break;
+        p += 16;
+    }
+#endif
+    for (; p < end; p++)
+        if (json_needs_escape(*p))
+            break;
+    return p;
+}
+
 static const char *json_escape_str(AVBPrint *dst, const char *src,
                                    void *log_ctx) {
     static const char json_escape[] = {'"',  '\\', '\b', '\f',
                                        '\n', '\r', '\t', 0};
     static const char json_subst[] = {'"', '\\', 'b', 'f', 'n', 'r', 't', 0};
-    const char *p;
+    const char *p = src, *end = src + strlen(src);
 
-    for (p = src; *p; p++) {
-        char *s = strchr(json_escape, *p);
+    while (p < end) {
+        const char *q = json_find_escape(p, end);
+        char *s;
+
+        /* copy the characters that need no escaping at once */
+        av_bprint_append_data(dst, p, q - p);
+        if (q == end)
+            break;
+
+        s = strchr(json_escape, *q);
         if (s) {
             av_bprint_chars(dst, '\\', 1);
             av_bprint_chars(dst, json_subst[s - json_escape], 1);
-        } else if ((unsigned char)*p < 32) {
-            av_bprintf(dst, "\\u00%02x", *p & 0xff);
         } else {
-            av_bprint_chars(dst, *p, 1);
+            av_bprintf(dst, "\\u00%02x", *q & 0xff);
         }
+        p = q + 1;
     }
     return dst->str;
 }
@@ -2267,6 +2355,119 @@ static const Writer json_writer = {
     .priv_class = &json_class,
 };
 
+/* Binary output */
+
+/*
+ * A flat stream of records that mirrors the structure of the json output
+ * without any escaping or number formatting:
+ *
+ *   file    := "FFPB" version:u8 record*
+ *   record  := 0x01 flags:u8 string          section start
+ *            | 0x02                          section end
+ *            | 0x03 key:string value:string  string item
+ *            | 0x04 key:string value:varint  integer item, zigzag encoded
+ *   string  := length:varint bytes 0x00
+ *   varint  := unsigned LEB128
+ *
+ * Section flags are BINARY_SECTION_ARRAY for arrays and BINARY_SECTION_WRAPPER
+ * for the root section. Elements of arrays are unnamed in json, their name is
+ * still written. Strings are NUL terminated so that readers can use them in
+ * place. Since the output may contain NUL bytes it can't be printed through
+ * the log and an output file must be set, e.g. a memory url.
+ */
+
+#define BINARY_VERSION 1
+
+#define BINARY_RECORD_SECTION_START 0x01
+#define BINARY_RECORD_SECTION_END 0x02
+#define BINARY_RECORD_STRING 0x03
+#define BINARY_RECORD_INTEGER 0x04
+
+#define BINARY_SECTION_ARRAY 1
+#define BINARY_SECTION_WRAPPER 2
+
+static av_cold int binary_init(WriterContext *wctx) {
+    if (!wctx->avio) {
+        av_log(wctx, AV_LOG_ERROR,
+               "The binary output format requires an output file, set one "
+               "with -o\n");
+        return AVERROR(EINVAL);
+    }
+
+    writer_put_str(wctx, "FFPB");
+    writer_w8(wctx, BINARY_VERSION);
+
+    return 0;
+}
+
+static void binary_put_varint(WriterContext *wctx, uint64_t value) {
+    while (value >= 0x80) {
+        writer_w8(wctx, (value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    writer_w8(wctx, value);
+}
+
+static void binary_put_string(WriterContext *wctx, const char *str) {
+    binary_put_varint(wctx, strlen(str));
+    writer_put_str(wctx, str);
+    writer_w8(wctx, 0);
+}
+
+static void binary_print_section_header(WriterContext *wctx, void *data) {
+    const struct section *section = wctx->section[wctx->level];
+    const struct section *parent_section =
+        wctx->level ? wctx->section[wctx->level - 1] : NULL;
+    int flags = 0;
+
+    if (section->flags & SECTION_FLAG_IS_ARRAY)
+        flags |= BINARY_SECTION_ARRAY;
+    if (section->flags & SECTION_FLAG_IS_WRAPPER)
+        flags |= BINARY_SECTION_WRAPPER;
+
+    writer_w8(wctx, BINARY_RECORD_SECTION_START);
+    writer_w8(wctx, flags);
+    binary_put_string(wctx, section->name);
+
+    /* this is required so the parser can distinguish between packets and
+     * frames, same as json */
+    if (parent_section &&
+        parent_section->id == SECTION_ID_PACKETS_AND_FRAMES) {
+        writer_w8(wctx, BINARY_RECORD_STRING);
+        binary_put_string(wctx, "type");
+        binary_put_string(wctx, section->name);
+        wctx->nb_item[wctx->level]++;
+    }
+}
+
+static void binary_print_section_footer(WriterContext *wctx) {
+    writer_w8(wctx, BINARY_RECORD_SECTION_END);
+}
+
+static void binary_print_str(WriterContext *wctx, const char *key,
+                             const char *value) {
+    writer_w8(wctx, BINARY_RECORD_STRING);
+    binary_put_string(wctx, key);
+    binary_put_string(wctx, value);
+}
+
+static void binary_print_int(WriterContext *wctx, const char *key,
+                             long long int value) {
+    writer_w8(wctx, BINARY_RECORD_INTEGER);
+    binary_put_string(wctx, key);
+    binary_put_varint(wctx, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static const Writer binary_writer = {
+    .name = "binary",
+    .init = binary_init,
+    .print_section_header = binary_print_section_header,
+    .print_section_footer = binary_print_section_footer,
+    .print_integer = binary_print_int,
+    .print_string = binary_print_str,
+    .flags = WRITER_FLAG_PUT_PACKETS_AND_FRAMES_IN_SAME_CHAPTER,
+};
+
 /* XML output */
 
 typedef struct XMLContext {
@@ -2480,6 +2681,7 @@ static void writer_register_all(void) {
     writer_register(&flat_writer);
     writer_register(&ini_writer);
     writer_register(&json_writer);
+    writer_register(&binary_writer);
     writer_register(&xml_writer);
 }
 
@@ -3121,6 +3323,76 @@ static int show_log(WriterContext *w, int section_ids, int section_id,
     return 0;
 }
 
+void set_ffprobe_record_callback(FFprobeRecordCallback callback,
+                                 void *opaque) {
+    ffprobe_record_callback = callback;
+    ffprobe_record_opaque = opaque;
+}
+
+static void flush_records(void) {
+    if (nb_ffprobe_records > 0) {
+        ffprobe_record_callback(ffprobe_record_opaque, ffprobe_records,
+                                nb_ffprobe_records);
+        nb_ffprobe_records = 0;
+    }
+}
+
+static FFprobeRecord *add_record(const AVStream *st, int type) {
+    FFprobeRecord *record;
+
+    if (nb_ffprobe_records == FFPROBE_RECORD_BATCH_SIZE)
+        flush_records();
+
+    record = &ffprobe_records[nb_ffprobe_records++];
+    record->type = type;
+    record->stream_index = st->index;
+    record->time_base_num = st->time_base.num;
+    record->time_base_den = st->time_base.den;
+    record->pict_type = AV_PICTURE_TYPE_NONE;
+    return record;
+}
+
+static void record_packet(const AVPacket *pkt, const AVStream *st) {
+    FFprobeRecord *record = add_record(st, FFPROBE_RECORD_PACKET);
+
+    record->pts = pkt->pts;
+    record->dts = pkt->dts;
+    record->duration = pkt->duration;
+    record->pos = pkt->pos;
+    record->size = pkt->size;
+    record->flags = pkt->flags;
+}
+
+static void record_frame(const AVFrame *frame, const AVStream *st) {
+    FrameData *fd =
+        frame->opaque_ref ? (FrameData *)frame->opaque_ref->data : NULL;
+    FFprobeRecord *record = add_record(st, FFPROBE_RECORD_FRAME);
+
+    record->pts = frame->pts;
+    record->dts = frame->pkt_dts;
+    record->duration = frame->duration;
+    record->pos = fd ? fd->pkt_pos : -1;
+    record->size = fd ? fd->pkt_size : -1;
+    record->flags = frame->flags;
+    if (st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+        record->pict_type = frame->pict_type;
+}
+
+static void record_subtitle(const AVSubtitle *sub, const AVStream *st) {
+    FFprobeRecord *record = add_record(st, FFPROBE_RECORD_FRAME);
+
+    record->pts = sub->pts == AV_NOPTS_VALUE
+                      ? AV_NOPTS_VALUE
+                      : av_rescale_q(sub->pts, AV_TIME_BASE_Q, st->time_base);
+    record->dts = AV_NOPTS_VALUE;
+    record->duration =
+        av_rescale_q(sub->end_display_time - sub->start_display_time,
+                     (AVRational){1, 1000}, st->time_base);
+    record->pos = -1;
+    record->size = -1;
+    record->flags = 0;
+}
+
 static void show_packet(WriterContext *w, InputFile *ifile, AVPacket *pkt,
                         int packet_idx) {
     char val_str[128];
@@ -3456,7 +3728,13 @@ static av_always_inline int process_frame(WriterContext *w, InputFile *ifile,
     if (got_frame) {
         int is_sub = (par->codec_type == AVMEDIA_TYPE_SUBTITLE);
         nb_streams_frames[pkt->stream_index]++;
-        if (do_show_frames) {
+        if (do_show_frames && ffprobe_records) {
+            if (is_sub) {
+                record_subtitle(&sub, ifile->streams[pkt->stream_index].st);
+            } else {
+                record_frame(frame, ifile->streams[pkt->stream_index].st);
+            }
+        } else if (do_show_frames) {
             if (is_sub) {
                 show_subtitle(w, &sub, ifile->streams[pkt->stream_index].st,
                               fmt_ctx);
@@ -3584,8 +3862,16 @@ static int read_interval_packets(WriterContext *w, InputFile *ifile,
             }
 
             frame_count++;
+            if (seek_index) {
+                ret = seek_index_add(
+                    seek_index, ifile->streams[pkt->stream_index].st, pkt);
+                if (ret < 0)
+                    goto end;
+            }
             if (do_read_packets) {
-                if (do_show_packets)
+                if (do_show_packets && ffprobe_records)
+                    record_packet(pkt, ifile->streams[pkt->stream_index].st);
+                else if (do_show_packets)
                     show_packet(w, ifile, pkt, i++);
                 nb_streams_packets[pkt->stream_index]++;
             }
@@ -3635,6 +3921,14 @@ static int read_packets(WriterContext *w, InputFile *ifile) {
     int i, ret = 0;
     int64_t cur_ts = fmt_ctx->start_time;
 
+    if (ffprobe_record_callback && (do_show_packets || do_show_frames)) {
+        ffprobe_records = av_malloc_array(FFPROBE_RECORD_BATCH_SIZE,
+                                          sizeof(*ffprobe_records));
+        if (!ffprobe_records)
+            return AVERROR(ENOMEM);
+        nb_ffprobe_records = 0;
+    }
+
     if (read_intervals_nb == 0) {
         ReadInterval interval = (ReadInterval){.has_start = 0, .has_end = 0};
         ret = read_interval_packets(w, ifile, &interval, &cur_ts);
@@ -3646,6 +3940,11 @@ static int read_packets(WriterContext *w, InputFile *ifile) {
         }
     }
 
+    if (ffprobe_records) {
+        flush_records();
+        av_freep(&ffprobe_records);
+    }
+
     return ret;
 }
 
@@ -4034,7 +4333,7 @@ static void show_error(WriterContext *w, int err) {
 }
 
 static int open_input_file(InputFile *ifile, const char *filename,
-                           const char *print_filename) {
+                           const char *print_filename, int dump_format) {
     int err, i;
     AVFormatContext *fmt_ctx = NULL;
     const AVDictionaryEntry *t = NULL;
@@ -4084,7 +4383,8 @@ static int open_input_file(InputFile *ifile, const char *filename,
         }
     }
 
-    av_dump_format(fmt_ctx, 0, filename, 0);
+    if (dump_format)
+        av_dump_format(fmt_ctx, 0, filename, 0);
 
     ifile->streams = av_calloc(fmt_ctx->nb_streams, sizeof(*ifile->streams));
     if (!ifile->streams)
@@ -4174,16 +4474,532 @@ static void close_input_file(InputFile *ifile) {
     avformat_close_input(&ifile->fmt_ctx);
 }
 
+/* Parallel counting */
+
+/*
+ * With -count_threads, -count_frames and -count_packets split the input into
+ * time ranges starting at keyframes of the default stream and count each
+ * range on its own thread, with its own demuxer and decoders.
+ *
+ * A packet belongs to the range its dts falls in, a frame to the range of the
+ * packet it was decoded from. A range seeks to a keyframe at least a second
+ * before its start, decodes the packets before its start only to prime the
+ * decoders, and reads past its end until every stream has a packet after it.
+ * At each boundary the first packets read by a range are matched against the
+ * packets the previous range read past its end; this proves that no packet
+ * was missed as long as the dts of each stream increase and the demuxer
+ * returns every packet of a stream following the first one it returns after
+ * a seek. If that can't be proven counting is done again on a single thread.
+ */
+
+#if HAVE_THREADS
+
+typedef struct CountStream {
+    /* the first packet with a dts and the number of packets with that dts */
+    int has_first;
+    int64_t first_ts;
+    int nb_first;
+
+    /* the first packet at or after the end of the range and the number of
+     * packets with that dts */
+    int has_next;
+    int64_t next_ts;
+    int nb_next;
+
+    int has_last;
+    int64_t last_ts;
+
+    /* a packet after next_ts was read, the stream needs no more packets */
+    int done;
+
+    /* a keyframe was sent to the decoder before the range */
+    int primed;
+
+    uint64_t nb_packets;
+    uint64_t nb_frames;
+} CountStream;
+
+typedef struct CountRange {
+    InputFile ifile;
+
+    /* shared with the main thread, read only */
+    const int *selected;
+    int count_packets;
+    int count_frames;
+    int ref_stream;
+
+    /* in the time base of the reference stream, INT64_MIN for the first and
+     * INT64_MAX for the last range */
+    int64_t start;
+    int64_t end;
+
+    CountStream *streams;
+    int nb_streams;
+
+    pthread_t thread;
+    int thread_started;
+    int ret;
+} CountRange;
+
+static int count_range_cmp(const CountRange *r, const AVStream *st,
+                           int64_t ts, int64_t bound) {
+    return av_compare_ts(
+        ts, st->time_base, bound,
+        r->ifile.fmt_ctx->streams[r->ref_stream]->time_base);
+}
+
+/* same as process_frame(), except that frames are only counted */
+static int count_range_frame(CountRange *r, InputStream *ist, AVFrame *frame,
+                             AVPacket *pkt, int *packet_new) {
+    AVCodecContext *dec_ctx = ist->dec_ctx;
+    CountStream *cs = &r->streams[ist->st->index];
+    AVSubtitle sub;
+    int ret = 0, got_frame = 0, in_range;
+
+    switch (ist->st->codecpar->codec_type) {
+    case AVMEDIA_TYPE_VIDEO:
+    case AVMEDIA_TYPE_AUDIO:
+        if (*packet_new) {
+            ret = avcodec_send_packet(dec_ctx, pkt);
+            if (ret == AVERROR(EAGAIN)) {
+                ret = 0;
+            } else if (ret >= 0 || ret == AVERROR_EOF) {
+                ret = 0;
+                *packet_new = 0;
+            }
+        }
+        if (ret >= 0) {
+            ret = avcodec_receive_frame(dec_ctx, frame);
+            if (ret >= 0) {
+                got_frame = 1;
+            } else if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+                ret = 0;
+            }
+        }
+        break;
+    case AVMEDIA_TYPE_SUBTITLE:
+        if (*packet_new)
+            ret = avcodec_decode_subtitle2(dec_ctx, &sub, &got_frame, pkt);
+        *packet_new = 0;
+        break;
+    default:
+        *packet_new = 0;
+    }
+
+    if (ret < 0)
+        return ret;
+    if (got_frame) {
+        AVBufferRef *opaque_ref =
+            ist->st->codecpar->codec_type == AVMEDIA_TYPE_SUBTITLE
+                ? pkt->opaque_ref
+                : frame->opaque_ref;
+
+        /* frames that can't be traced to a packet are output while draining
+         * at the end of the input */
+        in_range = opaque_ref ? *(int *)opaque_ref->data : r->end == INT64_MAX;
+        if (in_range)
+            cs->nb_frames++;
+        if (ist->st->codecpar->codec_type == AVMEDIA_TYPE_SUBTITLE)
+            avsubtitle_free(&sub);
+        else
+            av_frame_unref(frame);
+    }
+    return got_frame || *packet_new;
+}
+
+static int count_range_decode(CountRange *r, AVPacket *pkt, AVFrame *frame,
+                              int in_range) {
+    InputStream *ist = &r->ifile.streams[pkt->stream_index];
+    int packet_new = 1;
+
+    if (!r->count_frames || !ist->dec_ctx)
+        return 0;
+
+    pkt->opaque_ref = av_buffer_allocz(sizeof(int));
+    if (!pkt->opaque_ref)
+        return AVERROR(ENOMEM);
+    *(int *)pkt->opaque_ref->data = in_range;
+
+    while (count_range_frame(r, ist, frame, pkt, &packet_new) > 0)
+        ;
+    return 0;
+}
+
+static int count_range_packet(CountRange *r, AVPacket *pkt, AVFrame *frame,
+                              int *nb_pending) {
+    AVStream *st;
+    CountStream *cs;
+    InputStream *ist;
+    int64_t ts;
+    int before_start, after_end;
+
+    if (pkt->stream_index >= r->nb_streams)
+        return AVERROR(ENOTSUP);
+    if (!r->selected[pkt->stream_index])
+        return 0;
+    st = r->ifile.fmt_ctx->streams[pkt->stream_index];
+    ist = &r->ifile.streams[pkt->stream_index];
+    cs = &r->streams[pkt->stream_index];
+
+    /* attached pictures are returned again after each seek */
+    if (st->disposition & AV_DISPOSITION_ATTACHED_PIC) {
+        if (r->start != INT64_MIN)
+            return 0;
+        if (r->count_packets)
+            cs->nb_packets++;
+        return count_range_decode(r, pkt, frame, 1);
+    }
+    if (cs->done)
+        return 0;
+
+    if (pkt->dts != AV_NOPTS_VALUE) {
+        ts = pkt->dts;
+        if (cs->has_last && ts < cs->last_ts)
+            return AVERROR(ENOTSUP);
+        cs->has_last = 1;
+        cs->last_ts = ts;
+        if (!cs->has_first) {
+            cs->has_first = 1;
+            cs->first_ts = ts;
+        }
+        if (ts == cs->first_ts)
+            cs->nb_first++;
+    } else if (pkt->pts != AV_NOPTS_VALUE && !cs->has_last) {
+        /* the dts of the first packets after opening or seeking may not be
+         * known yet */
+        ts = pkt->pts;
+    } else {
+        return AVERROR(ENOTSUP);
+    }
+
+    before_start =
+        r->start != INT64_MIN && count_range_cmp(r, st, ts, r->start) < 0;
+    after_end = r->end != INT64_MAX && count_range_cmp(r, st, ts, r->end) >= 0;
+
+    if (pkt->dts == AV_NOPTS_VALUE && r->start != INT64_MIN && !before_start)
+        return AVERROR(ENOTSUP);
+
+    if (after_end) {
+        if (pkt->dts == AV_NOPTS_VALUE)
+            return AVERROR(ENOTSUP);
+        if (!cs->has_next) {
+            cs->has_next = 1;
+            cs->next_ts = ts;
+        }
+        if (ts == cs->next_ts) {
+            cs->nb_next++;
+        } else {
+            cs->done = 1;
+            (*nb_pending)--;
+        }
+        return 0;
+    }
+
+    if (before_start) {
+        if (pkt->flags & AV_PKT_FLAG_KEY)
+            cs->primed = 1;
+        return count_range_decode(r, pkt, frame, 0);
+    }
+
+    /* decoding must start before the range: leading pictures of the first
+     * video keyframe are dropped, and audio decoders like vorbis output no
+     * frame for the first packet they receive */
+    if (r->count_frames && ist->dec_ctx && !cs->primed &&
+        (st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO ||
+         st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO))
+        return AVERROR(ENOTSUP);
+
+    if (r->count_packets)
+        cs->nb_packets++;
+    return count_range_decode(r, pkt, frame, 1);
+}
+
+static int count_range_read(CountRange *r) {
+    AVFormatContext *fmt_ctx = r->ifile.fmt_ctx;
+    AVPacket *pkt = NULL;
+    AVFrame *frame = NULL;
+    int ret = 0, i, nb_pending = 0;
+
+    if (r->start != INT64_MIN) {
+        AVRational tb = fmt_ctx->streams[r->ref_stream]->time_base;
+        int64_t ts = r->start - av_rescale_q(AV_TIME_BASE, AV_TIME_BASE_Q, tb);
+
+        ret = avformat_seek_file(fmt_ctx, r->ref_stream, INT64_MIN, ts, ts, 0);
+        if (ret < 0)
+            return ret;
+    }
+
+    for (i = 0; i < r->nb_streams; i++)
+        if (r->selected[i] &&
+            !(fmt_ctx->streams[i]->disposition & AV_DISPOSITION_ATTACHED_PIC))
+            nb_pending++;
+
+    frame = av_frame_alloc();
+    pkt = av_packet_alloc();
+    if (!frame || !pkt) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    /* the last range reads until the end of the input */
+    while (nb_pending > 0 && (ret = av_read_frame(fmt_ctx, pkt)) >= 0) {
+        ret = count_range_packet(r, pkt, frame, &nb_pending);
+        av_packet_unref(pkt);
+        if (ret < 0)
+            goto end;
+    }
+    if (ret == AVERROR_EOF)
+        ret = 0;
+    if (ret < 0)
+        goto end;
+
+    if (r->count_frames) {
+        for (i = 0; i < r->nb_streams; i++) {
+            if (!r->selected[i] || !r->ifile.streams[i].dec_ctx)
+                continue;
+            pkt->stream_index = i;
+            while (count_range_frame(r, &r->ifile.streams[i], frame, pkt,
+                                     &(int){1}) > 0)
+                ;
+        }
+    }
+
+end:
+    av_frame_free(&frame);
+    av_packet_free(&pkt);
+    return ret;
+}
+
+static void *count_range_thread(void *arg) {
+    CountRange *r = arg;
+
+    r->ret = count_range_read(r);
+    return NULL;
+}
+
+/**
+ * Find the range boundaries, the timestamps of keyframes in the index of st
+ * that split it into nb_ranges parts of about the same duration.
+ *
+ * @return number of boundaries found
+ */
+static int count_find_boundaries(AVStream *st, int nb_ranges, int64_t *bounds) {
+    int nb_entries = avformat_index_get_entries_count(st);
+    const AVIndexEntry *e;
+    int64_t first = AV_NOPTS_VALUE, last = AV_NOPTS_VALUE;
+    int i, j = 0, k, n = 0;
+
+    for (i = 0; i < nb_entries; i++) {
+        e = avformat_index_get_entry(st, i);
+        if (!(e->flags & AVINDEX_KEYFRAME))
+            continue;
+        if (first == AV_NOPTS_VALUE)
+            first = e->timestamp;
+        last = e->timestamp;
+    }
+    if (first == AV_NOPTS_VALUE || last <= first)
+        return 0;
+
+    for (k = 1; k < nb_ranges; k++) {
+        int64_t target = first + av_rescale(last - first, k, nb_ranges);
+        int64_t bound = AV_NOPTS_VALUE;
+
+        for (; j < nb_entries; j++) {
+            e = avformat_index_get_entry(st, j);
+            if (e->timestamp > target)
+                break;
+            if (e->flags & AVINDEX_KEYFRAME)
+                bound = e->timestamp;
+        }
+        if (bound != AV_NOPTS_VALUE && bound > first &&
+            (!n || bound > bounds[n - 1]))
+            bounds[n++] = bound;
+    }
+    return n;
+}
+
+/**
+ * Check that range r counted every packet of stream i after its start,
+ * using what the previous range read past its end.
+ */
+static int count_check_boundary(const CountRange *prev, const CountRange *r,
+                                int i) {
+    const CountStream *prev_cs = &prev->streams[i];
+    const CountStream *cs = &r->streams[i];
+
+    /* the previous range read until the end without finding a packet */
+    if (!prev_cs->has_next)
+        return !cs->nb_packets && !cs->nb_frames;
+    if (!cs->has_first)
+        return 0;
+    if (cs->first_ts < prev_cs->next_ts)
+        return 1;
+    return cs->first_ts == prev_cs->next_ts &&
+           cs->nb_first == prev_cs->nb_next;
+}
+
+/**
+ * Count the frames and packets of ifile on count_threads threads.
+ *
+ * @return 1 if the counts were set, 0 if they must be counted on a single
+ * thread
+ */
+static int count_parallel(InputFile *ifile, const char *filename,
+                          AVDictionary *input_format_opts) {
+    AVFormatContext *fmt_ctx = ifile->fmt_ctx;
+    CountRange *ranges = NULL;
+    int64_t *bounds = NULL;
+    int ret = 0, nb_ranges = 0, ref_stream, i, k;
+
+    if (count_threads < 2 || !(do_count_frames || do_count_packets) ||
+        do_show_frames || do_show_packets || do_write_seek_index ||
+        read_intervals_nb)
+        return 0;
+
+    if (!fmt_ctx->pb || !(fmt_ctx->pb->seekable & AVIO_SEEKABLE_NORMAL)) {
+        av_log(NULL, AV_LOG_VERBOSE,
+               "Input is not seekable, counting on a single thread\n");
+        return 0;
+    }
+
+    ref_stream = av_find_default_stream_index(fmt_ctx);
+    bounds = av_malloc_array(count_threads, sizeof(*bounds));
+    if (ref_stream < 0 || !bounds)
+        goto end;
+    nb_ranges = count_find_boundaries(fmt_ctx->streams[ref_stream],
+                                      count_threads, bounds) + 1;
+    if (nb_ranges < 2) {
+        av_log(NULL, AV_LOG_VERBOSE,
+               "Input has no keyframe index, counting on a single thread\n");
+        goto end;
+    }
+
+    ranges = av_calloc(nb_ranges, sizeof(*ranges));
+    if (!ranges)
+        goto end;
+
+    /* inputs are opened here since the options are only visible to this
+     * thread */
+    for (k = 0; k < nb_ranges; k++) {
+        CountRange *r = &ranges[k];
+        AVDictionary *saved_format_opts = format_opts;
+
+        format_opts = NULL;
+        ret = av_dict_copy(&format_opts, input_format_opts, 0);
+        if (ret >= 0)
+            ret = open_input_file(&r->ifile, filename, NULL, 0);
+        av_dict_free(&format_opts);
+        format_opts = saved_format_opts;
+        if (ret < 0 || r->ifile.nb_streams != ifile->nb_streams)
+            goto end;
+
+        r->nb_streams = ifile->nb_streams;
+        r->streams = av_calloc(r->nb_streams, sizeof(*r->streams));
+        if (!r->streams)
+            goto end;
+        for (i = 0; i < r->nb_streams; i++) {
+            if (!selected_streams[i])
+                r->ifile.fmt_ctx->streams[i]->discard = AVDISCARD_ALL;
+            r->streams[i].primed = k == 0;
+        }
+
+        r->selected = selected_streams;
+        r->count_packets = do_count_packets;
+        r->count_frames = do_count_frames;
+        r->ref_stream = ref_stream;
+        r->start = k ? bounds[k - 1] : INT64_MIN;
+        r->end = k < nb_ranges - 1 ? bounds[k] : INT64_MAX;
+    }
+
+    av_log(NULL, AV_LOG_VERBOSE, "Counting %d ranges in parallel\n",
+           nb_ranges);
+
+    for (k = 1; k < nb_ranges; k++)
+        ranges[k].thread_started = !pthread_create(
+            &ranges[k].thread, NULL, count_range_thread, &ranges[k]);
+    ranges[0].ret = count_range_read(&ranges[0]);
+    for (k = 1; k < nb_ranges; k++) {
+        if (ranges[k].thread_started)
+            pthread_join(ranges[k].thread, NULL);
+        else
+            ranges[k].ret = count_range_read(&ranges[k]);
+    }
+
+    ret = 1;
+    for (k = 0; k < nb_ranges && ret; k++) {
+        if (ranges[k].ret < 0) {
+            av_log(NULL, AV_LOG_VERBOSE,
+                   "Could not count range %d: %s\n", k,
+                   av_err2str(ranges[k].ret));
+            ret = 0;
+        }
+        for (i = 0; k && ret && i < ifile->nb_streams; i++)
+            if (selected_streams[i] &&
+                !(fmt_ctx->streams[i]->disposition &
+                  AV_DISPOSITION_ATTACHED_PIC) &&
+                !count_check_boundary(&ranges[k - 1], &ranges[k], i)) {
+                av_log(NULL, AV_LOG_VERBOSE,
+                       "Stream %d could not be split at range %d\n", i, k);
+                ret = 0;
+            }
+    }
+    if (!ret) {
+        av_log(NULL, AV_LOG_VERBOSE, "Counting on a single thread\n");
+        goto end;
+    }
+
+    for (k = 0; k < nb_ranges; k++) {
+        for (i = 0; i < ifile->nb_streams; i++) {
+            AVCodecContext *dec_ctx = ifile->streams[i].dec_ctx;
+
+            nb_streams_packets[i] += ranges[k].streams[i].nb_packets;
+            nb_streams_frames[i] += ranges[k].streams[i].nb_frames;
+
+            /* properties discovered while decoding, e.g. closed captions */
+            if (dec_ctx && ranges[k].ifile.streams[i].dec_ctx)
+                dec_ctx->properties |=
+                    ranges[k].ifile.streams[i].dec_ctx->properties;
+        }
+    }
+
+end:
+    for (k = 0; ranges && k < nb_ranges; k++) {
+        if (ranges[k].ifile.fmt_ctx)
+            close_input_file(&ranges[k].ifile);
+        av_freep(&ranges[k].streams);
+    }
+    av_freep(&ranges);
+    av_freep(&bounds);
+    return ret > 0;
+}
+
+#else
+
+static int count_parallel(InputFile *ifile, const char *filename,
+                          AVDictionary *input_format_opts) {
+    return 0;
+}
+
+#endif
+
 static int probe_file(WriterContext *wctx, const char *filename,
                       const char *print_filename) {
     InputFile ifile = {0};
+    AVDictionary *input_format_opts = NULL;
     int ret, i;
     int section_id;
 
     do_read_frames = do_show_frames || do_count_frames;
-    do_read_packets = do_show_packets || do_count_packets;
+    do_read_packets =
+        do_show_packets || do_count_packets || do_write_seek_index;
 
-    ret = open_input_file(&ifile, filename, print_filename);
+    if (count_threads > 1) {
+        ret = av_dict_copy(&input_format_opts, format_opts, 0);
+        if (ret < 0)
+            goto end;
+    }
+
+    ret = open_input_file(&ifile, filename, print_filename, 1);
     if (ret < 0)
         goto end;
 
@@ -4211,6 +5027,9 @@ static int probe_file(WriterContext *wctx, const char *filename,
     }
 
     if (do_read_frames || do_read_packets) {
+        int print_section =
+            (do_show_frames || do_show_packets) && !ffprobe_record_callback;
+
         if (do_show_frames && do_show_packets &&
             wctx->writer->flags &
                 WRITER_FLAG_PUT_PACKETS_AND_FRAMES_IN_SAME_CHAPTER)
@@ -4219,11 +5038,29 @@ static int probe_file(WriterContext *wctx, const char *filename,
             section_id = SECTION_ID_PACKETS;
         else // (!do_show_packets && do_show_frames)
             section_id = SECTION_ID_FRAMES;
-        if (do_show_frames || do_show_packets)
+        if (do_write_seek_index) {
+            seek_index = seek_index_alloc();
+            if (!seek_index) {
+                ret = AVERROR(ENOMEM);
+                goto end;
+            }
+        }
+        if (print_section)
             writer_print_section_header(wctx, NULL, section_id);
-        ret = read_packets(wctx, &ifile);
-        if (do_show_frames || do_show_packets)
+        if (count_parallel(&ifile, filename, input_format_opts))
+            ret = 0;
+        else
+            ret = read_packets(wctx, &ifile);
+        if (print_section)
             writer_print_section_footer(wctx);
+        if (ret >= 0 && seek_index) {
+            ret = seek_index_write(seek_index, filename);
+            if (ret < 0)
+                av_log(NULL, AV_LOG_ERROR,
+                       "Could not write the seek index of %s: %s\n", filename,
+                       av_err2str(ret));
+        }
+        seek_index_free(&seek_index);
         CHECK_END;
     }
 
@@ -4251,6 +5088,7 @@ end:
     av_freep(&nb_streams_frames);
     av_freep(&nb_streams_packets);
     av_freep(&selected_streams);
+    av_dict_free(&input_format_opts);
 
     return ret;
 }
@@ -4767,6 +5605,8 @@ void ffprobe_var_cleanup() {
     do_show_pixel_format_flags = 0;
     do_show_pixel_format_components = 0;
     do_show_log = 0;
+    do_write_seek_index = 0;
+    count_threads = 0;
 
     do_show_chapter_tags = 0;
     do_show_format_tags = 0;
@@ -4959,7 +5799,7 @@ int ffprobe_execute(int argc, char **argv) {
          OPT_STRING | HAS_ARG,
          {&output_format},
          "set the output printing format (available formats are: default, "
-         "compact, csv, flat, ini, json, xml)",
+         "compact, csv, flat, ini, json, binary, xml)",
          "format"},
         {"print_format",
          OPT_STRING | HAS_ARG,
@@ -5022,6 +5862,17 @@ int ffprobe_execute(int argc, char **argv) {
          OPT_BOOL,
          {&do_count_packets},
          "count the number of packets per stream"},
+        {"count_threads",
+         OPT_INT | HAS_ARG,
+         {&count_threads},
+         "count frames and packets of time ranges of the input on this many "
+         "threads",
+         "number"},
+        {"write_seek_index",
+         OPT_BOOL,
+         {&do_write_seek_index},
+         "write an index of the keyframes next to the input, used by ffmpeg "
+         "to seek"},
         {"show_program_version",
          0,
          {.func_arg = &opt_show_program_version},
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFTOOLS_SEEK_INDEX_H
+#define FFTOOLS_SEEK_INDEX_H
+
+#include "libavcodec/packet.h"
+#include "libavformat/avformat.h"
+
+/**
+ * Keyframe positions of an input, saved in a sidecar file next to it so that
+ * later runs can seek to an exact byte offset instead of searching for it.
+ *
+ * Entries are kept for every video keyframe and for at most one packet per
+ * second of other streams. The sidecar records the size and modification
+ * time of the input and is ignored once the input changes.
+ */
+typedef struct SeekIndex SeekIndex;
+
+typedef struct SeekIndexEntry {
+    /* in the time base of the stream */
+    int64_t pts;
+    int64_t dts;
+    int64_t pos;
+} SeekIndexEntry;
+
+/**
+ * Return the sidecar file name of url, NULL if url is not a local file. The
+ * name must be freed with av_free().
+ */
+char *seek_index_filename(const char *url);
+
+SeekIndex *seek_index_alloc(void);
+void seek_index_free(SeekIndex **psi);
+
+/**
+ * Add a packet of st to the index if it is a keyframe worth indexing.
+ */
+int seek_index_add(SeekIndex *si, const AVStream *st, const AVPacket *pkt);
+
+/**
+ * Write the sidecar file of url. The file is replaced atomically.
+ */
+int seek_index_write(SeekIndex *si, const char *url);
+
+/**
+ * Read the sidecar file of url. Returns AVERROR(ENOENT) if there is none and
+ * AVERROR(ESTALE) if url changed since it was written.
+ */
+int seek_index_read(SeekIndex **psi, const char *url);
+
+/**
+ * Return the last entry of the stream at or before timestamp, which is in
+ * the time base of the stream, NULL if there is none.
+ */
+const SeekIndexEntry *seek_index_find(const SeekIndex *si, int stream_index,
+                                      int64_t timestamp);
+
+/**
+ * Seek ic to the keyframe of the default stream at or before timestamp,
+ * which is in AV_TIME_BASE units, using the sidecar file of url. Returns a
+ * negative error code when there is no usable index, in which case the
+ * position of ic is unchanged.
+ */
+int seek_index_seek(void *logctx, AVFormatContext *ic, const char *url,
+                    int64_t timestamp);
+
+#endif // FFTOOLS_SEEK_INDEX_H
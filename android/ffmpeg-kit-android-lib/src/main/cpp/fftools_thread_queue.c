@@ -25,6 +25,10 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - tq_send_many() and tq_receive_many() added
+ *
  * 07.2023
  * --------------------------------------------------------
  * - FFmpeg 6.0 changes migrated
@@ -35,6 +39,7 @@
 #include <string.h>
 
 #include "libavutil/avassert.h"
+#include "libavutil/common.h"
 #include "libavutil/error.h"
 #include "libavutil/fifo.h"
 #include "libavutil/intreadwrite.h"
@@ -171,6 +176,64 @@ finish:
     return ret;
 }
 
+int tq_send_many(ThreadQueue *tq, unsigned int stream_idx, void **data,
+                 unsigned int nb_items, unsigned int *nb_sent) {
+    int *finished;
+    unsigned int sent = 0;
+    int ret = 0;
+
+    av_assert0(stream_idx < tq->nb_streams);
+    finished = &tq->finished[stream_idx];
+
+    pthread_mutex_lock(&tq->lock);
+
+    if (*finished & FINISHED_SEND) {
+        ret = AVERROR(EINVAL);
+        goto finish;
+    }
+
+    while (sent < nb_items) {
+        size_t can_write;
+
+        while (!(*finished & FINISHED_RECV) && !av_fifo_can_write(tq->fifo))
+            pthread_cond_wait(&tq->cond, &tq->lock);
+
+        if (*finished & FINISHED_RECV) {
+            ret = AVERROR_EOF;
+            *finished |= FINISHED_SEND;
+            break;
+        }
+
+        /* fill all the free space at once, then wake the consumer once */
+        can_write = FFMIN(av_fifo_can_write(tq->fifo), nb_items - sent);
+        for (size_t i = 0; i < can_write; i++) {
+            FifoElem elem = {.stream_idx = stream_idx};
+
+            ret = objpool_get(tq->obj_pool, &elem.obj);
+            if (ret < 0)
+                break;
+
+            tq->obj_move(elem.obj, data[sent]);
+
+            ret = av_fifo_write(tq->fifo, &elem, 1);
+            av_assert0(ret >= 0);
+            sent++;
+        }
+        pthread_cond_broadcast(&tq->cond);
+
+        if (ret < 0)
+            break;
+    }
+
+finish:
+    pthread_mutex_unlock(&tq->lock);
+
+    if (nb_sent)
+        *nb_sent = sent;
+
+    return ret;
+}
+
 static int receive_locked(ThreadQueue *tq, int *stream_idx, void *data) {
     FifoElem elem;
     unsigned int nb_finished = 0;
@@ -224,6 +287,47 @@ int tq_receive(ThreadQueue *tq, int *stream_idx, void *data) {
     return ret;
 }
 
+int tq_receive_many(ThreadQueue *tq, int *stream_idx, void **data,
+                    unsigned int nb_items) {
+    unsigned int nb_received = 0;
+    int ret;
+
+    av_assert0(nb_items > 0);
+
+    stream_idx[0] = -1;
+
+    pthread_mutex_lock(&tq->lock);
+
+    while (1) {
+        ret = receive_locked(tq, &stream_idx[0], data[0]);
+        if (ret == AVERROR(EAGAIN)) {
+            pthread_cond_wait(&tq->cond, &tq->lock);
+            continue;
+        }
+
+        break;
+    }
+
+    if (ret == 0) {
+        FifoElem elem;
+
+        /* drain whatever else is already queued, without waiting for more */
+        nb_received = 1;
+        while (nb_received < nb_items &&
+               av_fifo_read(tq->fifo, &elem, 1) >= 0) {
+            tq->obj_move(data[nb_received], elem.obj);
+            objpool_release(tq->obj_pool, &elem.obj);
+            stream_idx[nb_received++] = elem.stream_idx;
+        }
+
+        pthread_cond_broadcast(&tq->cond);
+    }
+
+    pthread_mutex_unlock(&tq->lock);
+
+    return ret < 0 ? ret : nb_received;
+}
+
 void tq_send_finish(ThreadQueue *tq, unsigned int stream_idx) {
     av_assert0(stream_idx < tq->nb_streams);
 
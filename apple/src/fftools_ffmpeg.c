@@ -33,6 +33,24 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - input_stats_callback function pointer and set_input_stats_callback() setter
+ * method added, thread_queue_size_max option added
+ * - input packets returned with ifile_packet_release() instead of
+ * av_packet_free()
+ * - choose_output() picks the next output stream from a min-heap updated
+ * through ost_sched_update() instead of scanning all streams, reset_eagain()
+ * clears only the streams marked by ost_set_unavailable()
+ * - stream_loop_cache option added
+ * - output_stats_callback function pointer and set_output_stats_callback()
+ * setter method added, input_stats_callback reports bytes read
+ * - concat_prefetch and concat_prefetch_size options added
+ * - digest option added, input_stats_callback and output_stats_callback
+ * report the digests of the file
+ * - seek_index option added
+ * - set_file_cache_policy() setter and add_file_cache_options() added
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -208,8 +226,36 @@ __thread int64_t last_time = -1;
 __thread int64_t keyboard_last_time = 0;
 __thread int first_report = 1;
 
+typedef struct OstHeapEntry {
+    OutputStream *ost;
+    /* scheduling key, see ost_sched_key() */
+    int initialized;
+    int64_t opts;
+    /* position of the stream in ost_iter() order, breaks ties */
+    int order;
+} OstHeapEntry;
+
+/* output streams that are not finished, as a binary min-heap ordered by the
+ * timestamp they need next */
+__thread OstHeapEntry *ost_heap = NULL;
+__thread int nb_ost_heap = 0;
+
+/* output streams marked unavailable since the last reset_eagain() */
+__thread OutputStream **unavailable_osts = NULL;
+__thread int nb_unavailable_osts = 0;
+__thread int nb_unavailable_osts_max = 0;
+
+/* page cache policy of the local files of the session */
+__thread int file_cache_fadvise = 0;
+__thread int file_cache_direct = 0;
+
 void (*report_callback)(int, float, float, int64_t, double, double,
                         double) = NULL;
+void (*input_stats_callback)(int, const char *, uint64_t, uint64_t, double,
+                             double, int, int, int, uint64_t, uint64_t,
+                             uint64_t, const char *, const char *) = NULL;
+void (*output_stats_callback)(int, const char *, uint64_t, uint64_t,
+                              uint64_t, const char *, const char *) = NULL;
 
 extern int opt_map(void *optctx, const char *opt, const char *arg);
 extern int opt_map_channel(void *optctx, const char *opt, const char *arg);
@@ -529,6 +575,12 @@ static void ffmpeg_cleanup(int ret) {
     av_freep(&input_files);
     av_freep(&output_files);
 
+    av_freep(&ost_heap);
+    nb_ost_heap = 0;
+    av_freep(&unavailable_osts);
+    nb_unavailable_osts = 0;
+    nb_unavailable_osts_max = 0;
+
     uninit_opts();
 
     avformat_network_deinit();
@@ -1092,6 +1144,111 @@ static void print_stream_maps(void) {
     }
 }
 
+// uninitialized streams come first, in ost_iter() order; the rest are ordered
+// by the timestamp of their last output
+static void ost_sched_key(const OutputStream *ost, OstHeapEntry *e) {
+    e->initialized = !!ost->initialized;
+
+    if (!e->initialized)
+        e->opts = INT64_MIN;
+    else if (ost->filter && ost->filter->last_pts != AV_NOPTS_VALUE)
+        e->opts = ost->filter->last_pts;
+    else
+        e->opts = ost->last_mux_dts == AV_NOPTS_VALUE ? INT64_MIN
+                                                      : ost->last_mux_dts;
+}
+
+static int ost_heap_less(const OstHeapEntry *a, const OstHeapEntry *b) {
+    if (a->initialized != b->initialized)
+        return a->initialized < b->initialized;
+    if (a->opts != b->opts)
+        return a->opts < b->opts;
+    return a->order < b->order;
+}
+
+static void ost_heap_swap(int i, int j) {
+    FFSWAP(OstHeapEntry, ost_heap[i], ost_heap[j]);
+    ost_heap[i].ost->sched_idx = i;
+    ost_heap[j].ost->sched_idx = j;
+}
+
+static int ost_heap_sift_up(int i) {
+    int moved = 0;
+
+    while (i > 0 && ost_heap_less(&ost_heap[i], &ost_heap[(i - 1) / 2])) {
+        ost_heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+        moved = 1;
+    }
+
+    return moved;
+}
+
+static void ost_heap_sift_down(int i) {
+    while (1) {
+        int min = i, l = 2 * i + 1, r = 2 * i + 2;
+
+        if (l < nb_ost_heap && ost_heap_less(&ost_heap[l], &ost_heap[min]))
+            min = l;
+        if (r < nb_ost_heap && ost_heap_less(&ost_heap[r], &ost_heap[min]))
+            min = r;
+        if (min == i)
+            break;
+
+        ost_heap_swap(i, min);
+        i = min;
+    }
+}
+
+static void ost_heap_remove(int i) {
+    ost_heap[i].ost->sched_idx = -1;
+    ost_heap[i] = ost_heap[--nb_ost_heap];
+    if (i < nb_ost_heap) {
+        ost_heap[i].ost->sched_idx = i;
+        if (!ost_heap_sift_up(i))
+            ost_heap_sift_down(i);
+    }
+}
+
+static int ost_heap_init(void) {
+    int nb_osts = 0;
+
+    for (OutputStream *ost = ost_iter(NULL); ost; ost = ost_iter(ost))
+        nb_osts++;
+
+    ost_heap = av_calloc(nb_osts, sizeof(*ost_heap));
+    unavailable_osts = av_calloc(nb_osts, sizeof(*unavailable_osts));
+    if (nb_osts && (!ost_heap || !unavailable_osts))
+        return AVERROR(ENOMEM);
+    nb_unavailable_osts_max = nb_osts;
+
+    for (OutputStream *ost = ost_iter(NULL); ost; ost = ost_iter(ost)) {
+        OstHeapEntry *e = &ost_heap[nb_ost_heap];
+
+        if (ost->finished)
+            continue;
+
+        e->ost = ost;
+        e->order = nb_ost_heap;
+        ost_sched_key(ost, e);
+        ost->sched_idx = nb_ost_heap;
+        ost_heap_sift_up(nb_ost_heap++);
+    }
+
+    return 0;
+}
+
+void ost_sched_update(OutputStream *ost) {
+    int i = ost->sched_idx;
+
+    if (i < 0 || i >= nb_ost_heap || ost_heap[i].ost != ost)
+        return;
+
+    ost_sched_key(ost, &ost_heap[i]);
+    if (!ost_heap_sift_up(i))
+        ost_heap_sift_down(i);
+}
+
 /**
  * Select the output stream to process.
  *
@@ -1100,32 +1257,31 @@ static void print_stream_maps(void) {
  * @retval AVERROR_EOF no more streams need output
  */
 static int choose_output(OutputStream **post) {
-    int64_t opts_min = INT64_MAX;
-    OutputStream *ost_min = NULL;
+    while (nb_ost_heap) {
+        OstHeapEntry *top = &ost_heap[0];
+        OutputStream *ost = top->ost;
+        OstHeapEntry cur = *top;
 
-    for (OutputStream *ost = ost_iter(NULL); ost; ost = ost_iter(ost)) {
-        int64_t opts;
-
-        if (ost->filter && ost->filter->last_pts != AV_NOPTS_VALUE) {
-            opts = ost->filter->last_pts;
-        } else {
-            opts = ost->last_mux_dts == AV_NOPTS_VALUE ? INT64_MIN
-                                                       : ost->last_mux_dts;
+        if (ost->finished) {
+            ost_heap_remove(0);
+            continue;
         }
 
-        if (!ost->initialized && !ost->finished) {
-            ost_min = ost;
-            break;
-        }
-        if (!ost->finished && opts < opts_min) {
-            opts_min = opts;
-            ost_min = ost;
+        /* timestamp changes are pushed through ost_sched_update(), but the
+         * initialized flag is not; refresh the top entry and look again until
+         * it is up to date */
+        ost_sched_key(ost, &cur);
+        if (cur.initialized != top->initialized || cur.opts != top->opts) {
+            *top = cur;
+            ost_heap_sift_down(0);
+            continue;
         }
+
+        *post = ost;
+        return ost->unavailable ? AVERROR(EAGAIN) : 0;
     }
-    if (!ost_min)
-        return AVERROR_EOF;
-    *post = ost_min;
-    return ost_min->unavailable ? AVERROR(EAGAIN) : 0;
+
+    return AVERROR_EOF;
 }
 
 static void set_tty_echo(int on) {
@@ -1204,12 +1360,22 @@ static int check_keyboard_interaction(int64_t cur_time) {
     return 0;
 }
 
+void ost_set_unavailable(OutputStream *ost) {
+    if (ost->unavailable)
+        return;
+
+    ost->unavailable = 1;
+    if (nb_unavailable_osts < nb_unavailable_osts_max)
+        unavailable_osts[nb_unavailable_osts++] = ost;
+}
+
 static void reset_eagain(void) {
     int i;
     for (i = 0; i < nb_input_files; i++)
         input_files[i]->eagain = 0;
-    for (OutputStream *ost = ost_iter(NULL); ost; ost = ost_iter(ost))
-        ost->unavailable = 0;
+    for (i = 0; i < nb_unavailable_osts; i++)
+        unavailable_osts[i]->unavailable = 0;
+    nb_unavailable_osts = 0;
 }
 
 static void decode_flush(InputFile *ifile) {
@@ -1289,7 +1455,7 @@ static int process_input(int file_index) {
 
     ret = process_input_packet(ist, pkt, 0);
 
-    av_packet_free(&pkt);
+    ifile_packet_release(ifile, &pkt);
 
     return ret < 0 ? ret : 0;
 }
@@ -1316,7 +1482,7 @@ static int transcode_step(OutputStream *ost) {
     ret = process_input(ist->file_index);
     if (ret == AVERROR(EAGAIN)) {
         if (input_files[ist->file_index]->eagain)
-            ost->unavailable = 1;
+            ost_set_unavailable(ost);
         return 0;
     }
 
@@ -1351,6 +1517,10 @@ static int transcode(int *err_rate_exceeded) {
         av_log(NULL, AV_LOG_INFO, "Press [q] to stop, [?] for help\n");
     }
 
+    ret = ost_heap_init();
+    if (ret < 0)
+        return ret;
+
     timer_start = av_gettime_relative();
 
     while (!received_sigterm && !cancelRequested(globalSessionId)) {
@@ -1503,6 +1673,42 @@ void set_report_callback(void (*callback)(int, float, float, int64_t, double,
     report_callback = callback;
 }
 
+void set_input_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                               uint64_t, double, double, int,
+                                               int, int, uint64_t, uint64_t,
+                                               uint64_t, const char *,
+                                               const char *)) {
+    input_stats_callback = callback;
+}
+
+void set_output_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                                uint64_t, uint64_t,
+                                                const char *, const char *)) {
+    output_stats_callback = callback;
+}
+
+void set_file_cache_policy(int fadvise, int direct) {
+    file_cache_fadvise = fadvise;
+    file_cache_direct = direct;
+}
+
+int add_file_cache_options(AVDictionary **opts, const char *filename,
+                           int output) {
+    const char *protocol = avio_find_protocol_name(filename);
+    int ret = 0;
+
+    /* the options exist on file: only, other protocols would reject them */
+    if (!protocol || strcmp(protocol, "file"))
+        return 0;
+
+    if (file_cache_fadvise)
+        ret = av_dict_set(opts, "file_fadvise", "1", AV_DICT_DONT_OVERWRITE);
+    if (ret >= 0 && file_cache_direct && output)
+        ret = av_dict_set(opts, "file_direct", "1", AV_DICT_DONT_OVERWRITE);
+
+    return ret;
+}
+
 void cancel_operation(long id) {
     if (id == 0) {
         sigterm_handler(SIGINT);
@@ -1728,6 +1934,11 @@ int ffmpeg_execute(int argc, char **argv) {
          OPT_BOOL | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
          {.off = OFFSET(accurate_seek)},
          "enable/disable accurate seeking with -ss"},
+        {"seek_index",
+         OPT_BOOL | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
+         {.off = OFFSET(seek_index)},
+         "enable/disable seeking with the seek index written by ffprobe "
+         "-write_seek_index"},
         {"isync",
          HAS_ARG | OPT_INT | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
          {.off = OFFSET(input_sync_ref)},
@@ -1981,6 +2192,12 @@ int ffmpeg_execute(int argc, char **argv) {
          {.off = OFFSET(loop)},
          "set number of times input stream shall be looped",
          "loop count"},
+        {"stream_loop_cache",
+         OPT_INT64 | HAS_ARG | OPT_EXPERT | OPT_INPUT | OPT_OFFSET,
+         {.off = OFFSET(loop_cache_size)},
+         "keep up to this many bytes of packets of a looped input in memory "
+         "and replay them instead of demuxing the input again",
+         "size"},
         {"debug_ts",
          OPT_BOOL | OPT_EXPERT,
          {&debug_ts},
@@ -2005,6 +2222,28 @@ int ffmpeg_execute(int argc, char **argv) {
          HAS_ARG | OPT_INT | OPT_OFFSET | OPT_EXPERT | OPT_INPUT | OPT_OUTPUT,
          {.off = OFFSET(thread_queue_size)},
          "set the maximum number of queued packets from the demuxer"},
+        {"thread_queue_size_max",
+         HAS_ARG | OPT_INT | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
+         {.off = OFFSET(thread_queue_size_max)},
+         "set the upper bound for the adaptive demuxer queue size"},
+        {"digest",
+         HAS_ARG | OPT_STRING | OPT_OFFSET | OPT_INPUT | OPT_OUTPUT,
+         {.off = OFFSET(digest)},
+         "compute digests of the file while it is read or written, "
+         "separated by '+'",
+         "md5+sha256"},
+        {"concat_prefetch",
+         HAS_ARG | OPT_INT | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
+         {.off = OFFSET(concat_prefetch)},
+         "read ahead the first bytes of this many local entries of a concat "
+         "list ahead of the one being read",
+         "count"},
+        {"concat_prefetch_size",
+         HAS_ARG | OPT_INT64 | OPT_OFFSET | OPT_EXPERT | OPT_INPUT,
+         {.off = OFFSET(concat_prefetch_size)},
+         "set the number of bytes read ahead for the prefetched concat "
+         "entries",
+         "size"},
         {"find_stream_info",
          OPT_BOOL | OPT_INPUT | OPT_EXPERT | OPT_OFFSET,
          {.off = OFFSET(find_stream_info)},
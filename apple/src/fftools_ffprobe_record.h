@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFTOOLS_FFPROBE_RECORD_H
+#define FFTOOLS_FFPROBE_RECORD_H
+
+#include <stdint.h>
+
+#define FFPROBE_RECORD_BATCH_SIZE 256
+
+enum FFprobeRecordType {
+    FFPROBE_RECORD_PACKET,
+    FFPROBE_RECORD_FRAME,
+};
+
+/**
+ * A packet or a frame read by ffprobe. Timestamps are in the time base of
+ * the stream, AV_NOPTS_VALUE when they are not defined.
+ */
+typedef struct FFprobeRecord {
+    int64_t pts;
+    /* dts of the packet, or of the packet a frame was decoded from */
+    int64_t dts;
+    int64_t duration;
+    /* byte position in the input, -1 if not known */
+    int64_t pos;
+    int time_base_num;
+    int time_base_den;
+    int stream_index;
+    /* size of the packet, or of the packet a frame was decoded from */
+    int size;
+    /* AV_PKT_FLAG_* for packets, AV_FRAME_FLAG_* for frames */
+    int flags;
+    /* enum AVPictureType of video frames, AV_PICTURE_TYPE_NONE otherwise */
+    int pict_type;
+    /* enum FFprobeRecordType */
+    int type;
+} FFprobeRecord;
+
+typedef void (*FFprobeRecordCallback)(void *opaque,
+                                      const FFprobeRecord *records,
+                                      int nb_records);
+
+/**
+ * Deliver the packets and frames selected with -show_packets and -show_frames
+ * to callback, in batches of at most FFPROBE_RECORD_BATCH_SIZE records,
+ * instead of printing them. The callback applies to ffprobe runs on the
+ * calling thread only. Passing NULL restores printing.
+ */
+void set_ffprobe_record_callback(FFprobeRecordCallback callback,
+                                 void *opaque);
+
+#endif // FFTOOLS_FFPROBE_RECORD_H
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "fftools_seek_index.h"
+
+#include "libavutil/avstring.h"
+#include "libavutil/error.h"
+#include "libavutil/log.h"
+#include "libavutil/mem.h"
+#include "libavutil/timestamp.h"
+
+#define SEEK_INDEX_TAG "FFKSEEK1"
+#define SEEK_INDEX_VERSION 1
+#define SEEK_INDEX_SUFFIX ".seekidx"
+
+/* smallest stored record of a stream: time base and entry count */
+#define SEEK_INDEX_STREAM_SIZE 12
+/* smallest stored entry: three one byte varints */
+#define SEEK_INDEX_ENTRY_SIZE 3
+
+typedef struct SeekIndexStream {
+    AVRational time_base;
+    SeekIndexEntry *entries;
+    int nb_entries;
+    unsigned int entries_size;
+    /* only video keyframes are all indexed, other streams have one entry per
+     * second at most */
+    int sparse;
+} SeekIndexStream;
+
+struct SeekIndex {
+    SeekIndexStream *streams;
+    int nb_streams;
+};
+
+static int local_path(const char *url, const char **path) {
+    const char *proto = avio_find_protocol_name(url);
+
+    if (!proto || strcmp(proto, "file"))
+        return 0;
+    if (!av_strstart(url, "file:", path))
+        *path = url;
+    return 1;
+}
+
+static int input_identity(const char *url, int64_t *size, int64_t *mtime) {
+    const char *path;
+    struct stat st;
+
+    if (!local_path(url, &path))
+        return AVERROR(ENOSYS);
+    if (stat(path, &st) < 0)
+        return AVERROR(errno);
+    if (!S_ISREG(st.st_mode))
+        return AVERROR(EINVAL);
+
+    *size = st.st_size;
+    *mtime = st.st_mtime;
+    return 0;
+}
+
+char *seek_index_filename(const char *url) {
+    const char *path;
+
+    if (!local_path(url, &path))
+        return NULL;
+    return av_asprintf("%s%s", path, SEEK_INDEX_SUFFIX);
+}
+
+SeekIndex *seek_index_alloc(void) { return av_mallocz(sizeof(SeekIndex)); }
+
+void seek_index_free(SeekIndex **psi) {
+    SeekIndex *si = *psi;
+
+    if (!si)
+        return;
+
+    for (int i = 0; i < si->nb_streams; i++)
+        av_freep(&si->streams[i].entries);
+    av_freep(&si->streams);
+    av_freep(psi);
+}
+
+static int add_streams(SeekIndex *si, int nb_streams) {
+    SeekIndexStream *streams;
+
+    if (nb_streams <= si->nb_streams)
+        return 0;
+
+    streams = av_realloc_array(si->streams, nb_streams, sizeof(*streams));
+    if (!streams)
+        return AVERROR(ENOMEM);
+    memset(&streams[si->nb_streams], 0,
+           (nb_streams - si->nb_streams) * sizeof(*streams));
+    si->streams = streams;
+    si->nb_streams = nb_streams;
+    return 0;
+}
+
+int seek_index_add(SeekIndex *si, const AVStream *st, const AVPacket *pkt) {
+    int64_t pts = pkt->pts != AV_NOPTS_VALUE ? pkt->pts : pkt->dts;
+    int64_t dts = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+    SeekIndexStream *sis;
+    SeekIndexEntry *entries;
+    int ret;
+
+    if (!(pkt->flags & AV_PKT_FLAG_KEY) || pts == AV_NOPTS_VALUE ||
+        pkt->pos < 0)
+        return 0;
+
+    if ((ret = add_streams(si, st->index + 1)) < 0)
+        return ret;
+
+    sis = &si->streams[st->index];
+    if (!sis->nb_entries) {
+        sis->time_base = st->time_base;
+        sis->sparse = st->codecpar->codec_type != AVMEDIA_TYPE_VIDEO;
+    } else if (sis->sparse) {
+        int64_t last = sis->entries[sis->nb_entries - 1].pts;
+        if (FFABS(pts - last) <
+            av_rescale_q(AV_TIME_BASE, AV_TIME_BASE_Q, sis->time_base))
+            return 0;
+    }
+
+    entries = av_fast_realloc(sis->entries, &sis->entries_size,
+                              (sis->nb_entries + 1) * sizeof(*entries));
+    if (!entries)
+        return AVERROR(ENOMEM);
+    sis->entries = entries;
+
+    entries[sis->nb_entries].pts = pts;
+    entries[sis->nb_entries].dts = dts;
+    entries[sis->nb_entries].pos = pkt->pos;
+    sis->nb_entries++;
+    return 0;
+}
+
+static int compare_entries(const void *a, const void *b) {
+    const SeekIndexEntry *ea = a;
+    const SeekIndexEntry *eb = b;
+    return FFDIFFSIGN(ea->pts, eb->pts);
+}
+
+/* zigzag encoded, so that small negative deltas stay small */
+static void write_varint(AVIOContext *pb, int64_t value) {
+    uint64_t v = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+
+    while (v >= 0x80) {
+        avio_w8(pb, (v & 0x7f) | 0x80);
+        v >>= 7;
+    }
+    avio_w8(pb, v);
+}
+
+static int read_varint(AVIOContext *pb, int64_t *value) {
+    uint64_t v = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = avio_r8(pb);
+        if (avio_feof(pb))
+            return AVERROR_INVALIDDATA;
+        v |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+            return 0;
+        }
+    }
+    return AVERROR_INVALIDDATA;
+}
+
+/* deltas are computed modulo 2^64, corrupt values can't overflow */
+static int64_t delta(int64_t value, int64_t previous) {
+    return (int64_t)((uint64_t)value - (uint64_t)previous);
+}
+
+static int64_t undelta(int64_t value, int64_t previous) {
+    return (int64_t)((uint64_t)previous + (uint64_t)value);
+}
+
+int seek_index_write(SeekIndex *si, const char *url) {
+    AVIOContext *pb = NULL;
+    char *filename = seek_index_filename(url);
+    char *tmp = NULL;
+    int64_t size, mtime;
+    int ret;
+
+    if (!filename)
+        return AVERROR(ENOSYS);
+    if ((ret = input_identity(url, &size, &mtime)) < 0)
+        goto end;
+
+    tmp = av_asprintf("file:%s.tmp", filename);
+    if (!tmp) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    if ((ret = avio_open(&pb, tmp, AVIO_FLAG_WRITE)) < 0)
+        goto end;
+
+    avio_write(pb, SEEK_INDEX_TAG, 8);
+    avio_wl32(pb, SEEK_INDEX_VERSION);
+    avio_wl32(pb, si->nb_streams);
+    avio_wl64(pb, size);
+    avio_wl64(pb, mtime);
+
+    for (int i = 0; i < si->nb_streams; i++) {
+        SeekIndexStream *sis = &si->streams[i];
+        SeekIndexEntry previous = {0, 0, 0};
+
+        if (sis->nb_entries)
+            qsort(sis->entries, sis->nb_entries, sizeof(*sis->entries),
+                  compare_entries);
+
+        avio_wl32(pb, sis->time_base.num);
+        avio_wl32(pb, sis->time_base.den);
+        avio_wl32(pb, sis->nb_entries);
+        for (int j = 0; j < sis->nb_entries; j++) {
+            const SeekIndexEntry *e = &sis->entries[j];
+            write_varint(pb, delta(e->pts, previous.pts));
+            write_varint(pb, delta(e->dts, previous.dts));
+            write_varint(pb, delta(e->pos, previous.pos));
+            previous = *e;
+        }
+    }
+
+    avio_flush(pb);
+    ret = pb->error;
+    if (avio_closep(&pb) < 0 && ret >= 0)
+        ret = AVERROR(EIO);
+
+    /* readers never see a partially written index */
+    if (ret >= 0 && rename(tmp + 5, filename) < 0)
+        ret = AVERROR(errno);
+    if (ret < 0)
+        remove(tmp + 5);
+
+end:
+    avio_closep(&pb);
+    av_free(tmp);
+    av_free(filename);
+    return ret;
+}
+
+static int read_stream(AVIOContext *pb, SeekIndexStream *sis,
+                       int64_t remaining) {
+    SeekIndexEntry previous = {0, 0, 0};
+    unsigned int nb_entries;
+    int ret;
+
+    sis->time_base.num = (int)avio_rl32(pb);
+    sis->time_base.den = (int)avio_rl32(pb);
+    nb_entries = avio_rl32(pb);
+    if (avio_feof(pb) || sis->time_base.num <= 0 || sis->time_base.den <= 0 ||
+        nb_entries > remaining / SEEK_INDEX_ENTRY_SIZE)
+        return AVERROR_INVALIDDATA;
+    if (!nb_entries)
+        return 0;
+
+    sis->entries = av_malloc_array(nb_entries, sizeof(*sis->entries));
+    if (!sis->entries)
+        return AVERROR(ENOMEM);
+    sis->entries_size = nb_entries * sizeof(*sis->entries);
+
+    for (unsigned int j = 0; j < nb_entries; j++) {
+        SeekIndexEntry *e = &sis->entries[j];
+        if ((ret = read_varint(pb, &e->pts)) < 0 ||
+            (ret = read_varint(pb, &e->dts)) < 0 ||
+            (ret = read_varint(pb, &e->pos)) < 0)
+            return ret;
+        e->pts = undelta(e->pts, previous.pts);
+        e->dts = undelta(e->dts, previous.dts);
+        e->pos = undelta(e->pos, previous.pos);
+        if (e->pos < 0 || (j && e->pts < previous.pts))
+            return AVERROR_INVALIDDATA;
+        previous = *e;
+        sis->nb_entries++;
+    }
+    return 0;
+}
+
+int seek_index_read(SeekIndex **psi, const char *url) {
+    AVIOContext *pb = NULL;
+    SeekIndex *si = NULL;
+    char *filename = seek_index_filename(url);
+    char *file_url = NULL;
+    uint8_t tag[8];
+    int64_t size, mtime, file_size;
+    unsigned int version, nb_streams;
+    int ret;
+
+    *psi = NULL;
+    if (!filename)
+        return AVERROR(ENOSYS);
+    if ((ret = input_identity(url, &size, &mtime)) < 0)
+        goto end;
+
+    file_url = av_asprintf("file:%s", filename);
+    if (!file_url) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    if ((ret = avio_open(&pb, file_url, AVIO_FLAG_READ)) < 0)
+        goto end;
+
+    file_size = avio_size(pb);
+    ret = avio_read(pb, tag, sizeof(tag));
+    version = avio_rl32(pb);
+    nb_streams = avio_rl32(pb);
+    if (ret != sizeof(tag) || memcmp(tag, SEEK_INDEX_TAG, sizeof(tag)) ||
+        version != SEEK_INDEX_VERSION || file_size < 0 ||
+        nb_streams > file_size / SEEK_INDEX_STREAM_SIZE) {
+        ret = AVERROR_INVALIDDATA;
+        goto end;
+    }
+    if (avio_rl64(pb) != size || avio_rl64(pb) != mtime) {
+        ret = AVERROR(ESTALE);
+        goto end;
+    }
+
+    si = seek_index_alloc();
+    if (!si || (ret = add_streams(si, nb_streams)) < 0) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    for (int i = 0; i < si->nb_streams; i++) {
+        ret = read_stream(pb, &si->streams[i], file_size - avio_tell(pb));
+        if (ret < 0)
+            goto end;
+    }
+
+    *psi = si;
+    si = NULL;
+    ret = 0;
+
+end:
+    seek_index_free(&si);
+    avio_closep(&pb);
+    av_free(file_url);
+    av_free(filename);
+    return ret;
+}
+
+const SeekIndexEntry *seek_index_find(const SeekIndex *si, int stream_index,
+                                      int64_t timestamp) {
+    const SeekIndexStream *sis;
+    int lo = 0, hi;
+
+    if (stream_index < 0 || stream_index >= si->nb_streams)
+        return NULL;
+
+    sis = &si->streams[stream_index];
+    hi = sis->nb_entries;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (sis->entries[mid].pts <= timestamp)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo ? &sis->entries[lo - 1] : NULL;
+}
+
+int seek_index_seek(void *logctx, AVFormatContext *ic, const char *url,
+                    int64_t timestamp) {
+    SeekIndex *si = NULL;
+    const SeekIndexEntry *entry;
+    AVRational time_base;
+    int stream_index, ret;
+
+    if (ic->iformat->flags & AVFMT_NO_BYTE_SEEK)
+        return AVERROR(ENOSYS);
+
+    ret = seek_index_read(&si, url);
+    if (ret == AVERROR(ESTALE)) {
+        av_log(logctx, AV_LOG_WARNING,
+               "Seek index of %s is out of date, ignored\n", url);
+        return ret;
+    } else if (ret == AVERROR_INVALIDDATA) {
+        av_log(logctx, AV_LOG_WARNING, "Seek index of %s is invalid, ignored\n",
+               url);
+        return ret;
+    } else if (ret < 0) {
+        return ret;
+    }
+
+    stream_index = av_find_default_stream_index(ic);
+    if (stream_index < 0 || stream_index >= si->nb_streams) {
+        ret = AVERROR(EINVAL);
+        goto end;
+    }
+    time_base = ic->streams[stream_index]->time_base;
+    if (av_cmp_q(time_base, si->streams[stream_index].time_base)) {
+        ret = AVERROR(EINVAL);
+        goto end;
+    }
+
+    entry = seek_index_find(si, stream_index,
+                            av_rescale_q(timestamp, AV_TIME_BASE_Q, time_base));
+    if (!entry) {
+        ret = AVERROR(ERANGE);
+        goto end;
+    }
+
+    ret = avformat_seek_file(ic, -1, entry->pos, entry->pos, entry->pos,
+                             AVSEEK_FLAG_BYTE);
+    if (ret >= 0)
+        av_log(logctx, AV_LOG_VERBOSE,
+               "Seek index: keyframe at %s, byte %" PRId64 "\n",
+               av_ts2timestr(entry->pts, &time_base), entry->pos);
+
+end:
+    seek_index_free(&si);
+    return ret;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BlockCacheStatistics.h"
+
+ffmpegkit::BlockCacheStatistics::BlockCacheStatistics(const int64_t hits,
+                                                      const int64_t misses,
+                                                      const int64_t evictions,
+                                                      const int64_t size,
+                                                      const int64_t maxSize)
+    : _hits{hits}, _misses{misses}, _evictions{evictions}, _size{size},
+      _maxSize{maxSize} {}
+
+int64_t ffmpegkit::BlockCacheStatistics::getHits() { return _hits; }
+
+int64_t ffmpegkit::BlockCacheStatistics::getMisses() { return _misses; }
+
+int64_t ffmpegkit::BlockCacheStatistics::getEvictions() { return _evictions; }
+
+int64_t ffmpegkit::BlockCacheStatistics::getSize() { return _size; }
+
+int64_t ffmpegkit::BlockCacheStatistics::getMaxSize() { return _maxSize; }
+
+double ffmpegkit::BlockCacheStatistics::getHitRate() {
+    if (_hits + _misses == 0) {
+        return 0;
+    }
+    return (double)_hits / (_hits + _misses);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_BLOCK_CACHE_STATISTICS_H
+#define FFMPEG_KIT_BLOCK_CACHE_STATISTICS_H
+
+#include <stdint.h>
+
+namespace ffmpegkit {
+
+/**
+ * Snapshot of the counters of the block cache shared by all sessions reading
+ * <code>blockcache:</code> urls.
+ */
+class BlockCacheStatistics {
+  public:
+    BlockCacheStatistics(const int64_t hits, const int64_t misses,
+                         const int64_t evictions, const int64_t size,
+                         const int64_t maxSize);
+
+    /**
+     * Returns the number of block reads served from memory.
+     */
+    int64_t getHits();
+
+    /**
+     * Returns the number of block reads that went to the file.
+     */
+    int64_t getMisses();
+
+    /**
+     * Returns the number of blocks dropped to stay within the size limit.
+     */
+    int64_t getEvictions();
+
+    /**
+     * Returns the memory currently used by cached blocks, in bytes.
+     */
+    int64_t getSize();
+
+    /**
+     * Returns the memory limit of the cache, in bytes.
+     */
+    int64_t getMaxSize();
+
+    /**
+     * Returns the ratio of hits to all block reads, zero if nothing was read.
+     */
+    double getHitRate();
+
+  private:
+    int64_t _hits;
+    int64_t _misses;
+    int64_t _evictions;
+    int64_t _size;
+    int64_t _maxSize;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_BLOCK_CACHE_STATISTICS_H
@@ -19,41 +19,67 @@
 
 #include "Chapter.h"
 
+static constexpr const char *ChapterKeyChapters = "chapters";
+
 ffmpegkit::Chapter::Chapter(std::shared_ptr<rapidjson::Value> chapterValue)
-    : _chapterValue{chapterValue} {}
+    : _position{-1} {
+    if (chapterValue != nullptr) {
+        _fields = ChapterFields::from(*chapterValue);
+        _json = std::make_shared<LazyJsonDocument>(
+            LazyJsonDocument::copy(*chapterValue));
+    }
+}
+
+ffmpegkit::Chapter::Chapter(const ChapterFields &fields,
+                            std::shared_ptr<LazyJsonDocument> json,
+                            size_t position)
+    : _fields{fields}, _json{json}, _position{(int64_t)position} {}
+
+const ffmpegkit::ChapterFields &ffmpegkit::Chapter::getFields() const {
+    return _fields;
+}
 
 std::shared_ptr<int64_t> ffmpegkit::Chapter::getId() {
-    return getNumberProperty(KeyId);
+    return toSharedNumber(_fields.id);
 }
 
 std::shared_ptr<std::string> ffmpegkit::Chapter::getTimeBase() {
-    return getStringProperty(KeyTimeBase);
+    return toSharedString(_fields.timeBase);
 }
 
 std::shared_ptr<int64_t> ffmpegkit::Chapter::getStart() {
-    return getNumberProperty(KeyStart);
+    return toSharedNumber(_fields.start);
 }
 
 std::shared_ptr<std::string> ffmpegkit::Chapter::getStartTime() {
-    return getStringProperty(KeyStartTime);
+    if (_fields.startTime || !_fields.lossy) {
+        return toSharedString(_fields.startTime);
+    } else {
+        return getStringProperty(KeyStartTime);
+    }
 }
 
 std::shared_ptr<int64_t> ffmpegkit::Chapter::getEnd() {
-    return getNumberProperty(KeyEnd);
+    return toSharedNumber(_fields.end);
 }
 
 std::shared_ptr<std::string> ffmpegkit::Chapter::getEndTime() {
-    return getStringProperty(KeyEndTime);
+    if (_fields.endTime || !_fields.lossy) {
+        return toSharedString(_fields.endTime);
+    } else {
+        return getStringProperty(KeyEndTime);
+    }
 }
 
 std::shared_ptr<rapidjson::Value> ffmpegkit::Chapter::getTags() {
-    return getProperty(KeyTags);
+    return toSharedTags(_fields.tags);
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::Chapter::getStringProperty(const char *key) {
-    if (_chapterValue->HasMember(key)) {
-        return std::make_shared<std::string>((*_chapterValue)[key].GetString());
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsString()) {
+        return std::make_shared<std::string>(value->GetString());
     } else {
         return nullptr;
     }
@@ -61,8 +87,10 @@ ffmpegkit::Chapter::getStringProperty(const char *key) {
 
 std::shared_ptr<int64_t>
 ffmpegkit::Chapter::getNumberProperty(const char *key) {
-    if (_chapterValue->HasMember(key)) {
-        return std::make_shared<int64_t>((*_chapterValue)[key].GetInt64());
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsNumber()) {
+        return std::make_shared<int64_t>(
+            value->IsInt64() ? value->GetInt64() : (int64_t)value->GetDouble());
     } else {
         return nullptr;
     }
@@ -70,21 +98,30 @@ ffmpegkit::Chapter::getNumberProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::Chapter::getProperty(const char *key) {
-    if (_chapterValue->HasMember(key)) {
-        auto value = std::make_shared<rapidjson::Value>();
-        *value = (*_chapterValue)[key];
-        return value;
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
 }
 
 std::shared_ptr<rapidjson::Value> ffmpegkit::Chapter::getAllProperties() {
-    if (_chapterValue != nullptr) {
-        auto all = std::make_shared<rapidjson::Value>();
-        *all = (*_chapterValue);
-        return all;
+    auto value = getValue();
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
 }
+
+const rapidjson::Value *ffmpegkit::Chapter::getValue() const {
+    if (_json == nullptr) {
+        return nullptr;
+    } else if (_position < 0) {
+        return &_json->getRoot();
+    } else {
+        return LazyJsonDocument::findElement(
+            _json->getRoot(), ChapterKeyChapters, (size_t)_position);
+    }
+}
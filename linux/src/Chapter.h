@@ -22,6 +22,7 @@
 
 // OVERRIDING THE MACRO TO PREVENT APPLICATION TERMINATION
 #define RAPIDJSON_ASSERT(x)
+#include "MediaInformationFields.h"
 #include "rapidjson/document.h"
 #include <iostream>
 #include <memory>
@@ -44,6 +45,22 @@ class Chapter {
 
     Chapter(std::shared_ptr<rapidjson::Value> chapterValue);
 
+    /**
+     * Creates a chapter from fields already extracted. Keys that are not
+     * extracted are looked up in the element of the chapters array at the
+     * given position of the json document.
+     */
+    Chapter(const ChapterFields &fields, std::shared_ptr<LazyJsonDocument> json,
+            size_t position);
+
+    /**
+     * Returns the typed fields of this chapter. Unlike the other getters this
+     * neither allocates nor accesses the json document.
+     *
+     * @return chapter fields
+     */
+    const ChapterFields &getFields() const;
+
     std::shared_ptr<int64_t> getId();
 
     std::shared_ptr<std::string> getTimeBase();
@@ -88,7 +105,13 @@ class Chapter {
     std::shared_ptr<rapidjson::Value> getAllProperties();
 
   private:
-    std::shared_ptr<rapidjson::Value> _chapterValue;
+    const rapidjson::Value *getValue() const;
+
+    ChapterFields _fields;
+    std::shared_ptr<LazyJsonDocument> _json;
+
+    /* -1 if the root of the document is the chapter */
+    int64_t _position;
 };
 
 } // namespace ffmpegkit
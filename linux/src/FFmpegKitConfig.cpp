@@ -17,12 +17,16 @@
  * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fcntl.h>
 #include <pthread.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 extern "C" {
 #include "fftools_cmdutils.h"
+#include "fftools_ffprobe_record.h"
 #include "libavutil/bprint.h"
+#include "libavutil/file.h"
 #include "libavutil/ffversion.h"
 }
 #include "ArchDetect.h"
@@ -33,12 +37,15 @@ extern "C" {
 #include "FFprobeSession.h"
 #include "Level.h"
 #include "LogRedirectionStrategy.h"
+#include "MediaInformationProbe.h"
 #include "MediaInformationSession.h"
 #include "Packages.h"
 #include "SessionState.h"
 #include <algorithm>
 #include <atomic>
+#include <climits>
 #include <condition_variable>
+#include <cstdlib>
 #include <fstream>
 #include <future>
 #include <iostream>
@@ -47,6 +54,15 @@ extern "C" {
 extern "C" {
 void set_report_callback(void (*callback)(int, float, float, int64_t, double,
                                           double, double));
+void set_input_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                               uint64_t, double, double, int,
+                                               int, int, uint64_t, uint64_t,
+                                               uint64_t, const char *,
+                                               const char *));
+void set_output_stats_callback(void (*callback)(int, const char *, uint64_t,
+                                                uint64_t, uint64_t,
+                                                const char *, const char *));
+void set_file_cache_policy(int fadvise, int direct);
 void cancel_operation(long id);
 }
 
@@ -81,6 +97,9 @@ static ffmpegkit::MediaInformationSessionCompleteCallback
 
 static ffmpegkit::LogRedirectionStrategy globalLogRedirectionStrategy;
 
+/** Holds the persistent media information cache */
+static std::shared_ptr<ffmpegkit::MediaInformationCache> mediaInformationCache;
+
 /** Redirection control variables */
 static int redirectionEnabled;
 static std::recursive_mutex callbackDataMutex;
@@ -89,6 +108,35 @@ static std::condition_variable callbackMonitor;
 class CallbackData;
 static std::list<CallbackData *> callbackDataList;
 
+/**
+ * Callbacks bound to a memory url.
+ */
+struct MemoryIO {
+    ffmpegkit::MemoryReadCallback readCallback;
+    ffmpegkit::MemoryWriteCallback writeCallback;
+    ffmpegkit::MemorySeekCallback seekCallback;
+
+    /** Invoked with the AVIO_FLAG_* flags each time the url is opened */
+    std::function<void(int)> openCallback;
+};
+
+/**
+ * Generates ids for memory urls.
+ */
+static std::atomic<int> memoryIOIdGenerator(1);
+static std::map<int, std::shared_ptr<MemoryIO>> memoryIOMap;
+static std::mutex memoryIOMutex;
+
+/**
+ * Receives the records of an FFprobe execution.
+ */
+struct RecordSink {
+    ffmpegkit::MediaRecordCallback callback;
+
+    /** Reused for every batch */
+    std::vector<ffmpegkit::MediaRecord> records;
+};
+
 /** Fields that control the handling of SIGNALs */
 volatile int handleSIGQUIT = 1;
 volatile int handleSIGINT = 1;
@@ -521,6 +569,46 @@ void ffmpegkit_statistics_callback_function(int frameNumber, float fps,
                               speed);
 }
 
+/**
+ * Adds input statistics to the session of the current thread. Input statistics
+ * are generated once per input, on the thread executing the session, so they
+ * are stored directly instead of going through the callback thread.
+ */
+void ffmpegkit_input_statistics_callback_function(
+    int fileIndex, const char *url, uint64_t packets, uint64_t size,
+    double producerBlockedTime, double consumerStarvedTime, int queueSizeMin,
+    int queueSizeMax, int queueSizePeak, uint64_t packetPoolHits,
+    uint64_t packetPoolMisses, uint64_t bytesRead, const char *md5,
+    const char *sha256) {
+    auto session = ffmpegkit::FFmpegKitConfig::getSession(globalSessionId);
+    if (session != nullptr && session->isFFmpeg()) {
+        std::static_pointer_cast<ffmpegkit::FFmpegSession>(session)
+            ->addInputStatistics(std::make_shared<ffmpegkit::InputStatistics>(
+                globalSessionId, fileIndex, url != NULL ? url : "", packets,
+                size, producerBlockedTime, consumerStarvedTime, queueSizeMin,
+                queueSizeMax, queueSizePeak, packetPoolHits,
+                packetPoolMisses, bytesRead, md5 != NULL ? md5 : "",
+                sha256 != NULL ? sha256 : ""));
+    }
+}
+
+/**
+ * Adds output statistics to the session of the current thread, the same way
+ * input statistics are added.
+ */
+void ffmpegkit_output_statistics_callback_function(
+    int fileIndex, const char *url, uint64_t packets, uint64_t size,
+    uint64_t bytesWritten, const char *md5, const char *sha256) {
+    auto session = ffmpegkit::FFmpegKitConfig::getSession(globalSessionId);
+    if (session != nullptr && session->isFFmpeg()) {
+        std::static_pointer_cast<ffmpegkit::FFmpegSession>(session)
+            ->addOutputStatistics(std::make_shared<ffmpegkit::OutputStatistics>(
+                globalSessionId, fileIndex, url != NULL ? url : "", packets,
+                size, bytesWritten, md5 != NULL ? md5 : "",
+                sha256 != NULL ? sha256 : ""));
+    }
+}
+
 static void process_log(long sessionId, int levelValueInt,
                         AVBPrint *logMessage) {
     int activeLogLevel = av_log_get_level();
@@ -797,6 +885,165 @@ int executeFFprobe(const long sessionId,
     return returnCode;
 }
 
+static int executeNativeProbe(
+    const long sessionId, const std::string &path,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions,
+    std::shared_ptr<ffmpegkit::MediaInformation> &mediaInformation) {
+
+    // SETS DEFAULT LOG LEVEL BEFORE STARTING A NEW RUN
+    av_log_set_level(configuredLogLevel);
+
+    // REGISTER THE ID BEFORE STARTING THE SESSION
+    globalSessionId = sessionId;
+    registerSessionId(sessionId);
+
+    resetMessagesInTransmit(sessionId);
+
+    // RUN
+    int ret = ffmpegkit::MediaInformationProbe::probe(
+        path, sessionId, probeOptions, mediaInformation);
+
+    // USE THE SAME RETURN CODES AS FFPROBE
+    int returnCode = 0;
+    if (ret < 0) {
+        returnCode = cancelRequested(sessionId) ? ffmpegkit::ReturnCode::Cancel
+                                                : 1;
+    }
+
+    // ALWAYS REMOVE THE ID FROM THE MAP
+    removeSession(sessionId);
+
+    return returnCode;
+}
+
+extern std::list<std::string>
+defaultGetMediaInformationCommandArguments(const std::string &path);
+
+/**
+ * Returns whether the arguments are the ones FFprobeKit uses to get media
+ * information, which are the only ones whose output is cached.
+ */
+static bool defaultMediaInformationPath(
+    const std::shared_ptr<std::list<std::string>> arguments,
+    std::string &path) {
+    if (arguments == nullptr || arguments->empty() ||
+        *arguments != defaultGetMediaInformationCommandArguments(
+                          arguments->back())) {
+        return false;
+    }
+    path = arguments->back();
+    return true;
+}
+
+static bool completeFromCache(
+    const std::shared_ptr<ffmpegkit::MediaInformationSession>
+        mediaInformationSession,
+    const std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation) {
+    if (mediaInformation == nullptr) {
+        return false;
+    }
+
+    mediaInformationSession->setMediaInformation(mediaInformation);
+    mediaInformationSession->complete(std::make_shared<ffmpegkit::ReturnCode>(
+        ffmpegkit::ReturnCode::Success));
+    return true;
+}
+
+static std::shared_ptr<MemoryIO> memoryIOFind(int id) {
+    std::unique_lock<std::mutex> lock(memoryIOMutex);
+
+    auto it = memoryIOMap.find(id);
+    if (it == memoryIOMap.end()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+static int memory_io_open(int id, int flags) {
+    std::shared_ptr<MemoryIO> memoryIO = memoryIOFind(id);
+    if (memoryIO == nullptr) {
+        return AVERROR(ENOENT);
+    }
+    if (((flags & AVIO_FLAG_READ) && memoryIO->readCallback == nullptr) ||
+        ((flags & AVIO_FLAG_WRITE) && memoryIO->writeCallback == nullptr)) {
+        return AVERROR(EACCES);
+    }
+
+    if (memoryIO->openCallback != nullptr) {
+        memoryIO->openCallback(flags);
+    }
+
+    return memoryIO->seekCallback != nullptr;
+}
+
+static int memory_io_read(int id, uint8_t *buffer, int size) {
+    std::shared_ptr<MemoryIO> memoryIO = memoryIOFind(id);
+    if (memoryIO == nullptr) {
+        return AVERROR(EBADF);
+    }
+
+    return memoryIO->readCallback(buffer, size);
+}
+
+static int memory_io_write(int id, const uint8_t *buffer, int size) {
+    std::shared_ptr<MemoryIO> memoryIO = memoryIOFind(id);
+    if (memoryIO == nullptr) {
+        return AVERROR(EBADF);
+    }
+
+    return memoryIO->writeCallback(buffer, size);
+}
+
+static int64_t memory_io_seek(int id, int64_t offset, int whence) {
+    std::shared_ptr<MemoryIO> memoryIO = memoryIOFind(id);
+    if (memoryIO == nullptr) {
+        return AVERROR(EBADF);
+    }
+    if (memoryIO->seekCallback == nullptr) {
+        return AVERROR(ESPIPE);
+    }
+
+    return memoryIO->seekCallback(offset, whence);
+}
+
+static int64_t memory_buffer_seek(size_t &position, size_t size,
+                                  int64_t offset, int whence) {
+    int64_t newPosition;
+
+    switch (whence) {
+    case AVSEEK_SIZE:
+        return size;
+    case SEEK_SET:
+        newPosition = offset;
+        break;
+    case SEEK_CUR:
+        newPosition = position + offset;
+        break;
+    case SEEK_END:
+        newPosition = size + offset;
+        break;
+    default:
+        return AVERROR(EINVAL);
+    }
+
+    if (newPosition < 0) {
+        return AVERROR(EINVAL);
+    }
+
+    position = newPosition;
+    return newPosition;
+}
+
+static std::string memoryIORegister(std::shared_ptr<MemoryIO> memoryIO) {
+    int id = memoryIOIdGenerator++;
+
+    std::unique_lock<std::mutex> lock(memoryIOMutex);
+    memoryIOMap[id] = memoryIO;
+
+    return "memory:" + std::to_string(id);
+}
+
 void *ffmpegKitInitialize() {
     std::call_once(ffmpegKitInitializerFlag, []() {
         std::cout << "Loading ffmpeg-kit." << std::endl;
@@ -819,6 +1066,11 @@ void *ffmpegKitInitialize() {
 
         redirectionEnabled = 0;
 
+        av_set_memory_open(memory_io_open);
+        av_set_memory_read(memory_io_read);
+        av_set_memory_write(memory_io_write);
+        av_set_memory_seek(memory_io_seek);
+
         ffmpegkit::FFmpegKitConfig::enableRedirection();
 
         std::cout << "Loaded ffmpeg-kit-"
@@ -856,6 +1108,8 @@ void ffmpegkit::FFmpegKitConfig::enableRedirection() {
 
     av_log_set_callback(ffmpegkit_log_callback_function);
     set_report_callback(ffmpegkit_statistics_callback_function);
+    set_input_stats_callback(ffmpegkit_input_statistics_callback_function);
+    set_output_stats_callback(ffmpegkit_output_statistics_callback_function);
 }
 
 void ffmpegkit::FFmpegKitConfig::disableRedirection() {
@@ -878,6 +1132,8 @@ void ffmpegkit::FFmpegKitConfig::disableRedirection() {
 
     av_log_set_callback(av_log_default_callback);
     set_report_callback(NULL);
+    set_input_stats_callback(NULL);
+    set_output_stats_callback(NULL);
 }
 
 int ffmpegkit::FFmpegKitConfig::setFontconfigConfigurationPath(
@@ -1032,6 +1288,236 @@ void ffmpegkit::FFmpegKitConfig::closeFFmpegPipe(
     std::remove(ffmpegPipePath.c_str());
 }
 
+std::shared_ptr<std::string>
+ffmpegkit::FFmpegKitConfig::registerNewFFmpegFdPipe(const bool input,
+                                                    const int pipeSize,
+                                                    int *callerFd) {
+    int fds[2];
+
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        std::cout << "Failed to register new FFmpeg fd pipe. Operation failed "
+                     "with errno="
+                  << errno << "." << std::endl;
+        return nullptr;
+    }
+
+    if (pipeSize > 0) {
+        // LARGER PIPES MEAN FEWER WAKEUPS, THE KERNEL ROUNDS THE SIZE UP
+        if (fcntl(fds[0], F_SETPIPE_SZ, pipeSize) < 0) {
+            std::cout << "Failed to set FFmpeg fd pipe size to " << pipeSize
+                      << ". Operation failed with errno=" << errno << "."
+                      << std::endl;
+        }
+    }
+
+    // FFMPEG READS FROM THE READ END OF INPUT PIPES
+    int ffmpegFd = input ? fds[0] : fds[1];
+    *callerFd = input ? fds[1] : fds[0];
+
+    return std::make_shared<std::string>("pipe:" + std::to_string(ffmpegFd));
+}
+
+void ffmpegkit::FFmpegKitConfig::closeFFmpegFdPipe(
+    const std::string &ffmpegPipeUrl) {
+    const char *fd;
+    char *end;
+
+    // ONLY URLS CREATED BY registerNewFFmpegFdPipe ARE ACCEPTED
+    if (!av_strstart(ffmpegPipeUrl.c_str(), "pipe:", &fd) || *fd == '\0') {
+        std::cout << "Invalid FFmpeg fd pipe url " << ffmpegPipeUrl << "."
+                  << std::endl;
+        return;
+    }
+
+    errno = 0;
+    long value = strtol(fd, &end, 10);
+    if (errno != 0 || *end != '\0' || value < 0 || value > INT_MAX) {
+        std::cout << "Invalid FFmpeg fd pipe url " << ffmpegPipeUrl << "."
+                  << std::endl;
+        return;
+    }
+
+    close((int)value);
+}
+
+int64_t ffmpegkit::FFmpegKitConfig::spliceFFmpegPipe(const int inputFd,
+                                                     const int outputFd,
+                                                     const int64_t length) {
+    int64_t total = 0;
+
+    while (length == 0 || total < length) {
+        size_t chunk = length == 0 ? (1 << 20) : (length - total);
+        ssize_t rc = splice(inputFd, NULL, outputFd, NULL, chunk,
+                            SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (rc == 0) {
+            break;
+        }
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return total > 0 ? total : -errno;
+        }
+        total += rc;
+    }
+
+    return total;
+}
+
+int64_t ffmpegkit::FFmpegKitConfig::vmspliceFFmpegPipe(const int pipeFd,
+                                                       const void *data,
+                                                       const size_t size) {
+    struct iovec iov;
+    size_t total = 0;
+
+    while (total < size) {
+        iov.iov_base = (uint8_t *)data + total;
+        iov.iov_len = size - total;
+
+        ssize_t rc = vmsplice(pipeFd, &iov, 1, 0);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return total > 0 ? total : -errno;
+        }
+        total += rc;
+    }
+
+    return total;
+}
+
+std::string ffmpegkit::FFmpegKitConfig::registerMemoryIO(
+    const MemoryReadCallback readCallback,
+    const MemoryWriteCallback writeCallback,
+    const MemorySeekCallback seekCallback) {
+    std::shared_ptr<MemoryIO> memoryIO = std::make_shared<MemoryIO>();
+    memoryIO->readCallback = readCallback;
+    memoryIO->writeCallback = writeCallback;
+    memoryIO->seekCallback = seekCallback;
+
+    return memoryIORegister(memoryIO);
+}
+
+std::string ffmpegkit::FFmpegKitConfig::registerMemoryInput(const void *data,
+                                                            size_t size) {
+    std::shared_ptr<MemoryIO> memoryIO = std::make_shared<MemoryIO>();
+    auto position = std::make_shared<size_t>(0);
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    memoryIO->readCallback = [bytes, size, position](uint8_t *buffer,
+                                                     int bufferSize) {
+        if (*position >= size) {
+            return 0;
+        }
+        int count = std::min<size_t>(bufferSize, size - *position);
+        memcpy(buffer, bytes + *position, count);
+        *position += count;
+        return count;
+    };
+    memoryIO->seekCallback = [size, position](int64_t offset, int whence) {
+        return memory_buffer_seek(*position, size, offset, whence);
+    };
+    memoryIO->openCallback = [position](int flags) { *position = 0; };
+
+    return memoryIORegister(memoryIO);
+}
+
+std::string ffmpegkit::FFmpegKitConfig::registerMemoryOutput(
+    std::shared_ptr<std::vector<uint8_t>> buffer) {
+    std::shared_ptr<MemoryIO> memoryIO = std::make_shared<MemoryIO>();
+    auto position = std::make_shared<size_t>(0);
+
+    // READING IS NEEDED BY MUXERS THAT REOPEN THEIR OUTPUT, LIKE MP4 FASTSTART
+    memoryIO->readCallback = [buffer, position](uint8_t *data, int size) {
+        if (*position >= buffer->size()) {
+            return 0;
+        }
+        int count = std::min<size_t>(size, buffer->size() - *position);
+        memcpy(data, buffer->data() + *position, count);
+        *position += count;
+        return count;
+    };
+    memoryIO->writeCallback = [buffer, position](const uint8_t *data,
+                                                 int size) {
+        if (*position + size > buffer->size()) {
+            buffer->resize(*position + size);
+        }
+        memcpy(buffer->data() + *position, data, size);
+        *position += size;
+        return size;
+    };
+    memoryIO->seekCallback = [buffer, position](int64_t offset, int whence) {
+        return memory_buffer_seek(*position, buffer->size(), offset, whence);
+    };
+    memoryIO->openCallback = [buffer, position](int flags) {
+        *position = 0;
+
+        // OPENING FOR WRITING ONLY TRUNCATES, LIKE A FILE
+        if (!(flags & AVIO_FLAG_READ)) {
+            buffer->clear();
+        }
+    };
+
+    return memoryIORegister(memoryIO);
+}
+
+void ffmpegkit::FFmpegKitConfig::closeMemoryIO(const std::string &memoryUrl) {
+    const char *id = memoryUrl.c_str();
+    av_strstart(id, "memory:", &id);
+
+    std::unique_lock<std::mutex> lock(memoryIOMutex);
+    memoryIOMap.erase(atoi(id));
+}
+
+void ffmpegkit::FFmpegKitConfig::setBlockCacheSize(const int64_t size) {
+    av_blockcache_set_size(size);
+}
+
+std::shared_ptr<ffmpegkit::BlockCacheStatistics>
+ffmpegkit::FFmpegKitConfig::getBlockCacheStatistics() {
+    int64_t hits, misses, evictions, size, maxSize;
+
+    av_blockcache_get_stats(&hits, &misses, &evictions, &size, &maxSize);
+
+    return std::make_shared<ffmpegkit::BlockCacheStatistics>(
+        hits, misses, evictions, size, maxSize);
+}
+
+bool ffmpegkit::FFmpegKitConfig::enableMediaInformationCache(
+    const std::string &path, const int64_t maxSize) {
+    auto cache = ffmpegkit::MediaInformationCache::open(path, maxSize);
+    if (cache != nullptr) {
+        std::atomic_store(&mediaInformationCache, cache);
+    }
+    return cache != nullptr;
+}
+
+void ffmpegkit::FFmpegKitConfig::disableMediaInformationCache() {
+    std::atomic_store(&mediaInformationCache,
+                      std::shared_ptr<ffmpegkit::MediaInformationCache>());
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationCache>
+ffmpegkit::FFmpegKitConfig::getMediaInformationCache() {
+    return std::atomic_load(&mediaInformationCache);
+}
+
+void ffmpegkit::FFmpegKitConfig::invalidateMediaInformationCache(
+    const std::string &mediaPath) {
+    auto cache = std::atomic_load(&mediaInformationCache);
+    if (cache != nullptr) {
+        cache->invalidate(mediaPath);
+    }
+}
+
+void ffmpegkit::FFmpegKitConfig::clearMediaInformationCache() {
+    auto cache = std::atomic_load(&mediaInformationCache);
+    if (cache != nullptr) {
+        cache->clear();
+    }
+}
+
 std::string ffmpegkit::FFmpegKitConfig::getFFmpegVersion() {
     return FFMPEG_VERSION;
 }
@@ -1081,6 +1567,10 @@ void ffmpegkit::FFmpegKitConfig::ffmpegExecute(
     const std::shared_ptr<ffmpegkit::FFmpegSession> ffmpegSession) {
     ffmpegSession->startRunning();
 
+    // INPUTS AND OUTPUTS ARE OPENED ON THIS THREAD
+    set_file_cache_policy(ffmpegSession->getFileFadvise(),
+                          ffmpegSession->getFileDirect());
+
     try {
         int returnCode = executeFFmpeg(ffmpegSession->getSessionId(),
                                        ffmpegSession->getArguments());
@@ -1113,12 +1603,86 @@ void ffmpegkit::FFmpegKitConfig::ffprobeExecute(
     }
 }
 
+static void recordSinkFunction(void *opaque, const FFprobeRecord *records,
+                               int nbRecords) {
+    RecordSink *sink = static_cast<RecordSink *>(opaque);
+
+    sink->records.resize(nbRecords);
+    for (int i = 0; i < nbRecords; i++) {
+        const FFprobeRecord &record = records[i];
+        ffmpegkit::MediaRecord &mediaRecord = sink->records[i];
+
+        mediaRecord.type = record.type == FFPROBE_RECORD_PACKET
+                               ? ffmpegkit::MediaRecord::Packet
+                               : ffmpegkit::MediaRecord::Frame;
+        mediaRecord.streamIndex = record.stream_index;
+        mediaRecord.timeBaseNum = record.time_base_num;
+        mediaRecord.timeBaseDen = record.time_base_den;
+        mediaRecord.pts = record.pts;
+        mediaRecord.dts = record.dts;
+        mediaRecord.duration = record.duration;
+        mediaRecord.pos = record.pos;
+        mediaRecord.size = record.size;
+        mediaRecord.flags = record.flags;
+        mediaRecord.key = record.type == FFPROBE_RECORD_PACKET
+                              ? (record.flags & AV_PKT_FLAG_KEY) != 0
+                              : (record.flags & AV_FRAME_FLAG_KEY) != 0;
+        mediaRecord.pictType = record.pict_type;
+    }
+
+    // EXCEPTIONS MUST NOT PROPAGATE THROUGH FFPROBE
+    try {
+        sink->callback(sink->records);
+    } catch (const std::exception &exception) {
+        std::cout << "Exception thrown inside record callback. "
+                  << exception.what() << std::endl;
+    }
+}
+
+void ffmpegkit::FFmpegKitConfig::ffprobeRecordsExecute(
+    const std::shared_ptr<ffmpegkit::FFprobeSession> ffprobeSession,
+    const ffmpegkit::MediaRecordCallback recordCallback) {
+    RecordSink sink;
+
+    sink.callback = recordCallback;
+    sink.records.reserve(FFPROBE_RECORD_BATCH_SIZE);
+
+    set_ffprobe_record_callback(recordSinkFunction, &sink);
+    ffprobeExecute(ffprobeSession);
+    set_ffprobe_record_callback(NULL, NULL);
+}
+
 void ffmpegkit::FFmpegKitConfig::getMediaInformationExecute(
     const std::shared_ptr<ffmpegkit::MediaInformationSession>
         mediaInformationSession,
     const int waitTimeout) {
+    std::string path;
+    auto cache = std::atomic_load(&mediaInformationCache);
+    if (cache != nullptr &&
+        !defaultMediaInformationPath(mediaInformationSession->getArguments(),
+                                     path)) {
+        cache = nullptr;
+    }
+
     mediaInformationSession->startRunning();
 
+    // TAKEN BEFORE THE PROBE, A FILE MODIFIED DURING IT IS NOT CACHED
+    std::shared_ptr<ffmpegkit::MediaInformationCache::FileVersion> version;
+    if (cache != nullptr) {
+        version = ffmpegkit::MediaInformationCache::getFileVersion(path);
+    }
+
+    // THE OUTPUT IS PARSED AGAIN, SO ALL KEYS ARE AVAILABLE AS AFTER A NEW RUN
+    if (cache != nullptr) {
+        auto ffprobeJsonOutput = cache->getFFprobeOutput(path);
+        if (ffprobeJsonOutput != nullptr &&
+            completeFromCache(mediaInformationSession,
+                              ffmpegkit::MediaInformationJsonParser::from(
+                                  ffprobeJsonOutput->c_str()))) {
+            return;
+        }
+    }
+
     try {
         int returnCodeValue =
             executeFFprobe(mediaInformationSession->getSessionId(),
@@ -1140,6 +1704,9 @@ void ffmpegkit::FFmpegKitConfig::getMediaInformationExecute(
                 ffmpegkit::MediaInformationJsonParser::fromWithError(
                     ffprobeJsonOutput.c_str());
             mediaInformationSession->setMediaInformation(mediaInformation);
+            if (cache != nullptr) {
+                cache->putFFprobeOutput(version, ffprobeJsonOutput);
+            }
         }
     } catch (const std::exception &exception) {
         mediaInformationSession->fail(exception.what());
@@ -1150,6 +1717,47 @@ void ffmpegkit::FFmpegKitConfig::getMediaInformationExecute(
     }
 }
 
+void ffmpegkit::FFmpegKitConfig::nativeGetMediaInformationExecute(
+    const std::shared_ptr<ffmpegkit::MediaInformationSession>
+        mediaInformationSession,
+    const std::string &path,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions) {
+    auto cache = std::atomic_load(&mediaInformationCache);
+
+    mediaInformationSession->startRunning();
+
+    // TAKEN BEFORE THE PROBE, A FILE MODIFIED DURING IT IS NOT CACHED
+    std::shared_ptr<ffmpegkit::MediaInformationCache::FileVersion> version;
+    if (cache != nullptr) {
+        version = ffmpegkit::MediaInformationCache::getFileVersion(path);
+    }
+
+    if (cache != nullptr &&
+        completeFromCache(mediaInformationSession, cache->get(path))) {
+        return;
+    }
+
+    try {
+        std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation;
+        int returnCodeValue =
+            executeNativeProbe(mediaInformationSession->getSessionId(), path,
+                               probeOptions, mediaInformation);
+        auto returnCode =
+            std::make_shared<ffmpegkit::ReturnCode>(returnCodeValue);
+        mediaInformationSession->complete(returnCode);
+        if (returnCode->isValueSuccess()) {
+            mediaInformationSession->setMediaInformation(mediaInformation);
+            if (cache != nullptr) {
+                cache->put(version, mediaInformation);
+            }
+        }
+    } catch (const std::exception &exception) {
+        mediaInformationSession->fail(exception.what());
+        std::cout << "Native get media information execute failed: " << path
+                  << "." << exception.what() << std::endl;
+    }
+}
+
 void ffmpegkit::FFmpegKitConfig::asyncFFmpegExecute(
     const std::shared_ptr<ffmpegkit::FFmpegSession> ffmpegSession) {
     auto thread = std::thread([ffmpegSession]() {
@@ -1262,6 +1870,47 @@ void ffmpegkit::FFmpegKitConfig::asyncGetMediaInformationExecute(
     thread.detach();
 }
 
+void ffmpegkit::FFmpegKitConfig::asyncNativeGetMediaInformationExecute(
+    const std::shared_ptr<ffmpegkit::MediaInformationSession>
+        mediaInformationSession,
+    const std::string &path,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions) {
+    auto thread = std::thread([mediaInformationSession, path, probeOptions]() {
+        ffmpegkit::FFmpegKitConfig::nativeGetMediaInformationExecute(
+            mediaInformationSession, path, probeOptions);
+
+        ffmpegkit::MediaInformationSessionCompleteCallback completeCallback =
+            mediaInformationSession->getCompleteCallback();
+        if (completeCallback != nullptr) {
+            try {
+                // NOTIFY SESSION CALLBACK DEFINED
+                completeCallback(mediaInformationSession);
+            } catch (const std::exception &exception) {
+                std::cout
+                    << "Exception thrown inside session complete callback. "
+                    << exception.what() << std::endl;
+            }
+        }
+
+        ffmpegkit::MediaInformationSessionCompleteCallback
+            globalMediaInformationSessionCompleteCallback = ffmpegkit::
+                FFmpegKitConfig::getMediaInformationSessionCompleteCallback();
+        if (globalMediaInformationSessionCompleteCallback != nullptr) {
+            try {
+                // NOTIFY SESSION CALLBACK DEFINED
+                globalMediaInformationSessionCompleteCallback(
+                    mediaInformationSession);
+            } catch (const std::exception &exception) {
+                std::cout
+                    << "Exception thrown inside global complete callback. "
+                    << exception.what() << std::endl;
+            }
+        }
+    });
+
+    thread.detach();
+}
+
 void ffmpegkit::FFmpegKitConfig::enableLogCallback(
     const ffmpegkit::LogCallback callback) {
     logCallback = callback;
@@ -20,17 +20,23 @@
 #ifndef FFMPEG_KIT_CONFIG_H
 #define FFMPEG_KIT_CONFIG_H
 
+#include "BlockCacheStatistics.h"
 #include "FFmpegSession.h"
 #include "FFprobeSession.h"
 #include "Level.h"
 #include "LogCallback.h"
+#include "MediaInformationCache.h"
+#include "MediaInformationProbeOptions.h"
 #include "MediaInformationSession.h"
+#include "MediaRecordCallback.h"
+#include "MemoryIOCallback.h"
 #include "Signal.h"
 #include "StatisticsCallback.h"
 #include <map>
 #include <pthread.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <vector>
 
 namespace ffmpegkit {
 
@@ -130,6 +136,172 @@ class FFmpegKitConfig {
      */
     static void closeFFmpegPipe(const std::string &ffmpegPipePath);
 
+    /**
+     * <p>Creates a new anonymous pipe to use in <code>FFmpeg</code>
+     * operations, without a named pipe on the filesystem.
+     *
+     * <p>The returned url, <code>pipe:&lt;fd&gt;</code>, refers to the end of
+     * the pipe used by <code>FFmpeg</code>, the other end is returned in
+     * <code>callerFd</code>. Caller must close its end to signal the end of
+     * an input, and close the <code>FFmpeg</code> end with
+     * closeFFmpegFdPipe after the session completes.
+     *
+     * @param input    true if <code>FFmpeg</code> reads from the pipe, false
+     * if it writes to it
+     * @param pipeSize requested pipe capacity in bytes, it is capped by
+     * /proc/sys/fs/pipe-max-size; zero keeps the default capacity
+     * @param callerFd receives the end of the pipe used by the caller
+     * @return the url of the pipe or nullptr if the pipe can not be created
+     */
+    static std::shared_ptr<std::string>
+    registerNewFFmpegFdPipe(const bool input, const int pipeSize,
+                            int *callerFd);
+
+    /**
+     * <p>Closes the <code>FFmpeg</code> end of a pipe created by
+     * registerNewFFmpegFdPipe.
+     *
+     * @param ffmpegPipeUrl url of the pipe
+     */
+    static void closeFFmpegFdPipe(const std::string &ffmpegPipeUrl);
+
+    /**
+     * <p>Moves data between a file descriptor and a pipe with
+     * <code>splice()</code>, so that data forwarded from a socket or a file
+     * to <code>FFmpeg</code>, or from <code>FFmpeg</code> to them, is not
+     * copied through user space. One of the descriptors must be a pipe.
+     *
+     * @param inputFd  descriptor to read from
+     * @param outputFd descriptor to write to
+     * @param length   number of bytes to move, zero to move until the end of
+     * the input
+     * @return number of bytes moved or a negative errno value on failure
+     */
+    static int64_t spliceFFmpegPipe(const int inputFd, const int outputFd,
+                                    const int64_t length);
+
+    /**
+     * <p>Writes a memory buffer into a pipe with <code>vmsplice()</code>.
+     * The pages of the buffer are referenced by the pipe, so the buffer must
+     * not be modified until <code>FFmpeg</code> has read the data.
+     *
+     * @param pipeFd pipe descriptor to write to
+     * @param data   buffer to write
+     * @param size   size of the buffer in bytes
+     * @return number of bytes written or a negative errno value on failure
+     */
+    static int64_t vmspliceFFmpegPipe(const int pipeFd, const void *data,
+                                      const size_t size);
+
+    /**
+     * <p>Creates a new <code>memory:</code> url served by the given callbacks,
+     * to use as an input or output in <code>FFmpeg</code> operations. Data is
+     * passed to the callbacks in-process, without a named pipe or a temporary
+     * file.
+     *
+     * <p>Callbacks are invoked from the session thread. An extension can be
+     * appended to the returned url, e.g. <code>memory:1.mp4</code>, to help
+     * format detection. Please note that creator is responsible of closing
+     * created urls.
+     *
+     * @param readCallback  read callback or nullptr for write only urls
+     * @param writeCallback write callback or nullptr for read only urls
+     * @param seekCallback  seek callback or nullptr for non-seekable urls
+     * @return the memory url
+     */
+    static std::string
+    registerMemoryIO(const MemoryReadCallback readCallback,
+                     const MemoryWriteCallback writeCallback,
+                     const MemorySeekCallback seekCallback);
+
+    /**
+     * <p>Creates a new seekable <code>memory:</code> url that reads the given
+     * buffer. The buffer is not copied and must stay valid until the url is
+     * closed.
+     *
+     * @param data buffer to read
+     * @param size size of the buffer in bytes
+     * @return the memory url
+     */
+    static std::string registerMemoryInput(const void *data, size_t size);
+
+    /**
+     * <p>Creates a new seekable <code>memory:</code> url that writes into the
+     * given buffer, so that formats which rewrite their header at the end,
+     * like MP4, can be created in memory. The buffer is resized as needed and
+     * must not be accessed while a session is writing to it.
+     *
+     * @param buffer output buffer
+     * @return the memory url
+     */
+    static std::string
+    registerMemoryOutput(std::shared_ptr<std::vector<uint8_t>> buffer);
+
+    /**
+     * <p>Closes a previously created <code>memory:</code> url.
+     *
+     * @param memoryUrl memory url
+     */
+    static void closeMemoryIO(const std::string &memoryUrl);
+
+    /**
+     * <p>Sets the memory limit of the block cache used by
+     * <code>blockcache:</code> urls. The cache is shared by all sessions, so
+     * sessions reading the same file read each block from disk only once
+     * while it stays cached. Blocks are dropped in least recently used order.
+     *
+     * @param size memory limit in bytes, zero disables caching
+     */
+    static void setBlockCacheSize(const int64_t size);
+
+    /**
+     * <p>Returns the current counters of the block cache.
+     *
+     * @return block cache statistics
+     */
+    static std::shared_ptr<ffmpegkit::BlockCacheStatistics>
+    getBlockCacheStatistics();
+
+    /**
+     * <p>Enables the persistent media information cache stored in the file at
+     * path. Media information requests for local files with the default
+     * arguments are served from the cache while the files are unchanged.
+     * Results of FFprobe and of the in-process probe are cached separately.
+     * Several processes can use the same cache file.
+     *
+     * @param path    path of the cache file
+     * @param maxSize size of the cache file in bytes, used only when the file
+     * is created
+     * @return true if the cache file could be opened
+     */
+    static bool enableMediaInformationCache(const std::string &path,
+                                            const int64_t maxSize);
+
+    /**
+     * <p>Stops using the persistent media information cache.
+     */
+    static void disableMediaInformationCache();
+
+    /**
+     * <p>Returns the persistent media information cache.
+     *
+     * @return cache or nullptr if it is not enabled
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformationCache>
+    getMediaInformationCache();
+
+    /**
+     * <p>Removes the cached media information of the file at mediaPath.
+     *
+     * @param mediaPath path of a media file
+     */
+    static void invalidateMediaInformationCache(const std::string &mediaPath);
+
+    /**
+     * <p>Removes all cached media information.
+     */
+    static void clearMediaInformationCache();
+
     /**
      * <p>Returns the version of FFmpeg bundled within <code>FFmpegKit</code>
      * library.
@@ -195,6 +367,19 @@ class FFmpegKitConfig {
     static void ffprobeExecute(
         const std::shared_ptr<ffmpegkit::FFprobeSession> ffprobeSession);
 
+    /**
+     * <p>Synchronously executes the FFprobe session provided, delivering the
+     * packets and frames selected with -show_packets and -show_frames to
+     * recordCallback instead of printing them.
+     *
+     * @param ffprobeSession FFprobe session which includes command
+     * options/arguments
+     * @param recordCallback callback that receives the records in batches
+     */
+    static void ffprobeRecordsExecute(
+        const std::shared_ptr<ffmpegkit::FFprobeSession> ffprobeSession,
+        const ffmpegkit::MediaRecordCallback recordCallback);
+
     /**
      * <p>Synchronously executes the media information session provided.
      *
@@ -253,6 +438,39 @@ class FFmpegKitConfig {
             mediaInformationSession,
         int waitTimeout);
 
+    /**
+     * <p>Synchronously extracts media information in-process for the given
+     * media information session, without running FFprobe.
+     *
+     * @param mediaInformationSession media information session
+     * @param path                    path or uri of a media file
+     * @param probeOptions            probe options
+     */
+    static void nativeGetMediaInformationExecute(
+        const std::shared_ptr<ffmpegkit::MediaInformationSession>
+            mediaInformationSession,
+        const std::string &path,
+        const ffmpegkit::MediaInformationProbeOptions &probeOptions);
+
+    /**
+     * <p>Starts an asynchronous in-process media information extraction for
+     * the given media information session.
+     *
+     * <p>Note that this method returns immediately and does not wait the
+     * execution to complete. You must use an
+     * MediaInformationSessionCompleteCallback if you want to be notified about
+     * the result.
+     *
+     * @param mediaInformationSession media information session
+     * @param path                    path or uri of a media file
+     * @param probeOptions            probe options
+     */
+    static void asyncNativeGetMediaInformationExecute(
+        const std::shared_ptr<ffmpegkit::MediaInformationSession>
+            mediaInformationSession,
+        const std::string &path,
+        const ffmpegkit::MediaInformationProbeOptions &probeOptions);
+
     /**
      * <p>Sets a global log callback to redirect FFmpeg/FFprobe logs.
      *
@@ -99,7 +99,12 @@ ffmpegkit::FFmpegSession::FFmpegSession(
       _completeCallback{completeCallback},
       _statisticsCallback{statisticsCallback},
       _statistics{std::make_shared<
-          std::list<std::shared_ptr<ffmpegkit::Statistics>>>()} {}
+          std::list<std::shared_ptr<ffmpegkit::Statistics>>>()},
+      _inputStatistics{std::make_shared<
+          std::list<std::shared_ptr<ffmpegkit::InputStatistics>>>()},
+      _outputStatistics{std::make_shared<
+          std::list<std::shared_ptr<ffmpegkit::OutputStatistics>>>()},
+      _fileFadvise{false}, _fileDirect{false} {}
 
 ffmpegkit::StatisticsCallback
 ffmpegkit::FFmpegSession::getStatisticsCallback() {
@@ -151,6 +156,58 @@ void ffmpegkit::FFmpegSession::addStatistics(
     _statistics->push_back(statistics);
 }
 
+std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::InputStatistics>>>
+ffmpegkit::FFmpegSession::getInputStatistics() {
+    return _inputStatistics;
+}
+
+void ffmpegkit::FFmpegSession::addInputStatistics(
+    const std::shared_ptr<ffmpegkit::InputStatistics> inputStatistics) {
+    _inputStatistics->push_back(inputStatistics);
+}
+
+std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::OutputStatistics>>>
+ffmpegkit::FFmpegSession::getOutputStatistics() {
+    return _outputStatistics;
+}
+
+void ffmpegkit::FFmpegSession::addOutputStatistics(
+    const std::shared_ptr<ffmpegkit::OutputStatistics> outputStatistics) {
+    _outputStatistics->push_back(outputStatistics);
+}
+
+uint64_t ffmpegkit::FFmpegSession::getBytesRead() {
+    uint64_t bytesRead = 0;
+
+    for (auto &inputStatistics : *_inputStatistics) {
+        bytesRead += inputStatistics->getBytesRead();
+    }
+
+    return bytesRead;
+}
+
+uint64_t ffmpegkit::FFmpegSession::getBytesWritten() {
+    uint64_t bytesWritten = 0;
+
+    for (auto &outputStatistics : *_outputStatistics) {
+        bytesWritten += outputStatistics->getBytesWritten();
+    }
+
+    return bytesWritten;
+}
+
+void ffmpegkit::FFmpegSession::setFileFadvise(const bool fadvise) {
+    _fileFadvise = fadvise;
+}
+
+bool ffmpegkit::FFmpegSession::getFileFadvise() { return _fileFadvise; }
+
+void ffmpegkit::FFmpegSession::setFileDirect(const bool direct) {
+    _fileDirect = direct;
+}
+
+bool ffmpegkit::FFmpegSession::getFileDirect() { return _fileDirect; }
+
 bool ffmpegkit::FFmpegSession::isFFmpeg() const { return true; }
 
 bool ffmpegkit::FFmpegSession::isFFprobe() const { return false; }
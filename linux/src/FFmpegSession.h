@@ -22,6 +22,8 @@
 
 #include "AbstractSession.h"
 #include "FFmpegSessionCompleteCallback.h"
+#include "InputStatistics.h"
+#include "OutputStatistics.h"
 #include "StatisticsCallback.h"
 
 namespace ffmpegkit {
@@ -146,6 +148,99 @@ class FFmpegSession : public AbstractSession {
      */
     void addStatistics(const std::shared_ptr<ffmpegkit::Statistics> statistics);
 
+    /**
+     * Returns demuxing statistics of the input files closed so far. There is
+     * one entry for each input that was read, delivered when the input is
+     * closed, so the list is complete once the session has finished.
+     *
+     * @return list of input statistics entries generated for this session
+     */
+    std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::InputStatistics>>>
+    getInputStatistics();
+
+    /**
+     * Adds a new input statistics entry for this session. It is invoked
+     * internally by <code>FFmpegKit</code> library methods. Must not be used by
+     * user applications.
+     *
+     * @param inputStatistics input statistics entry
+     */
+    void addInputStatistics(
+        const std::shared_ptr<ffmpegkit::InputStatistics> inputStatistics);
+
+    /**
+     * Returns muxing statistics of the output files completed so far. There is
+     * one entry for each output whose trailer was written, so the list is
+     * complete once the session has finished.
+     *
+     * @return list of output statistics entries generated for this session
+     */
+    std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::OutputStatistics>>>
+    getOutputStatistics();
+
+    /**
+     * Adds a new output statistics entry for this session. It is invoked
+     * internally by <code>FFmpegKit</code> library methods. Must not be used
+     * by user applications.
+     *
+     * @param outputStatistics output statistics entry
+     */
+    void addOutputStatistics(
+        const std::shared_ptr<ffmpegkit::OutputStatistics> outputStatistics);
+
+    /**
+     * Returns the total number of bytes read from the inputs of this session.
+     *
+     * @return sum of the bytes read of all input statistics entries
+     */
+    uint64_t getBytesRead();
+
+    /**
+     * Returns the total number of bytes written to the outputs of this
+     * session.
+     *
+     * @return sum of the bytes written of all output statistics entries
+     */
+    uint64_t getBytesWritten();
+
+    /**
+     * Sets whether the local files of this session are kept out of the page
+     * cache. Inputs opened with file: are read with POSIX_FADV_SEQUENTIAL and
+     * the data behind the read position is dropped. Outputs opened with file:
+     * are written back and dropped in 8 MiB windows. It is applied through the
+     * file_fadvise protocol option, a value given on the command line takes
+     * precedence. Must be set before the session is executed.
+     *
+     * @param fadvise true to keep the files out of the page cache
+     */
+    void setFileFadvise(const bool fadvise);
+
+    /**
+     * Returns whether the local files of this session are kept out of the
+     * page cache.
+     *
+     * @return true if the files are kept out of the page cache
+     */
+    bool getFileFadvise();
+
+    /**
+     * Sets whether the outputs of this session opened with file: are written
+     * with O_DIRECT. Writing falls back to the page cache at the first
+     * unaligned offset or size. It is applied through the file_direct
+     * protocol option, a value given on the command line takes precedence.
+     * Must be set before the session is executed.
+     *
+     * @param direct true to write the outputs with O_DIRECT
+     */
+    void setFileDirect(const bool direct);
+
+    /**
+     * Returns whether the outputs of this session are written with O_DIRECT.
+     *
+     * @return true if the outputs are written with O_DIRECT
+     */
+    bool getFileDirect();
+
     /**
      * Returns whether it is an <code>FFmpeg</code> session or not.
      *
@@ -190,6 +285,12 @@ class FFmpegSession : public AbstractSession {
     FFmpegSessionCompleteCallback _completeCallback;
     std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::Statistics>>>
         _statistics;
+    std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::InputStatistics>>>
+        _inputStatistics;
+    std::shared_ptr<std::list<std::shared_ptr<ffmpegkit::OutputStatistics>>>
+        _outputStatistics;
+    bool _fileFadvise;
+    bool _fileDirect;
 };
 
 } // namespace ffmpegkit
@@ -20,12 +20,20 @@
 #include "FFprobeKit.h"
 #include "FFmpegKit.h"
 #include "FFmpegKitConfig.h"
+#include "MediaInformationProbe.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+extern "C" {
+#include "libavutil/error.h"
+}
 
 extern void *ffmpegKitInitialize();
 
 const void *_ffprobeKitInitializer{ffmpegKitInitialize()};
 
-static std::list<std::string>
+std::list<std::string>
 defaultGetMediaInformationCommandArguments(const std::string &path) {
     return std::list<std::string>{"-v",
                                   "error",
@@ -39,6 +47,63 @@ defaultGetMediaInformationCommandArguments(const std::string &path) {
                                   path};
 }
 
+static std::shared_ptr<ffmpegkit::MediaInformationBatchResult>
+probeBatchEntry(const size_t index, const std::string &path,
+                const ffmpegkit::MediaInformationBatchOptions &options) {
+    if (!options.isUseFFprobe() && !options.isKeepSessionHistory()) {
+        auto cache = ffmpegkit::FFmpegKitConfig::getMediaInformationCache();
+        std::shared_ptr<ffmpegkit::MediaInformationCache::FileVersion> version;
+        std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation;
+        char error[AV_ERROR_MAX_STRING_SIZE] = {0};
+
+        if (cache != nullptr) {
+            version = ffmpegkit::MediaInformationCache::getFileVersion(path);
+            mediaInformation = cache->get(path);
+            if (mediaInformation != nullptr) {
+                return std::make_shared<
+                    ffmpegkit::MediaInformationBatchResult>(
+                    index, path, 0, error, mediaInformation, nullptr);
+            }
+        }
+
+        int ret = ffmpegkit::MediaInformationProbe::probe(
+            path, 0, options.getProbeOptions(), mediaInformation);
+        if (ret < 0) {
+            av_strerror(ret, error, sizeof(error));
+        } else if (cache != nullptr) {
+            cache->put(version, mediaInformation);
+        }
+
+        return std::make_shared<ffmpegkit::MediaInformationBatchResult>(
+            index, path, ret < 0 ? 1 : 0, error, mediaInformation, nullptr);
+    }
+
+    auto session = ffmpegkit::MediaInformationSession::create(
+        defaultGetMediaInformationCommandArguments(path));
+    if (options.isUseFFprobe()) {
+        ffmpegkit::FFmpegKitConfig::getMediaInformationExecute(
+            session, options.getWaitTimeout());
+    } else {
+        ffmpegkit::FFmpegKitConfig::nativeGetMediaInformationExecute(
+            session, path, options.getProbeOptions());
+    }
+
+    auto returnCode = session->getReturnCode();
+    auto mediaInformation = session->getMediaInformation();
+    int returnCodeValue = returnCode != nullptr ? returnCode->getValue() : 1;
+    std::string error;
+    if (returnCode == nullptr) {
+        error = session->getFailStackTrace();
+    } else if (!returnCode->isValueSuccess()) {
+        error = "Probe returned " + std::to_string(returnCodeValue);
+    } else if (mediaInformation == nullptr) {
+        error = "No media information found";
+    }
+
+    return std::make_shared<ffmpegkit::MediaInformationBatchResult>(
+        index, path, returnCodeValue, error, mediaInformation, session);
+}
+
 std::shared_ptr<ffmpegkit::FFprobeSession>
 ffmpegkit::FFprobeKit::executeWithArguments(
     const std::list<std::string> &arguments) {
@@ -95,6 +160,49 @@ std::shared_ptr<ffmpegkit::FFprobeSession> ffmpegkit::FFprobeKit::executeAsync(
     return session;
 }
 
+std::shared_ptr<ffmpegkit::FFprobeSession>
+ffmpegkit::FFprobeKit::executeWithArgumentsForRecords(
+    const std::list<std::string> &arguments,
+    MediaRecordCallback recordCallback) {
+    auto session = ffmpegkit::FFprobeSession::create(arguments);
+    ffmpegkit::FFmpegKitConfig::ffprobeRecordsExecute(session, recordCallback);
+    return session;
+}
+
+std::shared_ptr<ffmpegkit::FFprobeSession>
+ffmpegkit::FFprobeKit::getMediaRecords(const std::string path,
+                                       const bool packets, const bool frames,
+                                       MediaRecordCallback recordCallback) {
+    std::list<std::string> arguments{"-v", "error", "-hide_banner"};
+    if (packets) {
+        arguments.push_back("-show_packets");
+    }
+    if (frames) {
+        arguments.push_back("-show_frames");
+    }
+    arguments.push_back("-i");
+    arguments.push_back(path);
+    return executeWithArgumentsForRecords(arguments, recordCallback);
+}
+
+static std::list<std::string>
+buildSeekIndexCommandArguments(const std::string &path) {
+    return std::list<std::string>{"-v", "error", "-hide_banner",
+                                  "-write_seek_index", "-i", path};
+}
+
+std::shared_ptr<ffmpegkit::FFprobeSession>
+ffmpegkit::FFprobeKit::buildSeekIndex(const std::string path) {
+    return executeWithArguments(buildSeekIndexCommandArguments(path));
+}
+
+std::shared_ptr<ffmpegkit::FFprobeSession>
+ffmpegkit::FFprobeKit::buildSeekIndexAsync(
+    const std::string path, FFprobeSessionCompleteCallback completeCallback) {
+    return executeWithArgumentsAsync(buildSeekIndexCommandArguments(path),
+                                     completeCallback);
+}
+
 std::shared_ptr<ffmpegkit::MediaInformationSession>
 ffmpegkit::FFprobeKit::getMediaInformation(const std::string path) {
     auto arguments = defaultGetMediaInformationCommandArguments(path);
@@ -141,6 +249,93 @@ ffmpegkit::FFprobeKit::getMediaInformationAsync(
     return session;
 }
 
+std::shared_ptr<ffmpegkit::MediaInformationSession>
+ffmpegkit::FFprobeKit::getMediaInformationNative(const std::string path) {
+    return getMediaInformationNative(
+        path, ffmpegkit::MediaInformationProbeOptions());
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationSession>
+ffmpegkit::FFprobeKit::getMediaInformationNative(
+    const std::string path,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions) {
+    auto arguments = defaultGetMediaInformationCommandArguments(path);
+    auto session = ffmpegkit::MediaInformationSession::create(arguments);
+    ffmpegkit::FFmpegKitConfig::nativeGetMediaInformationExecute(session, path,
+                                                                 probeOptions);
+    return session;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationSession>
+ffmpegkit::FFprobeKit::getMediaInformationNativeAsync(
+    const std::string path,
+    MediaInformationSessionCompleteCallback completeCallback) {
+    return getMediaInformationNativeAsync(
+        path, ffmpegkit::MediaInformationProbeOptions(), completeCallback);
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationSession>
+ffmpegkit::FFprobeKit::getMediaInformationNativeAsync(
+    const std::string path,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions,
+    MediaInformationSessionCompleteCallback completeCallback) {
+    auto arguments = defaultGetMediaInformationCommandArguments(path);
+    auto session =
+        ffmpegkit::MediaInformationSession::create(arguments, completeCallback);
+    ffmpegkit::FFmpegKitConfig::asyncNativeGetMediaInformationExecute(
+        session, path, probeOptions);
+    return session;
+}
+
+int ffmpegkit::FFprobeKit::getMediaInformationBatch(
+    const std::vector<std::string> &paths,
+    const MediaInformationBatchOptions &options,
+    MediaInformationBatchCallback callback) {
+    std::atomic<size_t> next{0};
+    std::atomic<int> failures{0};
+    std::mutex callbackMutex;
+    size_t workerCount =
+        std::min((size_t)options.getWorkerCount(), paths.size());
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < paths.size(); i = next++) {
+            auto result = probeBatchEntry(i, paths[i], options);
+            if (!result->isSuccess()) {
+                failures++;
+            }
+            if (callback != nullptr) {
+                std::lock_guard<std::mutex> lock(callbackMutex);
+                try {
+                    callback(result);
+                } catch (const std::exception &exception) {
+                    std::cout
+                        << "Exception thrown inside batch result callback. "
+                        << exception.what() << std::endl;
+                }
+            }
+        }
+    };
+
+    // THE CALLING THREAD IS ONE OF THE WORKERS
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++) {
+        try {
+            workers.emplace_back(worker);
+        } catch (const std::system_error &exception) {
+            // THE WORKERS ALREADY STARTED PROBE THE REMAINING FILES
+            std::cout << "Failed to start batch worker. " << exception.what()
+                      << std::endl;
+            break;
+        }
+    }
+    worker();
+    for (auto &thread : workers) {
+        thread.join();
+    }
+
+    return failures;
+}
+
 std::shared_ptr<ffmpegkit::MediaInformationSession>
 ffmpegkit::FFprobeKit::getMediaInformationFromCommand(
     const std::string command) {
@@ -21,10 +21,16 @@
 #define FFPROBE_KIT_H
 
 #include "FFprobeSession.h"
+#include "MediaInformationBatchCallback.h"
+#include "MediaInformationBatchOptions.h"
+#include "MediaInformationBinaryParser.h"
 #include "MediaInformationJsonParser.h"
+#include "MediaInformationProbeOptions.h"
 #include "MediaInformationSession.h"
+#include "MediaRecordCallback.h"
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 namespace ffmpegkit {
 
@@ -143,6 +149,67 @@ class FFprobeKit {
                  FFprobeSessionCompleteCallback completeCallback,
                  ffmpegkit::LogCallback logCallback);
 
+    /**
+     * <p>Synchronously executes FFprobe with arguments provided, delivering
+     * the packets and frames selected with -show_packets and -show_frames to
+     * recordCallback in batches instead of printing them. Memory used does
+     * not depend on the length of the input.
+     *
+     * @param arguments      FFprobe command options/arguments as string array
+     * @param recordCallback callback that receives the records
+     * @return FFprobe session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::FFprobeSession>
+    executeWithArgumentsForRecords(const std::list<std::string> &arguments,
+                                   MediaRecordCallback recordCallback);
+
+    /**
+     * <p>Synchronously reads the packets and/or frames of all streams of the
+     * file specified with path and delivers them to recordCallback in
+     * batches. Frames are decoded, which takes much longer than reading
+     * packets.
+     *
+     * @param path           path or uri of a media file
+     * @param packets        whether packet records are delivered
+     * @param frames         whether frame records are delivered
+     * @param recordCallback callback that receives the records
+     * @return FFprobe session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::FFprobeSession>
+    getMediaRecords(const std::string path, const bool packets,
+                    const bool frames, MediaRecordCallback recordCallback);
+
+    /**
+     * <p>Synchronously reads the packets of the file specified with path,
+     * without decoding them, and saves the positions of its keyframes in a
+     * seek index next to the file, named after it with a ".seekidx"
+     * extension. FFmpeg sessions that seek in the same file with -ss use the
+     * index to jump to the exact byte offset of the keyframe, as long as the
+     * file is not modified. Only local files are supported.
+     *
+     * @param path path of a local media file
+     * @return FFprobe session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::FFprobeSession>
+    buildSeekIndex(const std::string path);
+
+    /**
+     * <p>Starts an asynchronous build of the seek index of the file specified
+     * with path.
+     *
+     * <p>Note that this method returns immediately and does not wait the
+     * execution to complete. You must use an FFprobeSessionCompleteCallback if
+     * you want to be notified about the result.
+     *
+     * @param path             path of a local media file
+     * @param completeCallback callback that will be called when the execution
+     * has completed
+     * @return FFprobe session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::FFprobeSession>
+    buildSeekIndexAsync(const std::string path,
+                        FFprobeSessionCompleteCallback completeCallback);
+
     /**
      * <p>Extracts media information for the file specified with path.
      *
@@ -205,6 +272,91 @@ class FFprobeKit {
         MediaInformationSessionCompleteCallback completeCallback,
         ffmpegkit::LogCallback logCallback, const int waitTimeout);
 
+    /**
+     * <p>Extracts media information for the file specified with path
+     * in-process, filling it straight from libavformat instead of parsing
+     * FFprobe's json output.
+     *
+     * @param path path or uri of a media file
+     * @return media information session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformationSession>
+    getMediaInformationNative(const std::string path);
+
+    /**
+     * <p>Extracts media information for the file specified with path
+     * in-process using the given probe options. Quick probes and probes
+     * whose deadline expires flag the fields they estimate in
+     * FormatFields::estimated and StreamFields::estimated.
+     *
+     * @param path         path or uri of a media file
+     * @param probeOptions probe options
+     * @return media information session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformationSession>
+    getMediaInformationNative(
+        const std::string path,
+        const ffmpegkit::MediaInformationProbeOptions &probeOptions);
+
+    /**
+     * <p>Starts an asynchronous in-process extraction of the media information
+     * for the specified file.
+     *
+     * <p>Note that this method returns immediately and does not wait the
+     * execution to complete. You must use an
+     * MediaInformationSessionCompleteCallback if you want to be notified about
+     * the result.
+     *
+     * @param path             path or uri of a media file
+     * @param completeCallback callback that will be called when the execution
+     * has completed
+     * @return media information session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformationSession>
+    getMediaInformationNativeAsync(
+        const std::string path,
+        MediaInformationSessionCompleteCallback completeCallback);
+
+    /**
+     * <p>Starts an asynchronous in-process extraction of the media information
+     * for the specified file using the given probe options.
+     *
+     * <p>Note that this method returns immediately and does not wait the
+     * execution to complete. You must use an
+     * MediaInformationSessionCompleteCallback if you want to be notified about
+     * the result.
+     *
+     * @param path             path or uri of a media file
+     * @param probeOptions     probe options
+     * @param completeCallback callback that will be called when the execution
+     * has completed
+     * @return media information session created for this execution
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformationSession>
+    getMediaInformationNativeAsync(
+        const std::string path,
+        const ffmpegkit::MediaInformationProbeOptions &probeOptions,
+        MediaInformationSessionCompleteCallback completeCallback);
+
+    /**
+     * <p>Extracts media information for all the files specified with paths,
+     * probing several files at the same time on a bounded pool of workers.
+     *
+     * <p>This method returns when all files are probed. Results are delivered
+     * to the callback as each file completes; a file that can not be probed is
+     * reported with its error and does not stop the batch. Unless requested
+     * in options, no session is created for the files.
+     *
+     * @param paths    paths or uris of media files
+     * @param options  batch options
+     * @param callback callback that receives the result of each file
+     * @return number of files that could not be probed
+     */
+    static int
+    getMediaInformationBatch(const std::vector<std::string> &paths,
+                             const MediaInformationBatchOptions &options,
+                             MediaInformationBatchCallback callback);
+
     /**
      * <p>Extracts media information using the command provided asynchronously.
      *
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InputStatistics.h"
+
+ffmpegkit::InputStatistics::InputStatistics(
+    const long sessionId, const int fileIndex, const std::string &url,
+    const uint64_t packets, const uint64_t size,
+    const double producerBlockedTime, const double consumerStarvedTime,
+    const int queueSizeMin, const int queueSizeMax, const int queueSizePeak,
+    const uint64_t packetPoolHits, const uint64_t packetPoolMisses,
+    const uint64_t bytesRead, const std::string &md5,
+    const std::string &sha256)
+    : _sessionId{sessionId}, _fileIndex{fileIndex}, _url{url},
+      _packets{packets}, _size{size},
+      _producerBlockedTime{producerBlockedTime},
+      _consumerStarvedTime{consumerStarvedTime}, _queueSizeMin{queueSizeMin},
+      _queueSizeMax{queueSizeMax}, _queueSizePeak{queueSizePeak},
+      _packetPoolHits{packetPoolHits}, _packetPoolMisses{packetPoolMisses},
+      _bytesRead{bytesRead}, _md5{md5}, _sha256{sha256} {}
+
+long ffmpegkit::InputStatistics::getSessionId() { return _sessionId; }
+
+int ffmpegkit::InputStatistics::getFileIndex() { return _fileIndex; }
+
+std::string ffmpegkit::InputStatistics::getUrl() { return _url; }
+
+uint64_t ffmpegkit::InputStatistics::getPackets() { return _packets; }
+
+uint64_t ffmpegkit::InputStatistics::getSize() { return _size; }
+
+double ffmpegkit::InputStatistics::getProducerBlockedTime() {
+    return _producerBlockedTime;
+}
+
+double ffmpegkit::InputStatistics::getConsumerStarvedTime() {
+    return _consumerStarvedTime;
+}
+
+int ffmpegkit::InputStatistics::getQueueSizeMin() { return _queueSizeMin; }
+
+int ffmpegkit::InputStatistics::getQueueSizeMax() { return _queueSizeMax; }
+
+int ffmpegkit::InputStatistics::getQueueSizePeak() { return _queueSizePeak; }
+
+uint64_t ffmpegkit::InputStatistics::getPacketPoolHits() {
+    return _packetPoolHits;
+}
+
+uint64_t ffmpegkit::InputStatistics::getPacketPoolMisses() {
+    return _packetPoolMisses;
+}
+
+uint64_t ffmpegkit::InputStatistics::getBytesRead() { return _bytesRead; }
+
+std::string ffmpegkit::InputStatistics::getMd5() { return _md5; }
+
+std::string ffmpegkit::InputStatistics::getSha256() { return _sha256; }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_INPUT_STATISTICS_H
+#define FFMPEG_KIT_INPUT_STATISTICS_H
+
+#include <stdint.h>
+#include <string>
+
+namespace ffmpegkit {
+
+/**
+ * Demuxing statistics of a single input file of an FFmpeg execute session.
+ * Created once for each input, when the input is closed.
+ */
+class InputStatistics {
+  public:
+    InputStatistics(const long sessionId, const int fileIndex,
+                    const std::string &url, const uint64_t packets,
+                    const uint64_t size, const double producerBlockedTime,
+                    const double consumerStarvedTime, const int queueSizeMin,
+                    const int queueSizeMax, const int queueSizePeak,
+                    const uint64_t packetPoolHits,
+                    const uint64_t packetPoolMisses, const uint64_t bytesRead,
+                    const std::string &md5, const std::string &sha256);
+    long getSessionId();
+    int getFileIndex();
+    std::string getUrl();
+    uint64_t getPackets();
+    uint64_t getSize();
+
+    /**
+     * Returns the time the demuxer thread spent waiting for room in the
+     * packet queue, in milliseconds.
+     */
+    double getProducerBlockedTime();
+
+    /**
+     * Returns the time the main thread spent waiting for packets from this
+     * input, in milliseconds.
+     */
+    double getConsumerStarvedTime();
+
+    int getQueueSizeMin();
+    int getQueueSizeMax();
+
+    /**
+     * Returns the largest queue size used for this input.
+     */
+    int getQueueSizePeak();
+
+    /**
+     * Returns the number of packets that reused a pooled packet.
+     */
+    uint64_t getPacketPoolHits();
+
+    /**
+     * Returns the number of packets that had to be allocated. In steady state
+     * this stops growing.
+     */
+    uint64_t getPacketPoolMisses();
+
+    /**
+     * Returns the number of bytes read from the input, including the bytes
+     * read while probing and seeking. Zero for inputs that are not read
+     * through a protocol, like devices.
+     */
+    uint64_t getBytesRead();
+
+    /**
+     * Returns the MD5 digest of the input file as a lowercase hex string,
+     * empty unless requested with the -digest option.
+     */
+    std::string getMd5();
+
+    /**
+     * Returns the SHA-256 digest of the input file as a lowercase hex string,
+     * empty unless requested with the -digest option.
+     */
+    std::string getSha256();
+
+  private:
+    long _sessionId;
+    int _fileIndex;
+    std::string _url;
+    uint64_t _packets;
+    uint64_t _size;
+    double _producerBlockedTime;
+    double _consumerStarvedTime;
+    int _queueSizeMin;
+    int _queueSizeMax;
+    int _queueSizePeak;
+    uint64_t _packetPoolHits;
+    uint64_t _packetPoolMisses;
+    uint64_t _bytesRead;
+    std::string _md5;
+    std::string _sha256;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_INPUT_STATISTICS_H
@@ -19,68 +19,200 @@
 
 #include "MediaInformation.h"
 
+static constexpr const char *MediaInformationKeyStreams = "streams";
+static constexpr const char *MediaInformationKeyChapters = "chapters";
+
 ffmpegkit::MediaInformation::MediaInformation(
     std::shared_ptr<rapidjson::Value> mediaInformationValue,
     std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>
         streams,
     std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::Chapter>>> chapters)
-    : _mediaInformationValue{mediaInformationValue}, _streams{streams},
-      _chapters{chapters} {}
+    : _streams{streams}, _chapters{chapters} {
+    if (mediaInformationValue != nullptr) {
+        _json = std::make_shared<LazyJsonDocument>(
+            LazyJsonDocument::copy(*mediaInformationValue));
+        auto format = getFormatValue();
+        if (format != nullptr) {
+            _format = FormatFields::from(*format);
+        }
+    }
+    if (streams != nullptr) {
+        for (auto &stream : *streams) {
+            if (stream != nullptr) {
+                _streamList.push_back(*stream);
+            }
+        }
+    }
+    if (chapters != nullptr) {
+        for (auto &chapter : *chapters) {
+            if (chapter != nullptr) {
+                _chapterList.push_back(*chapter);
+            }
+        }
+    }
+}
+
+ffmpegkit::MediaInformation::MediaInformation(
+    const FormatFields &format,
+    std::vector<ffmpegkit::StreamInformation> streams,
+    std::vector<ffmpegkit::Chapter> chapters,
+    std::shared_ptr<LazyJsonDocument> json)
+    : _format{format}, _streamList{std::move(streams)},
+      _chapterList{std::move(chapters)}, _json{json} {}
+
+std::shared_ptr<ffmpegkit::MediaInformation>
+ffmpegkit::MediaInformation::fromFields(
+    const FormatFields &format, const std::vector<StreamFields> &streams,
+    const std::vector<ChapterFields> &chapters) {
+    auto streamFields = std::make_shared<std::vector<StreamFields>>(streams);
+    auto chapterFields = std::make_shared<std::vector<ChapterFields>>(chapters);
+    std::vector<ffmpegkit::StreamInformation> streamList;
+    std::vector<ffmpegkit::Chapter> chapterList;
+
+    auto json = std::make_shared<ffmpegkit::LazyJsonDocument>(
+        [format, streamFields, chapterFields]() {
+            auto document = std::make_shared<rapidjson::Document>();
+            auto &allocator = document->GetAllocator();
+            rapidjson::Value formatValue(rapidjson::kObjectType);
+            rapidjson::Value streamArray(rapidjson::kArrayType);
+            rapidjson::Value chapterArray(rapidjson::kArrayType);
+            rapidjson::Value key;
+
+            for (auto &fields : *streamFields) {
+                rapidjson::Value streamValue(rapidjson::kObjectType);
+                fields.write(streamValue, allocator);
+                streamArray.PushBack(streamValue, allocator);
+            }
+            for (auto &fields : *chapterFields) {
+                rapidjson::Value chapterValue(rapidjson::kObjectType);
+                fields.write(chapterValue, allocator);
+                chapterArray.PushBack(chapterValue, allocator);
+            }
+            format.write(formatValue, allocator);
+
+            document->SetObject();
+            key.SetString(MediaInformationKeyStreams, allocator);
+            document->AddMember(key, streamArray, allocator);
+            key.SetString(MediaInformationKeyChapters, allocator);
+            document->AddMember(key, chapterArray, allocator);
+            key.SetString(KeyFormatProperties, allocator);
+            document->AddMember(key, formatValue, allocator);
+
+            return document;
+        });
+
+    streamList.reserve(streamFields->size());
+    for (size_t i = 0; i < streamFields->size(); i++) {
+        streamList.emplace_back((*streamFields)[i], json, i);
+    }
+    chapterList.reserve(chapterFields->size());
+    for (size_t i = 0; i < chapterFields->size(); i++) {
+        chapterList.emplace_back((*chapterFields)[i], json, i);
+    }
+
+    return std::make_shared<ffmpegkit::MediaInformation>(
+        format, std::move(streamList), std::move(chapterList), json);
+}
+
+const ffmpegkit::FormatFields &
+ffmpegkit::MediaInformation::getFormatFields() const {
+    return _format;
+}
+
+const std::vector<ffmpegkit::StreamInformation> &
+ffmpegkit::MediaInformation::getStreamList() const {
+    return _streamList;
+}
+
+const std::vector<ffmpegkit::Chapter> &
+ffmpegkit::MediaInformation::getChapterList() const {
+    return _chapterList;
+}
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getFilename() {
-    return getStringFormatProperty(KeyFilename);
+    if (_format.filename) {
+        return std::make_shared<std::string>(_format.filename.value());
+    } else {
+        return nullptr;
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getFormat() {
-    return getStringFormatProperty(KeyFormat);
+    return toSharedString(_format.formatName);
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getLongFormat() {
-    return getStringFormatProperty(KeyFormatLong);
+    return toSharedString(_format.formatLongName);
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getStartTime() {
-    return getStringFormatProperty(KeyStartTime);
+    if (_format.startTime || !_format.lossy) {
+        return toSharedString(_format.startTime);
+    } else {
+        return getStringFormatProperty(KeyStartTime);
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getDuration() {
-    return getStringFormatProperty(KeyDuration);
+    if (_format.duration || !_format.lossy) {
+        return toSharedString(_format.duration);
+    } else {
+        return getStringFormatProperty(KeyDuration);
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getSize() {
-    return getStringFormatProperty(KeySize);
+    if (_format.size || !_format.lossy) {
+        return toSharedString(_format.size);
+    } else {
+        return getStringFormatProperty(KeySize);
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::MediaInformation::getBitrate() {
-    return getStringFormatProperty(KeyBitRate);
+    if (_format.bitRate || !_format.lossy) {
+        return toSharedString(_format.bitRate);
+    } else {
+        return getStringFormatProperty(KeyBitRate);
+    }
 }
 
 std::shared_ptr<rapidjson::Value> ffmpegkit::MediaInformation::getTags() {
-    auto formatProperties = getFormatProperties();
-    if (formatProperties->HasMember(KeyTags)) {
-        auto tags = std::make_shared<rapidjson::Value>();
-        *tags = (*formatProperties)[KeyTags];
-        return tags;
-    } else {
-        return nullptr;
-    }
+    return toSharedTags(_format.tags);
 }
 
 std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>
 ffmpegkit::MediaInformation::getStreams() {
+    std::lock_guard<std::mutex> lock(_sharedListLock);
+    if (_streams == nullptr) {
+        _streams = std::make_shared<
+            std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>();
+        for (auto &stream : _streamList) {
+            _streams->push_back(
+                std::make_shared<ffmpegkit::StreamInformation>(stream));
+        }
+    }
     return _streams;
 }
 
 std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::Chapter>>>
 ffmpegkit::MediaInformation::getChapters() {
+    std::lock_guard<std::mutex> lock(_sharedListLock);
+    if (_chapters == nullptr) {
+        _chapters = std::make_shared<
+            std::vector<std::shared_ptr<ffmpegkit::Chapter>>>();
+        for (auto &chapter : _chapterList) {
+            _chapters->push_back(std::make_shared<ffmpegkit::Chapter>(chapter));
+        }
+    }
     return _chapters;
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::MediaInformation::getStringProperty(const char *key) {
-    auto allProperties = getAllProperties();
-    if (allProperties->HasMember(key)) {
-        return std::make_shared<std::string>((*allProperties)[key].GetString());
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsString()) {
+        return std::make_shared<std::string>(value->GetString());
     } else {
         return nullptr;
     }
@@ -88,9 +220,10 @@ ffmpegkit::MediaInformation::getStringProperty(const char *key) {
 
 std::shared_ptr<int64_t>
 ffmpegkit::MediaInformation::getNumberProperty(const char *key) {
-    auto allProperties = getAllProperties();
-    if (allProperties->HasMember(key)) {
-        return std::make_shared<int64_t>((*allProperties)[key].GetInt64());
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsNumber()) {
+        return std::make_shared<int64_t>(
+            value->IsInt64() ? value->GetInt64() : (int64_t)value->GetDouble());
     } else {
         return nullptr;
     }
@@ -98,11 +231,9 @@ ffmpegkit::MediaInformation::getNumberProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::MediaInformation::getProperty(const char *key) {
-    auto allProperties = getAllProperties();
-    if (allProperties->HasMember(key)) {
-        auto value = std::make_shared<rapidjson::Value>();
-        *value = (*allProperties)[key];
-        return value;
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
@@ -110,10 +241,9 @@ ffmpegkit::MediaInformation::getProperty(const char *key) {
 
 std::shared_ptr<std::string>
 ffmpegkit::MediaInformation::getStringFormatProperty(const char *key) {
-    auto formatProperties = getFormatProperties();
-    if (formatProperties->HasMember(key)) {
-        return std::make_shared<std::string>(
-            (*formatProperties)[key].GetString());
+    auto value = LazyJsonDocument::findMember(getFormatValue(), key);
+    if (value != nullptr && value->IsString()) {
+        return std::make_shared<std::string>(value->GetString());
     } else {
         return nullptr;
     }
@@ -121,9 +251,10 @@ ffmpegkit::MediaInformation::getStringFormatProperty(const char *key) {
 
 std::shared_ptr<int64_t>
 ffmpegkit::MediaInformation::getNumberFormatProperty(const char *key) {
-    auto formatProperties = getFormatProperties();
-    if (formatProperties->HasMember(key)) {
-        return std::make_shared<int64_t>((*formatProperties)[key].GetInt64());
+    auto value = LazyJsonDocument::findMember(getFormatValue(), key);
+    if (value != nullptr && value->IsNumber()) {
+        return std::make_shared<int64_t>(
+            value->IsInt64() ? value->GetInt64() : (int64_t)value->GetDouble());
     } else {
         return nullptr;
     }
@@ -131,11 +262,9 @@ ffmpegkit::MediaInformation::getNumberFormatProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::MediaInformation::getFormatProperty(const char *key) {
-    auto formatProperties = getFormatProperties();
-    if (formatProperties->HasMember(key)) {
-        auto value = std::make_shared<rapidjson::Value>();
-        *value = (*formatProperties)[key];
-        return value;
+    auto value = LazyJsonDocument::findMember(getFormatValue(), key);
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
@@ -143,10 +272,9 @@ ffmpegkit::MediaInformation::getFormatProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::MediaInformation::getFormatProperties() {
-    if (_mediaInformationValue->HasMember(KeyFormatProperties)) {
-        auto mediaProperties = std::make_shared<rapidjson::Value>();
-        *mediaProperties = (*_mediaInformationValue)[KeyFormatProperties];
-        return mediaProperties;
+    auto value = getFormatValue();
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
@@ -154,11 +282,22 @@ ffmpegkit::MediaInformation::getFormatProperties() {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::MediaInformation::getAllProperties() {
-    if (_mediaInformationValue != nullptr) {
-        auto all = std::make_shared<rapidjson::Value>();
-        *all = (*_mediaInformationValue);
-        return all;
+    auto value = getValue();
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
 }
+
+const rapidjson::Value *ffmpegkit::MediaInformation::getValue() const {
+    if (_json != nullptr) {
+        return &_json->getRoot();
+    } else {
+        return nullptr;
+    }
+}
+
+const rapidjson::Value *ffmpegkit::MediaInformation::getFormatValue() const {
+    return LazyJsonDocument::findMember(getValue(), KeyFormatProperties);
+}
@@ -23,6 +23,7 @@
 #include "Chapter.h"
 #include "StreamInformation.h"
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace ffmpegkit {
@@ -50,6 +51,46 @@ class MediaInformation {
         std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::Chapter>>>
             chapters);
 
+    /**
+     * Creates media information from fields already extracted. Keys that are
+     * not extracted are looked up in the json document.
+     */
+    MediaInformation(const FormatFields &format,
+                     std::vector<ffmpegkit::StreamInformation> streams,
+                     std::vector<ffmpegkit::Chapter> chapters,
+                     std::shared_ptr<LazyJsonDocument> json);
+
+    /**
+     * Creates media information from fields only. The json document used by
+     * the key based getters is created from the fields on first use.
+     */
+    static std::shared_ptr<MediaInformation>
+    fromFields(const FormatFields &format,
+               const std::vector<StreamFields> &streams,
+               const std::vector<ChapterFields> &chapters);
+
+    /**
+     * Returns the typed format fields. Unlike the other getters this neither
+     * allocates nor accesses the json document.
+     *
+     * @return format fields
+     */
+    const FormatFields &getFormatFields() const;
+
+    /**
+     * Returns all streams without copying them.
+     *
+     * @return streams vector
+     */
+    const std::vector<ffmpegkit::StreamInformation> &getStreamList() const;
+
+    /**
+     * Returns all chapters without copying them.
+     *
+     * @return chapters vector
+     */
+    const std::vector<ffmpegkit::Chapter> &getChapterList() const;
+
     /**
      * Returns file name.
      *
@@ -180,7 +221,16 @@ class MediaInformation {
     std::shared_ptr<rapidjson::Value> getAllProperties();
 
   private:
-    std::shared_ptr<rapidjson::Value> _mediaInformationValue;
+    const rapidjson::Value *getValue() const;
+    const rapidjson::Value *getFormatValue() const;
+
+    FormatFields _format;
+    std::vector<ffmpegkit::StreamInformation> _streamList;
+    std::vector<ffmpegkit::Chapter> _chapterList;
+    std::shared_ptr<LazyJsonDocument> _json;
+
+    /* created on first use of getStreams() and getChapters() */
+    std::mutex _sharedListLock;
     std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>
         _streams;
     std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::Chapter>>> _chapters;
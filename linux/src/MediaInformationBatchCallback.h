@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_BATCH_CALLBACK_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_BATCH_CALLBACK_H
+
+#include "MediaInformationBatchResult.h"
+#include <functional>
+#include <memory>
+
+namespace ffmpegkit {
+
+/**
+ * <p>Callback function that is invoked each time a file of a batch has been
+ * probed, in completion order. <p>It is called from the worker threads of the
+ * batch, but never by two threads at the same time.
+ *
+ * @param result result of the file probed
+ */
+typedef std::function<void(
+    const std::shared_ptr<ffmpegkit::MediaInformationBatchResult> result)>
+    MediaInformationBatchCallback;
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_BATCH_CALLBACK_H
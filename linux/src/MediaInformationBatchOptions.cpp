@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationBatchOptions.h"
+#include "AbstractSession.h"
+#include <thread>
+
+ffmpegkit::MediaInformationBatchOptions::MediaInformationBatchOptions()
+    : _maxWorkers{0}, _ioDepth{DefaultIoDepth}, _keepSessionHistory{false},
+      _useFFprobe{false},
+      _waitTimeout{ffmpegkit::AbstractSession::
+                       DefaultTimeoutForAsynchronousMessagesInTransmit} {}
+
+void ffmpegkit::MediaInformationBatchOptions::setMaxWorkers(
+    const int maxWorkers) {
+    _maxWorkers = maxWorkers;
+}
+
+int ffmpegkit::MediaInformationBatchOptions::getMaxWorkers() const {
+    return _maxWorkers;
+}
+
+void ffmpegkit::MediaInformationBatchOptions::setIoDepth(const int ioDepth) {
+    _ioDepth = ioDepth;
+}
+
+int ffmpegkit::MediaInformationBatchOptions::getIoDepth() const {
+    return _ioDepth;
+}
+
+int ffmpegkit::MediaInformationBatchOptions::getWorkerCount() const {
+    if (_maxWorkers > 0) {
+        return _maxWorkers;
+    }
+
+    // hardware_concurrency MAY RETURN 0 IF IT IS NOT COMPUTABLE
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores < 1) {
+        cores = 1;
+    }
+
+    return cores * (_ioDepth > 0 ? _ioDepth : 1);
+}
+
+void ffmpegkit::MediaInformationBatchOptions::setKeepSessionHistory(
+    const bool keepSessionHistory) {
+    _keepSessionHistory = keepSessionHistory;
+}
+
+bool ffmpegkit::MediaInformationBatchOptions::isKeepSessionHistory() const {
+    return _keepSessionHistory;
+}
+
+void ffmpegkit::MediaInformationBatchOptions::setUseFFprobe(
+    const bool useFFprobe) {
+    _useFFprobe = useFFprobe;
+}
+
+bool ffmpegkit::MediaInformationBatchOptions::isUseFFprobe() const {
+    return _useFFprobe;
+}
+
+void ffmpegkit::MediaInformationBatchOptions::setWaitTimeout(
+    const int waitTimeout) {
+    _waitTimeout = waitTimeout;
+}
+
+int ffmpegkit::MediaInformationBatchOptions::getWaitTimeout() const {
+    return _waitTimeout;
+}
+
+void ffmpegkit::MediaInformationBatchOptions::setProbeOptions(
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions) {
+    _probeOptions = probeOptions;
+}
+
+const ffmpegkit::MediaInformationProbeOptions &
+ffmpegkit::MediaInformationBatchOptions::getProbeOptions() const {
+    return _probeOptions;
+}
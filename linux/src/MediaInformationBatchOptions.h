@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_BATCH_OPTIONS_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_BATCH_OPTIONS_H
+
+#include "MediaInformationProbeOptions.h"
+
+namespace ffmpegkit {
+
+/**
+ * Options of FFprobeKit::getMediaInformationBatch.
+ */
+class MediaInformationBatchOptions {
+  public:
+    static constexpr int DefaultIoDepth = 2;
+
+    MediaInformationBatchOptions();
+
+    /**
+     * Sets the maximum number of files probed at the same time. Zero, the
+     * default, uses the number of cores multiplied by the io depth.
+     */
+    void setMaxWorkers(const int maxWorkers);
+
+    int getMaxWorkers() const;
+
+    /**
+     * Sets how many probes run per core when the number of workers is chosen
+     * automatically. Probes mostly wait for reads, so more than one probe per
+     * core keeps the cores busy.
+     */
+    void setIoDepth(const int ioDepth);
+
+    int getIoDepth() const;
+
+    /**
+     * Returns the number of workers used for a batch.
+     */
+    int getWorkerCount() const;
+
+    /**
+     * Sets whether a MediaInformationSession is created and added to the
+     * session history for each file. Disabled by default.
+     */
+    void setKeepSessionHistory(const bool keepSessionHistory);
+
+    bool isKeepSessionHistory() const;
+
+    /**
+     * Sets whether files are probed by running FFprobe and parsing its json
+     * output instead of probing in-process. FFprobe runs need a session, so
+     * each file is added to the session history. Disabled by default.
+     */
+    void setUseFFprobe(const bool useFFprobe);
+
+    bool isUseFFprobe() const;
+
+    /**
+     * Sets the max time to wait until FFprobe's output is transmitted.
+     */
+    void setWaitTimeout(const int waitTimeout);
+
+    int getWaitTimeout() const;
+
+    /**
+     * Sets the options of in-process probes, like quick mode and the
+     * deadline of each file.
+     */
+    void setProbeOptions(
+        const ffmpegkit::MediaInformationProbeOptions &probeOptions);
+
+    const ffmpegkit::MediaInformationProbeOptions &getProbeOptions() const;
+
+  private:
+    int _maxWorkers;
+    int _ioDepth;
+    bool _keepSessionHistory;
+    bool _useFFprobe;
+    int _waitTimeout;
+    ffmpegkit::MediaInformationProbeOptions _probeOptions;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_BATCH_OPTIONS_H
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationBatchResult.h"
+
+ffmpegkit::MediaInformationBatchResult::MediaInformationBatchResult(
+    const size_t index, const std::string &path, const int returnCode,
+    const std::string &error,
+    const std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation,
+    const std::shared_ptr<ffmpegkit::MediaInformationSession> session)
+    : _index{index}, _path{path}, _returnCode{returnCode}, _error{error},
+      _mediaInformation{mediaInformation}, _session{session} {}
+
+size_t ffmpegkit::MediaInformationBatchResult::getIndex() const {
+    return _index;
+}
+
+std::string ffmpegkit::MediaInformationBatchResult::getPath() const {
+    return _path;
+}
+
+int ffmpegkit::MediaInformationBatchResult::getReturnCode() const {
+    return _returnCode;
+}
+
+bool ffmpegkit::MediaInformationBatchResult::isSuccess() const {
+    return _returnCode == 0 && _mediaInformation != nullptr;
+}
+
+std::string ffmpegkit::MediaInformationBatchResult::getError() const {
+    return _error;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformation>
+ffmpegkit::MediaInformationBatchResult::getMediaInformation() const {
+    return _mediaInformation;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationSession>
+ffmpegkit::MediaInformationBatchResult::getSession() const {
+    return _session;
+}
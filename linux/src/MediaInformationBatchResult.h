@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_BATCH_RESULT_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_BATCH_RESULT_H
+
+#include "MediaInformation.h"
+#include "MediaInformationSession.h"
+#include <memory>
+#include <string>
+
+namespace ffmpegkit {
+
+/**
+ * Result of probing a single file of a batch.
+ */
+class MediaInformationBatchResult {
+  public:
+    MediaInformationBatchResult(
+        const size_t index, const std::string &path, const int returnCode,
+        const std::string &error,
+        const std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation,
+        const std::shared_ptr<ffmpegkit::MediaInformationSession> session);
+
+    /**
+     * Returns the position of the file in the list of paths.
+     */
+    size_t getIndex() const;
+
+    std::string getPath() const;
+
+    /**
+     * Returns the return code, which follows FFprobe's return codes.
+     */
+    int getReturnCode() const;
+
+    bool isSuccess() const;
+
+    /**
+     * Returns the reason of the failure, empty on success.
+     */
+    std::string getError() const;
+
+    /**
+     * Returns the media information extracted or nullptr if probing failed.
+     */
+    std::shared_ptr<ffmpegkit::MediaInformation> getMediaInformation() const;
+
+    /**
+     * Returns the session created for the file or nullptr if no session was
+     * created.
+     */
+    std::shared_ptr<ffmpegkit::MediaInformationSession> getSession() const;
+
+  private:
+    size_t _index;
+    std::string _path;
+    int _returnCode;
+    std::string _error;
+    std::shared_ptr<ffmpegkit::MediaInformation> _mediaInformation;
+    std::shared_ptr<ffmpegkit::MediaInformationSession> _session;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_BATCH_RESULT_H
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationBinaryParser.h"
+#include "MediaInformationBinaryReader.h"
+#include <iostream>
+#include <stdexcept>
+
+static const char *MediaInformationBinaryParserKeyFormat = "format";
+static const char *MediaInformationBinaryParserKeyStreams = "streams";
+static const char *MediaInformationBinaryParserKeyChapters = "chapters";
+
+/**
+ * Creates the json document FFprobe's json writer would print for the given
+ * binary output. Unless copyStrings is set, names and string values refer to
+ * the output, which must then outlive the document.
+ */
+static std::shared_ptr<rapidjson::Document>
+buildDocument(const std::vector<uint8_t> &output, const bool copyStrings) {
+    auto document = std::make_shared<rapidjson::Document>();
+    auto &allocator = document->GetAllocator();
+    std::vector<rapidjson::Value *> sections;
+    ffmpegkit::MediaInformationBinaryReader reader(output.data(),
+                                                   output.size());
+
+    auto setString = [&](rapidjson::Value &value, const char *string,
+                         size_t length) {
+        if (copyStrings) {
+            value.SetString(string, (rapidjson::SizeType)length, allocator);
+        } else {
+            value.SetString(
+                rapidjson::StringRef(string, (rapidjson::SizeType)length));
+        }
+    };
+
+    // SECTIONS ARE ONLY ADDED TO THE INNERMOST OPEN SECTION, SO THE POINTERS
+    // KEPT FOR THE OPEN SECTIONS ARE NOT INVALIDATED
+    while (reader.next()) {
+        rapidjson::Value *parent = sections.empty() ? nullptr : sections.back();
+        rapidjson::Value name;
+        rapidjson::Value value;
+
+        switch (reader.getType()) {
+        case ffmpegkit::MediaInformationBinaryReader::SectionStart:
+            if (reader.getFlags() &
+                ffmpegkit::MediaInformationBinaryReader::SectionArray) {
+                value.SetArray();
+            } else {
+                value.SetObject();
+            }
+            if (parent == nullptr) {
+                document->SetObject();
+                sections.push_back(document.get());
+            } else if (parent->IsArray()) {
+                parent->PushBack(value, allocator);
+                sections.push_back(&(*parent)[parent->Size() - 1]);
+            } else {
+                setString(name, reader.getName(), reader.getNameLength());
+                parent->AddMember(name, value, allocator);
+                sections.push_back(&(parent->MemberEnd() - 1)->value);
+            }
+            break;
+        case ffmpegkit::MediaInformationBinaryReader::SectionEnd:
+            sections.pop_back();
+            break;
+        case ffmpegkit::MediaInformationBinaryReader::StringItem:
+        case ffmpegkit::MediaInformationBinaryReader::IntegerItem:
+            if (!parent->IsObject()) {
+                throw std::runtime_error(
+                    "Binary FFprobe output item inside an array");
+            }
+            setString(name, reader.getName(), reader.getNameLength());
+            if (reader.getType() ==
+                ffmpegkit::MediaInformationBinaryReader::StringItem) {
+                setString(value, reader.getString(), reader.getStringLength());
+            } else {
+                value.SetInt64(reader.getInteger());
+            }
+            parent->AddMember(name, value, allocator);
+            break;
+        }
+    }
+
+    return document;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformation>
+ffmpegkit::MediaInformationBinaryParser::from(
+    const std::shared_ptr<std::vector<uint8_t>> ffprobeBinaryOutput) {
+    try {
+        return fromWithError(ffprobeBinaryOutput);
+    } catch (const std::exception &exception) {
+        std::cout << "MediaInformation parsing failed: " << exception.what()
+                  << std::endl;
+        return nullptr;
+    }
+}
+
+std::shared_ptr<ffmpegkit::MediaInformation>
+ffmpegkit::MediaInformationBinaryParser::fromWithError(
+    const std::shared_ptr<std::vector<uint8_t>> ffprobeBinaryOutput) {
+    if (ffprobeBinaryOutput == nullptr) {
+        throw std::runtime_error("No binary FFprobe output");
+    }
+
+    // FIELDS ARE EXTRACTED FROM A DOCUMENT THAT REFERS TO THE OUTPUT. THE
+    // DOCUMENT USED BY THE KEY BASED GETTERS IS BUILT AGAIN ON FIRST USE
+    auto document = buildDocument(*ffprobeBinaryOutput, false);
+    auto json = std::make_shared<ffmpegkit::LazyJsonDocument>(
+        [ffprobeBinaryOutput]() -> std::shared_ptr<rapidjson::Document> {
+            try {
+                return buildDocument(*ffprobeBinaryOutput, true);
+            } catch (const std::exception &) {
+                return nullptr;
+            }
+        });
+    std::vector<ffmpegkit::StreamInformation> streams;
+    std::vector<ffmpegkit::Chapter> chapters;
+    ffmpegkit::FormatFields format;
+
+    auto formatValue = ffmpegkit::LazyJsonDocument::findMember(
+        document.get(), MediaInformationBinaryParserKeyFormat);
+    if (formatValue != nullptr) {
+        format = ffmpegkit::FormatFields::from(*formatValue);
+    }
+
+    auto streamArray = ffmpegkit::LazyJsonDocument::findMember(
+        document.get(), MediaInformationBinaryParserKeyStreams);
+    if (streamArray != nullptr && streamArray->IsArray()) {
+        streams.reserve(streamArray->Size());
+        for (rapidjson::SizeType i = 0; i < streamArray->Size(); i++) {
+            streams.emplace_back(
+                ffmpegkit::StreamFields::from((*streamArray)[i]), json, i);
+        }
+    }
+
+    auto chapterArray = ffmpegkit::LazyJsonDocument::findMember(
+        document.get(), MediaInformationBinaryParserKeyChapters);
+    if (chapterArray != nullptr && chapterArray->IsArray()) {
+        chapters.reserve(chapterArray->Size());
+        for (rapidjson::SizeType i = 0; i < chapterArray->Size(); i++) {
+            chapters.emplace_back(
+                ffmpegkit::ChapterFields::from((*chapterArray)[i]), json, i);
+        }
+    }
+
+    return std::make_shared<ffmpegkit::MediaInformation>(
+        format, std::move(streams), std::move(chapters), json);
+}
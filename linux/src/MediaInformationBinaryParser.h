@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_BINARY_PARSER_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_BINARY_PARSER_H
+
+#include "MediaInformation.h"
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace ffmpegkit {
+
+/**
+ * A parser that constructs MediaInformation from FFprobe's binary output,
+ * created with "-of binary". Since the binary output can't be printed to the
+ * logs it is usually written into a buffer registered with
+ * FFmpegKitConfig::registerMemoryOutput, e.g. "-o memory:1".
+ */
+class MediaInformationBinaryParser {
+  public:
+    /**
+     * Extracts <code>MediaInformation</code> from the given FFprobe binary
+     * output.
+     *
+     * @param ffprobeBinaryOutput FFprobe binary output
+     * @return created MediaInformation instance of nullptr if a parsing error
+     * occurs
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformation>
+    from(const std::shared_ptr<std::vector<uint8_t>> ffprobeBinaryOutput);
+
+    /**
+     * Extracts <code>MediaInformation</code> from the given FFprobe binary
+     * output. If a parsing error occurs an std::exception is thrown.
+     *
+     * <p>The output is kept by the media information and must not be
+     * modified afterwards. It is read again only if a key that is not
+     * extracted into fields is requested.
+     *
+     * @param ffprobeBinaryOutput FFprobe binary output
+     * @return created MediaInformation instance
+     */
+    static std::shared_ptr<ffmpegkit::MediaInformation>
+    fromWithError(
+        const std::shared_ptr<std::vector<uint8_t>> ffprobeBinaryOutput);
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_BINARY_PARSER_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationBinaryReader.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char MediaInformationBinaryTag[] = {'F', 'F', 'P', 'B'};
+const uint8_t MediaInformationBinaryVersion = 1;
+
+const uint8_t RecordSectionStart = 0x01;
+const uint8_t RecordSectionEnd = 0x02;
+const uint8_t RecordString = 0x03;
+const uint8_t RecordInteger = 0x04;
+
+} // namespace
+
+ffmpegkit::MediaInformationBinaryReader::MediaInformationBinaryReader(
+    const uint8_t *data, size_t size)
+    : _position{data}, _end{data + size}, _level{-1}, _type{SectionEnd},
+      _flags{0}, _name{nullptr}, _nameLength{0}, _string{nullptr},
+      _stringLength{0}, _integer{0} {
+    if (size < sizeof(MediaInformationBinaryTag) + 1 ||
+        std::memcmp(data, MediaInformationBinaryTag,
+                    sizeof(MediaInformationBinaryTag)) != 0) {
+        throw std::runtime_error("Not a binary FFprobe output");
+    }
+    if (data[sizeof(MediaInformationBinaryTag)] !=
+        MediaInformationBinaryVersion) {
+        throw std::runtime_error("Unsupported binary FFprobe output version");
+    }
+    _position += sizeof(MediaInformationBinaryTag) + 1;
+}
+
+bool ffmpegkit::MediaInformationBinaryReader::next() {
+    // THE LEVEL OF A SECTION END RECORD IS THE LEVEL OF THE SECTION IT CLOSES
+    if (_type == SectionEnd) {
+        _level--;
+    }
+    if (_position == _end) {
+        if (_level >= 0) {
+            throw std::runtime_error("Truncated binary FFprobe output");
+        }
+        return false;
+    }
+
+    _name = nullptr;
+    _nameLength = 0;
+    _string = nullptr;
+    _stringLength = 0;
+    _integer = 0;
+    _flags = 0;
+
+    switch (*_position++) {
+    case RecordSectionStart:
+        if (_position == _end) {
+            throw std::runtime_error("Truncated binary FFprobe output");
+        }
+        _type = SectionStart;
+        _flags = *_position++;
+        _name = readString(&_nameLength);
+        _level++;
+        break;
+    case RecordSectionEnd:
+        if (_level < 0) {
+            throw std::runtime_error("Unbalanced binary FFprobe output");
+        }
+        _type = SectionEnd;
+        break;
+    case RecordString:
+        _type = StringItem;
+        _name = readString(&_nameLength);
+        _string = readString(&_stringLength);
+        break;
+    case RecordInteger: {
+        _type = IntegerItem;
+        _name = readString(&_nameLength);
+        uint64_t value = readVarint();
+        _integer = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+        break;
+    }
+    default:
+        throw std::runtime_error("Invalid binary FFprobe output record");
+    }
+
+    if (_type != SectionStart && _type != SectionEnd && _level < 0) {
+        throw std::runtime_error("Binary FFprobe output item outside sections");
+    }
+
+    return true;
+}
+
+ffmpegkit::MediaInformationBinaryReader::RecordType
+ffmpegkit::MediaInformationBinaryReader::getType() const {
+    return _type;
+}
+
+int ffmpegkit::MediaInformationBinaryReader::getFlags() const {
+    return _flags;
+}
+
+const char *ffmpegkit::MediaInformationBinaryReader::getName() const {
+    return _name;
+}
+
+size_t ffmpegkit::MediaInformationBinaryReader::getNameLength() const {
+    return _nameLength;
+}
+
+const char *ffmpegkit::MediaInformationBinaryReader::getString() const {
+    return _string;
+}
+
+size_t ffmpegkit::MediaInformationBinaryReader::getStringLength() const {
+    return _stringLength;
+}
+
+int64_t ffmpegkit::MediaInformationBinaryReader::getInteger() const {
+    return _integer;
+}
+
+int ffmpegkit::MediaInformationBinaryReader::getLevel() const {
+    return _level;
+}
+
+uint64_t ffmpegkit::MediaInformationBinaryReader::readVarint() {
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (_position == _end) {
+            throw std::runtime_error("Truncated binary FFprobe output");
+        }
+        uint8_t byte = *_position++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    throw std::runtime_error("Invalid binary FFprobe output varint");
+}
+
+const char *ffmpegkit::MediaInformationBinaryReader::readString(
+    size_t *length) {
+    uint64_t stringLength = readVarint();
+
+    // THE TERMINATING NUL IS PART OF THE RECORD
+    if (stringLength >= (uint64_t)(_end - _position) ||
+        _position[stringLength] != 0) {
+        throw std::runtime_error("Invalid binary FFprobe output string");
+    }
+
+    const char *string = (const char *)_position;
+    _position += stringLength + 1;
+    *length = (size_t)stringLength;
+    return string;
+}
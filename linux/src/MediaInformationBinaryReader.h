@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_BINARY_READER_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_BINARY_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ffmpegkit {
+
+/**
+ * Reads the output of FFprobe's binary writer, "-of binary", record by
+ * record.
+ *
+ * <p>The output starts with the "FFPB" tag and a version byte, followed by
+ * section start, section end, string item and integer item records. Strings
+ * are length prefixed and NUL terminated, so names and string values are
+ * returned as pointers into the buffer without being copied. The buffer must
+ * outlive the reader and the strings returned.
+ */
+class MediaInformationBinaryReader {
+  public:
+    enum RecordType { SectionStart, SectionEnd, StringItem, IntegerItem };
+
+    /* section flags */
+    static constexpr int SectionArray = 1;
+    static constexpr int SectionWrapper = 2;
+
+    /**
+     * Creates a reader for the given buffer. If a parsing error occurs an
+     * std::exception is thrown.
+     *
+     * @param data binary output
+     * @param size size of the output in bytes
+     */
+    MediaInformationBinaryReader(const uint8_t *data, size_t size);
+
+    /**
+     * Reads the next record. If a parsing error occurs an std::exception is
+     * thrown.
+     *
+     * @return false at the end of the output
+     */
+    bool next();
+
+    RecordType getType() const;
+
+    /**
+     * Returns the section flags of a section start record.
+     */
+    int getFlags() const;
+
+    /**
+     * Returns the section name of a section start record or the key of an
+     * item record.
+     */
+    const char *getName() const;
+
+    size_t getNameLength() const;
+
+    /**
+     * Returns the value of a string item record.
+     */
+    const char *getString() const;
+
+    size_t getStringLength() const;
+
+    /**
+     * Returns the value of an integer item record.
+     */
+    int64_t getInteger() const;
+
+    /**
+     * Returns the nesting level of the current record, zero for the root
+     * section.
+     */
+    int getLevel() const;
+
+  private:
+    uint64_t readVarint();
+    const char *readString(size_t *length);
+
+    const uint8_t *_position;
+    const uint8_t *_end;
+    int _level;
+    RecordType _type;
+    int _flags;
+    const char *_name;
+    size_t _nameLength;
+    const char *_string;
+    size_t _stringLength;
+    int64_t _integer;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_BINARY_READER_H
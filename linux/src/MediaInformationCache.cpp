@@ -0,0 +1,961 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationCache.h"
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/* THE LAYOUT OF THE CACHE FILE IS
+ *
+ * CacheHeader | CacheSlot * slotCount | records
+ *
+ * A record is the canonical path followed by the kind of the entry and its
+ * payload, the encoded fields or FFprobe's output. Slots form an open
+ * addressing hash table keyed by the path and the kind. Records are appended;
+ * records replaced or invalidated are reclaimed when the file is compacted. */
+
+const char CacheMagic[8] = {'F', 'F', 'K', 'M', 'I', 'C', 'A', 'C'};
+const uint32_t CacheVersion = 6;
+const int64_t CacheMinSize = 1024 * 1024;
+
+const uint64_t SlotEmpty = 0;
+const uint64_t SlotDeleted = 1;
+
+/* ENTRIES OF THE IN-PROCESS PROBE AND OF FFPROBE ARE KEPT APART, EACH IS ONLY
+ * RETURNED TO REQUESTS MADE THE SAME WAY */
+enum EntryKind : uint8_t { EntryFields = 0, EntryFFprobeOutput = 1 };
+const uint8_t EntryKinds[] = {EntryFields, EntryFFprobeOutput};
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t slotCount;
+    uint64_t dataOffset;
+    uint64_t dataEnd;
+    uint64_t entryCount;
+    uint64_t deletedCount;
+    uint64_t clock;
+};
+
+struct CacheSlot {
+    uint64_t hash;
+    uint64_t device;
+    uint64_t inode;
+    int64_t size;
+    int64_t mtime;
+    uint64_t offset;
+    uint32_t pathLength;
+    uint32_t payloadLength;
+    uint64_t lastAccess;
+};
+
+static_assert(sizeof(CacheHeader) == 64, "unexpected cache header size");
+static_assert(sizeof(CacheSlot) == 64, "unexpected cache slot size");
+
+struct FileIdentity {
+    std::string path;
+    uint8_t kind;
+    uint64_t hash;
+    uint64_t device;
+    uint64_t inode;
+    int64_t size;
+    int64_t mtime;
+};
+
+uint64_t hashKey(const std::string &path, const uint8_t kind) {
+    uint64_t hash = UINT64_C(14695981039346656037);
+
+    hash ^= kind;
+    hash *= UINT64_C(1099511628211);
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= UINT64_C(1099511628211);
+    }
+
+    // 0 AND 1 MARK EMPTY AND DELETED SLOTS
+    return hash < 2 ? hash + 2 : hash;
+}
+
+bool canonicalPath(const std::string &mediaPath, std::string *path) {
+    std::string localPath = mediaPath;
+    char resolved[PATH_MAX];
+
+    if (localPath.compare(0, 5, "file:") == 0) {
+        localPath = localPath.substr(5);
+    }
+    if (realpath(localPath.c_str(), resolved) != NULL) {
+        *path = resolved;
+        return true;
+    }
+
+    // A FILE THAT NO LONGER EXISTS CAN STILL BE INVALIDATED
+    if (!localPath.empty() && localPath[0] == '/') {
+        *path = localPath;
+        return true;
+    }
+
+    return false;
+}
+
+void identify(const ffmpegkit::MediaInformationCache::FileVersion &version,
+              const uint8_t kind, FileIdentity *identity) {
+    identity->path = version.path;
+    identity->kind = kind;
+    identity->hash = hashKey(version.path, kind);
+    identity->device = version.device;
+    identity->inode = version.inode;
+    identity->size = version.size;
+    identity->mtime = version.mtime;
+}
+
+bool sameVersion(const ffmpegkit::MediaInformationCache::FileVersion &a,
+                 const ffmpegkit::MediaInformationCache::FileVersion &b) {
+    return a.path == b.path && a.device == b.device && a.inode == b.inode &&
+           a.size == b.size && a.mtime == b.mtime;
+}
+
+CacheHeader *headerOf(uint8_t *base) { return (CacheHeader *)base; }
+
+CacheSlot *slotsOf(uint8_t *base) {
+    return (CacheSlot *)(base + sizeof(CacheHeader));
+}
+
+bool validHeader(const CacheHeader *header, const uint64_t size) {
+    return std::memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) == 0 &&
+           header->version == CacheVersion && header->slotCount > 0 &&
+           (header->slotCount & (header->slotCount - 1)) == 0 &&
+           header->slotCount <= size / sizeof(CacheSlot) &&
+           header->dataOffset ==
+               sizeof(CacheHeader) + header->slotCount * sizeof(CacheSlot) &&
+           header->dataOffset <= header->dataEnd && header->dataEnd <= size;
+}
+
+void initHeader(CacheHeader *header, const uint64_t size) {
+    uint64_t slotCount = 64;
+
+    // ABOUT ONE SLOT FOR EACH 2 KB OF RECORDS
+    while (slotCount * 2 <= size / 2048) {
+        slotCount *= 2;
+    }
+
+    std::memset(header, 0, sizeof(CacheHeader));
+    std::memcpy(header->magic, CacheMagic, sizeof(CacheMagic));
+    header->version = CacheVersion;
+    header->slotCount = slotCount;
+    header->dataOffset = sizeof(CacheHeader) + slotCount * sizeof(CacheSlot);
+    header->dataEnd = header->dataOffset;
+}
+
+/**
+ * Returns the slot of the path or nullptr. If freeSlot is given it is set to
+ * the first slot where the path can be inserted.
+ */
+CacheSlot *findSlot(uint8_t *base, const size_t size,
+                    const FileIdentity &identity, CacheSlot **freeSlot) {
+    CacheHeader *header = headerOf(base);
+    CacheSlot *slots = slotsOf(base);
+    uint64_t mask = header->slotCount - 1;
+    uint64_t index = identity.hash & mask;
+
+    for (uint64_t n = 0; n < header->slotCount;
+         n++, index = (index + 1) & mask) {
+        CacheSlot *slot = &slots[index];
+
+        if (slot->hash == SlotEmpty || slot->hash == SlotDeleted) {
+            if (freeSlot != nullptr && *freeSlot == nullptr) {
+                *freeSlot = slot;
+            }
+            if (slot->hash == SlotEmpty) {
+                return nullptr;
+            }
+        } else if (slot->hash == identity.hash &&
+                   slot->pathLength == identity.path.size() &&
+                   slot->payloadLength > 0 && slot->offset <= size &&
+                   size - slot->offset >=
+                       (uint64_t)slot->pathLength + slot->payloadLength &&
+                   std::memcmp(base + slot->offset, identity.path.data(),
+                               slot->pathLength) == 0 &&
+                   base[slot->offset + slot->pathLength] == identity.kind) {
+            return slot;
+        }
+    }
+
+    return nullptr;
+}
+
+class PayloadWriter {
+  public:
+    explicit PayloadWriter(std::string *data) : _data{data} {}
+
+    void operator()(const bool &value) { putByte(value ? 1 : 0); }
+
+    void operator()(const uint32_t &value) { put(&value, sizeof(value)); }
+
+    void operator()(const ffmpegkit::Optional<int64_t> &value) {
+        putByte(value.hasValue());
+        if (value) {
+            put(&value.value(), sizeof(int64_t));
+        }
+    }
+
+    void operator()(const ffmpegkit::Optional<double> &value) {
+        putByte(value.hasValue());
+        if (value) {
+            put(&value.value(), sizeof(double));
+        }
+    }
+
+    void operator()(const ffmpegkit::Optional<std::string> &value) {
+        putByte(value.hasValue());
+        if (value) {
+            putString(value.value());
+        }
+    }
+
+    void operator()(const ffmpegkit::InternedString &value) {
+        putByte(value.hasValue());
+        if (value) {
+            putString(value.value());
+        }
+    }
+
+    void operator()(const ffmpegkit::TagList &tags) {
+        putCount(tags.size());
+        for (auto &tag : tags) {
+            putString(tag.first.value());
+            putString(tag.second);
+        }
+    }
+
+    void operator()(const std::vector<ffmpegkit::SideDataFields> &list) {
+        putCount(list.size());
+        for (auto &sideData : list) {
+            (*this)(sideData.type);
+            putCount(sideData.values.size());
+            for (auto &value : sideData.values) {
+                (*this)(value.name);
+                (*this)(value.integer);
+                putString(value.text);
+            }
+        }
+    }
+
+    void putCount(const size_t count) {
+        uint32_t value = (uint32_t)count;
+        put(&value, sizeof(value));
+    }
+
+  private:
+    void putByte(const uint8_t value) { put(&value, 1); }
+
+    void putString(const std::string &value) {
+        putCount(value.size());
+        put(value.data(), value.size());
+    }
+
+    void put(const void *data, const size_t size) {
+        _data->append((const char *)data, size);
+    }
+
+    std::string *_data;
+};
+
+class PayloadReader {
+  public:
+    PayloadReader(const uint8_t *data, const size_t size)
+        : _data{data}, _end{data + size}, _valid{true} {}
+
+    bool isValid() const { return _valid; }
+
+    void operator()(bool &value) { value = getByte() != 0; }
+
+    void operator()(uint32_t &value) { get(&value, sizeof(value)); }
+
+    void operator()(ffmpegkit::Optional<int64_t> &value) {
+        int64_t number;
+        if (getByte() && get(&number, sizeof(number))) {
+            value = number;
+        }
+    }
+
+    void operator()(ffmpegkit::Optional<double> &value) {
+        double number;
+        if (getByte() && get(&number, sizeof(number))) {
+            value = number;
+        }
+    }
+
+    void operator()(ffmpegkit::Optional<std::string> &value) {
+        const char *text;
+        uint32_t length;
+        if (getByte() && getString(&text, &length)) {
+            value = std::string(text, length);
+        }
+    }
+
+    void operator()(ffmpegkit::InternedString &value) {
+        const char *text;
+        uint32_t length;
+        if (getByte() && getString(&text, &length)) {
+            value = ffmpegkit::InternedString::intern(text, length);
+        }
+    }
+
+    void operator()(ffmpegkit::TagList &tags) {
+        uint32_t count = getCount(2 * sizeof(uint32_t));
+        const char *name;
+        const char *value;
+        uint32_t nameLength;
+        uint32_t valueLength;
+
+        tags.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            if (!getString(&name, &nameLength) ||
+                !getString(&value, &valueLength)) {
+                return;
+            }
+            tags.emplace_back(ffmpegkit::TagName(name, nameLength),
+                              std::string(value, valueLength));
+        }
+    }
+
+    void operator()(std::vector<ffmpegkit::SideDataFields> &list) {
+        uint32_t count = getCount(1 + sizeof(uint32_t));
+        const char *text;
+        uint32_t length;
+
+        list.resize(count);
+        for (auto &sideData : list) {
+            (*this)(sideData.type);
+            sideData.values.resize(getCount(2 + sizeof(uint32_t)));
+            for (auto &value : sideData.values) {
+                (*this)(value.name);
+                (*this)(value.integer);
+                if (!getString(&text, &length)) {
+                    return;
+                }
+                value.text = std::string(text, length);
+            }
+        }
+    }
+
+    /**
+     * Reads a count of items which take at least itemSize bytes each.
+     */
+    uint32_t getCount(const size_t itemSize) {
+        uint32_t count = 0;
+        if (get(&count, sizeof(count)) &&
+            count > (size_t)(_end - _data) / itemSize) {
+            _valid = false;
+            count = 0;
+        }
+        return count;
+    }
+
+  private:
+    uint8_t getByte() {
+        uint8_t value = 0;
+        get(&value, 1);
+        return value;
+    }
+
+    bool getString(const char **text, uint32_t *length) {
+        if (!get(length, sizeof(*length)) ||
+            *length > (size_t)(_end - _data)) {
+            _valid = false;
+            return false;
+        }
+        *text = (const char *)_data;
+        _data += *length;
+        return true;
+    }
+
+    bool get(void *data, const size_t size) {
+        if (!_valid || size > (size_t)(_end - _data)) {
+            _valid = false;
+            return false;
+        }
+        std::memcpy(data, _data, size);
+        _data += size;
+        return true;
+    }
+
+    const uint8_t *_data;
+    const uint8_t *_end;
+    bool _valid;
+};
+
+/* THE ORDER OF THE FIELDS IS PART OF THE FILE FORMAT, CHANGING IT REQUIRES A
+ * NEW CacheVersion */
+
+template <typename Fields, typename Visitor>
+void visitFormat(Fields &fields, Visitor &visitor) {
+    visitor(fields.filename);
+    visitor(fields.formatName);
+    visitor(fields.formatLongName);
+    visitor(fields.nbStreams);
+    visitor(fields.nbPrograms);
+    visitor(fields.probeScore);
+    visitor(fields.startTime);
+    visitor(fields.duration);
+    visitor(fields.size);
+    visitor(fields.bitRate);
+    visitor(fields.tags);
+    visitor(fields.lossy);
+    visitor(fields.estimated);
+}
+
+template <typename Fields, typename Visitor>
+void visitStream(Fields &fields, Visitor &visitor) {
+    visitor(fields.index);
+    visitor(fields.type);
+    visitor(fields.codec);
+    visitor(fields.codecLong);
+    visitor(fields.profile);
+    visitor(fields.codecTag);
+    visitor(fields.codecTagValue);
+    visitor(fields.id);
+    visitor(fields.bitRate);
+    visitor(fields.bitsPerRawSample);
+    visitor(fields.nbFrames);
+    visitor(fields.extradataSize);
+    visitor(fields.disposition);
+    visitor(fields.timeBase);
+    visitor(fields.codecTimeBase);
+    visitor(fields.startPts);
+    visitor(fields.startTime);
+    visitor(fields.durationTs);
+    visitor(fields.duration);
+    visitor(fields.format);
+    visitor(fields.width);
+    visitor(fields.height);
+    visitor(fields.codedWidth);
+    visitor(fields.codedHeight);
+    visitor(fields.hasBFrames);
+    visitor(fields.refs);
+    visitor(fields.level);
+    visitor(fields.sampleAspectRatio);
+    visitor(fields.displayAspectRatio);
+    visitor(fields.averageFrameRate);
+    visitor(fields.realFrameRate);
+    visitor(fields.fieldOrder);
+    visitor(fields.colorRange);
+    visitor(fields.colorSpace);
+    visitor(fields.colorTransfer);
+    visitor(fields.colorPrimaries);
+    visitor(fields.chromaLocation);
+    visitor(fields.sampleRate);
+    visitor(fields.sampleFormat);
+    visitor(fields.channels);
+    visitor(fields.channelLayout);
+    visitor(fields.bitsPerSample);
+    visitor(fields.initialPadding);
+    visitor(fields.tags);
+    visitor(fields.sideData);
+    visitor(fields.lossy);
+    visitor(fields.estimated);
+}
+
+template <typename Fields, typename Visitor>
+void visitChapter(Fields &fields, Visitor &visitor) {
+    visitor(fields.id);
+    visitor(fields.timeBase);
+    visitor(fields.start);
+    visitor(fields.startTime);
+    visitor(fields.end);
+    visitor(fields.endTime);
+    visitor(fields.tags);
+    visitor(fields.lossy);
+}
+
+std::string encode(const ffmpegkit::MediaInformation &mediaInformation) {
+    std::string data;
+    PayloadWriter writer(&data);
+
+    visitFormat(mediaInformation.getFormatFields(), writer);
+    writer.putCount(mediaInformation.getStreamList().size());
+    for (auto &stream : mediaInformation.getStreamList()) {
+        visitStream(stream.getFields(), writer);
+    }
+    writer.putCount(mediaInformation.getChapterList().size());
+    for (auto &chapter : mediaInformation.getChapterList()) {
+        visitChapter(chapter.getFields(), writer);
+    }
+
+    return data;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformation> decode(const uint8_t *data,
+                                                    const size_t size) {
+    PayloadReader reader(data, size);
+    ffmpegkit::FormatFields format;
+    std::vector<ffmpegkit::StreamFields> streams;
+    std::vector<ffmpegkit::ChapterFields> chapters;
+
+    visitFormat(format, reader);
+    streams.resize(reader.getCount(1));
+    for (auto &stream : streams) {
+        visitStream(stream, reader);
+    }
+    chapters.resize(reader.getCount(1));
+    for (auto &chapter : chapters) {
+        visitChapter(chapter, reader);
+    }
+
+    if (!reader.isValid()) {
+        return nullptr;
+    }
+
+    return ffmpegkit::MediaInformation::fromFields(format, streams, chapters);
+}
+
+void lockFile(const int fd, const int operation) {
+    while (flock(fd, operation) != 0 && errno == EINTR) {
+    }
+}
+
+} // namespace
+
+std::shared_ptr<ffmpegkit::MediaInformationCache>
+ffmpegkit::MediaInformationCache::open(const std::string &path,
+                                       const int64_t maxSize) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    CacheHeader header;
+    struct stat st;
+    uint8_t *base;
+
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // ONLY ONE PROCESS CREATES OR REPAIRS THE FILE
+    lockFile(fd, LOCK_EX);
+
+    if (fstat(fd, &st) != 0) {
+        lockFile(fd, LOCK_UN);
+        ::close(fd);
+        return nullptr;
+    }
+
+    uint64_t size = (uint64_t)st.st_size;
+    if (size < sizeof(header) ||
+        pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+        !validHeader(&header, size)) {
+        size = (uint64_t)std::max(maxSize, CacheMinSize);
+        initHeader(&header, size);
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)size) != 0 ||
+            pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+            lockFile(fd, LOCK_UN);
+            ::close(fd);
+            return nullptr;
+        }
+    }
+
+    base = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                           0);
+
+    lockFile(fd, LOCK_UN);
+
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    return std::shared_ptr<ffmpegkit::MediaInformationCache>(
+        new ffmpegkit::MediaInformationCache(fd, base, size));
+}
+
+ffmpegkit::MediaInformationCache::MediaInformationCache(const int fd,
+                                                        uint8_t *base,
+                                                        const size_t size)
+    : _fd{fd}, _base{base}, _size{size}, _valid{true}, _readers{0} {
+    pthread_rwlock_init(&_lock, NULL);
+}
+
+ffmpegkit::MediaInformationCache::~MediaInformationCache() {
+    if (_base != nullptr) {
+        munmap(_base, _size);
+    }
+    ::close(_fd);
+    pthread_rwlock_destroy(&_lock);
+}
+
+std::shared_ptr<ffmpegkit::MediaInformationCache::FileVersion>
+ffmpegkit::MediaInformationCache::getFileVersion(const std::string &mediaPath) {
+    auto version = std::make_shared<FileVersion>();
+    struct stat st;
+
+    if (!canonicalPath(mediaPath, &version->path) ||
+        stat(version->path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return nullptr;
+    }
+
+    version->device = (uint64_t)st.st_dev;
+    version->inode = (uint64_t)st.st_ino;
+    version->size = (int64_t)st.st_size;
+    version->mtime =
+        (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+
+    return version;
+}
+
+std::shared_ptr<ffmpegkit::MediaInformation>
+ffmpegkit::MediaInformationCache::get(const std::string &mediaPath) {
+    std::string payload;
+
+    if (!lookup(mediaPath, EntryFields, &payload)) {
+        return nullptr;
+    }
+
+    return decode((const uint8_t *)payload.data(), payload.size());
+}
+
+void ffmpegkit::MediaInformationCache::put(
+    const std::shared_ptr<FileVersion> version,
+    const std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation) {
+
+    // PARTIAL RESULTS WOULD BE SERVED TO REQUESTS EXPECTING COMPLETE ONES
+    if (mediaInformation == nullptr ||
+        (mediaInformation->getFormatFields().estimated &
+         ffmpegkit::EstimatedCodecParameters)) {
+        return;
+    }
+
+    store(version, EntryFields, encode(*mediaInformation));
+}
+
+std::shared_ptr<std::string>
+ffmpegkit::MediaInformationCache::getFFprobeOutput(
+    const std::string &mediaPath) {
+    auto output = std::make_shared<std::string>();
+
+    if (!lookup(mediaPath, EntryFFprobeOutput, output.get())) {
+        return nullptr;
+    }
+
+    return output;
+}
+
+void ffmpegkit::MediaInformationCache::putFFprobeOutput(
+    const std::shared_ptr<FileVersion> version, const std::string &output) {
+    store(version, EntryFFprobeOutput, output);
+}
+
+void ffmpegkit::MediaInformationCache::invalidate(
+    const std::string &mediaPath) {
+    FileIdentity identity;
+
+    if (!canonicalPath(mediaPath, &identity.path)) {
+        return;
+    }
+
+    if (lockExclusive()) {
+        for (uint8_t kind : EntryKinds) {
+            identity.kind = kind;
+            identity.hash = hashKey(identity.path, kind);
+
+            CacheSlot *slot = findSlot(_base, _size, identity, nullptr);
+            if (slot != nullptr) {
+                slot->hash = SlotDeleted;
+                headerOf(_base)->entryCount--;
+                headerOf(_base)->deletedCount++;
+            }
+        }
+    }
+
+    unlockExclusive();
+}
+
+void ffmpegkit::MediaInformationCache::clear() {
+    if (lockExclusive()) {
+        CacheHeader *header = headerOf(_base);
+        std::memset(slotsOf(_base), 0, header->slotCount * sizeof(CacheSlot));
+        header->dataEnd = header->dataOffset;
+        header->entryCount = 0;
+        header->deletedCount = 0;
+    }
+
+    unlockExclusive();
+}
+
+int64_t ffmpegkit::MediaInformationCache::getEntryCount() {
+    int64_t entryCount = 0;
+
+    if (lockShared()) {
+        entryCount = (int64_t)headerOf(_base)->entryCount;
+    }
+    unlockShared();
+
+    return entryCount;
+}
+
+/**
+ * Copies the payload of the entry of the given kind into payload and returns
+ * whether the entry was found and the file is unchanged since it was cached.
+ */
+bool ffmpegkit::MediaInformationCache::lookup(const std::string &mediaPath,
+                                              const uint8_t kind,
+                                              std::string *payload) {
+    FileIdentity identity;
+    bool found = false;
+
+    auto version = getFileVersion(mediaPath);
+    if (version == nullptr) {
+        return false;
+    }
+    identify(*version, kind, &identity);
+
+    if (lockShared()) {
+        CacheSlot *slot = findSlot(_base, _size, identity, nullptr);
+        if (slot != nullptr && slot->device == identity.device &&
+            slot->inode == identity.inode && slot->size == identity.size &&
+            slot->mtime == identity.mtime) {
+            // THE PAYLOAD STARTS AFTER THE KIND
+            payload->assign(
+                (const char *)_base + slot->offset + slot->pathLength + 1,
+                slot->payloadLength - 1);
+            found = true;
+
+            // READERS ONLY UPDATE THE ACCESS ORDER USED BY EVICTION
+            uint64_t clock = __atomic_add_fetch(&headerOf(_base)->clock, 1,
+                                                __ATOMIC_RELAXED);
+            __atomic_store_n(&slot->lastAccess, clock, __ATOMIC_RELAXED);
+        }
+    }
+
+    unlockShared();
+
+    return found;
+}
+
+/**
+ * Stores payload as the entry of the given kind for version, replacing the
+ * previous one, unless the file has changed since version was taken.
+ */
+void ffmpegkit::MediaInformationCache::store(
+    const std::shared_ptr<FileVersion> version, const uint8_t kind,
+    const std::string &payload) {
+    FileIdentity identity;
+
+    if (version == nullptr || payload.size() >= UINT32_MAX) {
+        return;
+    }
+
+    // A PAYLOAD COMPUTED FROM AN OLDER VERSION WOULD BE SERVED FOR THE NEW ONE
+    auto current = getFileVersion(version->path);
+    if (current == nullptr || !sameVersion(*version, *current)) {
+        return;
+    }
+    identify(*version, kind, &identity);
+
+    uint64_t recordLength = identity.path.size() + 1 + payload.size();
+
+    if (!lockExclusive()) {
+        unlockExclusive();
+        return;
+    }
+
+    CacheHeader *header = headerOf(_base);
+    for (int attempt = 0; attempt < 2; attempt++) {
+        CacheSlot *freeSlot = nullptr;
+        CacheSlot *slot = findSlot(_base, _size, identity, &freeSlot);
+        bool fits = recordLength <= _size - header->dataEnd;
+
+        // KEEP THE LOAD FACTOR OF THE TABLE BELOW 3/4
+        bool room = slot != nullptr ||
+                    (freeSlot != nullptr &&
+                     (header->entryCount + header->deletedCount + 1) * 4 <=
+                         header->slotCount * 3);
+
+        if (fits && room) {
+            if (slot == nullptr) {
+                slot = freeSlot;
+                if (slot->hash == SlotDeleted) {
+                    header->deletedCount--;
+                }
+                header->entryCount++;
+            }
+
+            uint8_t *record = _base + header->dataEnd;
+            std::memcpy(record, identity.path.data(), identity.path.size());
+            record[identity.path.size()] = kind;
+            std::memcpy(record + identity.path.size() + 1, payload.data(),
+                        payload.size());
+
+            slot->hash = identity.hash;
+            slot->device = identity.device;
+            slot->inode = identity.inode;
+            slot->size = identity.size;
+            slot->mtime = identity.mtime;
+            slot->offset = header->dataEnd;
+            slot->pathLength = (uint32_t)identity.path.size();
+            slot->payloadLength = (uint32_t)payload.size() + 1;
+            slot->lastAccess = ++header->clock;
+            header->dataEnd += recordLength;
+            break;
+        } else if (attempt == 0) {
+            compact();
+        }
+    }
+
+    unlockExclusive();
+}
+
+/**
+ * Maps the file again if another process has resized it since it was mapped,
+ * e.g. when it was created again by a different version, and returns whether
+ * its header is valid. Must be called with the file lock held, while no
+ * thread of this process uses the mapping.
+ */
+bool ffmpegkit::MediaInformationCache::remap() {
+    struct stat st;
+
+    if (fstat(_fd, &st) != 0) {
+        return false;
+    }
+
+    if ((uint64_t)st.st_size != _size) {
+        if (_base != nullptr) {
+            munmap(_base, _size);
+        }
+        _base = nullptr;
+        _size = 0;
+
+        if ((uint64_t)st.st_size < sizeof(CacheHeader)) {
+            return false;
+        }
+
+        void *base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) {
+            return false;
+        }
+        _base = (uint8_t *)base;
+        _size = (size_t)st.st_size;
+    }
+
+    return validHeader(headerOf(_base), _size);
+}
+
+bool ffmpegkit::MediaInformationCache::lockShared() {
+    pthread_rwlock_rdlock(&_lock);
+
+    // THE FILE CAN ONLY CHANGE WHILE NO THREAD OF THIS PROCESS HOLDS THE LOCK
+    std::lock_guard<std::mutex> lock(_readerLock);
+    if (_readers++ == 0) {
+        lockFile(_fd, LOCK_SH);
+        _valid = remap();
+    }
+
+    return _valid;
+}
+
+void ffmpegkit::MediaInformationCache::unlockShared() {
+    {
+        std::lock_guard<std::mutex> lock(_readerLock);
+        if (--_readers == 0) {
+            lockFile(_fd, LOCK_UN);
+        }
+    }
+
+    pthread_rwlock_unlock(&_lock);
+}
+
+bool ffmpegkit::MediaInformationCache::lockExclusive() {
+    pthread_rwlock_wrlock(&_lock);
+    lockFile(_fd, LOCK_EX);
+    _valid = remap();
+
+    return _valid;
+}
+
+void ffmpegkit::MediaInformationCache::unlockExclusive() {
+    lockFile(_fd, LOCK_UN);
+    pthread_rwlock_unlock(&_lock);
+}
+
+/**
+ * Keeps the most recently used entries which fit in half of the file and
+ * drops the others. Must be called with the exclusive lock held.
+ */
+void ffmpegkit::MediaInformationCache::compact() {
+    struct Entry {
+        CacheSlot slot;
+        std::string record;
+    };
+    CacheHeader *header = headerOf(_base);
+    CacheSlot *slots = slotsOf(_base);
+    std::vector<Entry> entries;
+
+    for (uint64_t i = 0; i < header->slotCount; i++) {
+        CacheSlot &slot = slots[i];
+        uint64_t length = (uint64_t)slot.pathLength + slot.payloadLength;
+        if (slot.hash != SlotEmpty && slot.hash != SlotDeleted &&
+            slot.offset >= header->dataOffset && slot.offset <= _size &&
+            length <= _size - slot.offset) {
+            entries.push_back(
+                Entry{slot, std::string((const char *)_base + slot.offset,
+                                        length)});
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                  return a.slot.lastAccess > b.slot.lastAccess;
+              });
+
+    std::memset(slots, 0, header->slotCount * sizeof(CacheSlot));
+    header->dataEnd = header->dataOffset;
+    header->entryCount = 0;
+    header->deletedCount = 0;
+
+    uint64_t dataBudget = (_size - header->dataOffset) / 2;
+    uint64_t mask = header->slotCount - 1;
+    for (auto &entry : entries) {
+        if (entry.record.size() > dataBudget ||
+            header->entryCount >= header->slotCount / 2) {
+            break;
+        }
+
+        uint64_t index = entry.slot.hash & mask;
+        while (slots[index].hash != SlotEmpty) {
+            index = (index + 1) & mask;
+        }
+
+        std::memcpy(_base + header->dataEnd, entry.record.data(),
+                    entry.record.size());
+        slots[index] = entry.slot;
+        slots[index].offset = header->dataEnd;
+        header->dataEnd += entry.record.size();
+        header->entryCount++;
+        dataBudget -= entry.record.size();
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_CACHE_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_CACHE_H
+
+#include "MediaInformation.h"
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <stdint.h>
+#include <string>
+
+namespace ffmpegkit {
+
+/**
+ * A persistent cache of media information, stored in a memory mapped file
+ * that any number of processes can use at the same time.
+ *
+ * <p>Entries are keyed by the canonical path of a local file and are only
+ * returned while the size, modification time and inode of the file are
+ * unchanged. The file has a fixed size; when it is full the least recently
+ * used entries are evicted.
+ *
+ * <p>Results of the in-process probe and of FFprobe are stored as separate
+ * entries and each is only returned to requests made the same way. For the
+ * in-process probe only the typed fields of media information are stored;
+ * for FFprobe its json output is stored, so media information read from the
+ * cache is the same as the one of a new FFprobe run.
+ *
+ * <p>The file is checked under the file lock before each access and mapped
+ * again if another process has created it again with a different size. While
+ * it is not valid, e.g. after a different version created it again, lookups
+ * miss and nothing is stored.
+ */
+class MediaInformationCache {
+  public:
+    static constexpr int64_t DefaultMaxSize = 64 * 1024 * 1024;
+
+    /**
+     * A version of a local file, identified by its canonical path, device,
+     * inode, size and modification time.
+     */
+    struct FileVersion {
+        std::string path;
+        uint64_t device;
+        uint64_t inode;
+        int64_t size;
+        int64_t mtime;
+    };
+
+    /**
+     * Returns the current version of the file at mediaPath or nullptr if it
+     * is not a local file. It must be taken before the file is probed, so
+     * that a file modified during the probe is not cached with the result of
+     * its previous version.
+     */
+    static std::shared_ptr<FileVersion>
+    getFileVersion(const std::string &mediaPath);
+
+    /**
+     * Opens the cache file at path, creating it if it does not exist.
+     *
+     * @param path    path of the cache file
+     * @param maxSize size of the cache file in bytes, used only when the file
+     * is created
+     * @return cache or nullptr if the file can not be opened
+     */
+    static std::shared_ptr<MediaInformationCache>
+    open(const std::string &path, const int64_t maxSize);
+
+    ~MediaInformationCache();
+
+    /**
+     * Returns the media information of the file at mediaPath stored by the
+     * in-process probe or nullptr if it is not cached or the file has changed
+     * since it was cached.
+     */
+    std::shared_ptr<ffmpegkit::MediaInformation>
+    get(const std::string &mediaPath);
+
+    /**
+     * Caches the media information created by the in-process probe for the
+     * given version of a file. Nothing is stored if the file has changed
+     * since the version was taken, if version is nullptr or if the result
+     * comes from a quick or interrupted stream analysis.
+     */
+    void
+    put(const std::shared_ptr<FileVersion> version,
+        const std::shared_ptr<ffmpegkit::MediaInformation> mediaInformation);
+
+    /**
+     * Returns the json output of FFprobe for the file at mediaPath or nullptr
+     * if it is not cached or the file has changed since it was cached.
+     */
+    std::shared_ptr<std::string>
+    getFFprobeOutput(const std::string &mediaPath);
+
+    /**
+     * Caches the json output of FFprobe for the given version of a file.
+     * Nothing is stored if the file has changed since the version was taken
+     * or if version is nullptr.
+     */
+    void putFFprobeOutput(const std::shared_ptr<FileVersion> version,
+                          const std::string &output);
+
+    /**
+     * Removes the entries of the file at mediaPath.
+     */
+    void invalidate(const std::string &mediaPath);
+
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    /**
+     * Returns the number of entries cached.
+     */
+    int64_t getEntryCount();
+
+  private:
+    MediaInformationCache(const int fd, uint8_t *base, const size_t size);
+
+    bool lookup(const std::string &mediaPath, const uint8_t kind,
+                std::string *payload);
+    void store(const std::shared_ptr<FileVersion> version, const uint8_t kind,
+               const std::string &payload);
+    bool remap();
+    bool lockShared();
+    void unlockShared();
+    bool lockExclusive();
+    void unlockExclusive();
+    void compact();
+
+    int _fd;
+    uint8_t *_base;
+    size_t _size;
+
+    /* whether the file was valid when the lock was taken */
+    bool _valid;
+
+    /* threads of this process share one file lock, which is held in shared
+     * mode while at least one of them reads */
+    pthread_rwlock_t _lock;
+    std::mutex _readerLock;
+    int _readers;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_CACHE_H
@@ -0,0 +1,888 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+#include "MediaInformationFields.h"
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+std::mutex &internLock() {
+    static std::mutex *lock = new std::mutex();
+    return *lock;
+}
+
+std::unordered_set<std::string> &internPool() {
+    static std::unordered_set<std::string> *pool =
+        new std::unordered_set<std::string>();
+    return *pool;
+}
+
+/**
+ * Returns whether the tag name is one of those commonly written by muxers and
+ * encoders, which are interned.
+ */
+bool isKnownTagName(const std::string &name) {
+    static const std::unordered_set<std::string> *names =
+        new std::unordered_set<std::string>{"album",
+                                            "album_artist",
+                                            "artist",
+                                            "BPS",
+                                            "comment",
+                                            "compatible_brands",
+                                            "composer",
+                                            "copyright",
+                                            "creation_time",
+                                            "date",
+                                            "description",
+                                            "disc",
+                                            "DURATION",
+                                            "encoder",
+                                            "ENCODER",
+                                            "filename",
+                                            "genre",
+                                            "handler_name",
+                                            "language",
+                                            "major_brand",
+                                            "mimetype",
+                                            "minor_version",
+                                            "NUMBER_OF_BYTES",
+                                            "NUMBER_OF_FRAMES",
+                                            "publisher",
+                                            "rotate",
+                                            "service_name",
+                                            "service_provider",
+                                            "timecode",
+                                            "title",
+                                            "track",
+                                            "variant_bitrate",
+                                            "vendor_id",
+                                            "_STATISTICS_TAGS",
+                                            "_STATISTICS_WRITING_APP",
+                                            "_STATISTICS_WRITING_DATE_UTC"};
+    return names->count(name) > 0;
+}
+
+/**
+ * Parses an integer printed by FFprobe. Rejects anything else, e.g. values
+ * printed with units.
+ */
+bool parseInteger(const char *text, size_t length, int64_t *result) {
+    size_t i = 0;
+    bool negative = false;
+    uint64_t value = 0;
+
+    if (i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = (text[i] == '-');
+        i++;
+    }
+    if (i == length) {
+        return false;
+    }
+    for (; i < length; i++) {
+        if (text[i] < '0' || text[i] > '9' ||
+            value > (UINT64_C(1) << 63) / 10) {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    if (value > (negative ? (UINT64_C(1) << 63) : (UINT64_C(1) << 63) - 1)) {
+        return false;
+    }
+
+    *result = negative ? (int64_t)(0 - value) : (int64_t)value;
+    return true;
+}
+
+/**
+ * Parses a decimal printed by FFprobe with "%f". Does not depend on the
+ * current locale.
+ */
+bool parseDecimal(const char *text, size_t length, double *result) {
+    size_t i = 0;
+    bool negative = false;
+    bool digits = false;
+    double value = 0;
+
+    if (i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = (text[i] == '-');
+        i++;
+    }
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; i++) {
+        value = value * 10 + (text[i] - '0');
+        digits = true;
+    }
+    if (i < length && text[i] == '.') {
+        double scale = 1;
+        int64_t fraction = 0;
+        for (i++; i < length && text[i] >= '0' && text[i] <= '9'; i++) {
+            if (scale < 1e18) {
+                fraction = fraction * 10 + (text[i] - '0');
+                scale *= 10;
+            }
+            digits = true;
+        }
+        value += fraction / scale;
+    }
+    if (!digits || i != length) {
+        return false;
+    }
+
+    *result = negative ? -value : value;
+    return true;
+}
+
+ffmpegkit::Optional<int64_t> toInteger(const rapidjson::Value &value,
+                                       bool *lossy) {
+    int64_t result;
+
+    if (value.IsInt64()) {
+        return value.GetInt64();
+    } else if (value.IsString()) {
+        if (parseInteger(value.GetString(), value.GetStringLength(),
+                         &result)) {
+            return result;
+        }
+        *lossy = true;
+    }
+    return ffmpegkit::Optional<int64_t>();
+}
+
+/**
+ * Parses a number FFprobe prints in hex with a 0x prefix, e.g. codec_tag.
+ */
+ffmpegkit::Optional<int64_t> toHexInteger(const rapidjson::Value &value,
+                                          bool *lossy) {
+    const char *text;
+    size_t length;
+    int64_t result = 0;
+
+    if (!value.IsString()) {
+        return ffmpegkit::Optional<int64_t>();
+    }
+
+    text = value.GetString();
+    length = value.GetStringLength();
+    if (length < 3 || length > 18 || text[0] != '0' ||
+        (text[1] != 'x' && text[1] != 'X')) {
+        *lossy = true;
+        return ffmpegkit::Optional<int64_t>();
+    }
+    for (size_t i = 2; i < length; i++) {
+        int digit;
+        if (text[i] >= '0' && text[i] <= '9') {
+            digit = text[i] - '0';
+        } else if (text[i] >= 'a' && text[i] <= 'f') {
+            digit = text[i] - 'a' + 10;
+        } else if (text[i] >= 'A' && text[i] <= 'F') {
+            digit = text[i] - 'A' + 10;
+        } else {
+            *lossy = true;
+            return ffmpegkit::Optional<int64_t>();
+        }
+        result = (int64_t)(((uint64_t)result << 4) | (uint64_t)digit);
+    }
+
+    return result;
+}
+
+ffmpegkit::Optional<double> toDecimal(const rapidjson::Value &value,
+                                      bool *lossy) {
+    double result;
+
+    if (value.IsNumber()) {
+        return value.GetDouble();
+    } else if (value.IsString()) {
+        if (parseDecimal(value.GetString(), value.GetStringLength(),
+                         &result)) {
+            return result;
+        }
+        *lossy = true;
+    }
+    return ffmpegkit::Optional<double>();
+}
+
+ffmpegkit::InternedString toInterned(const rapidjson::Value &value) {
+    if (value.IsString()) {
+        return ffmpegkit::InternedString::intern(value.GetString(),
+                                                 value.GetStringLength());
+    }
+    return ffmpegkit::InternedString();
+}
+
+ffmpegkit::TagList toTags(const rapidjson::Value &value) {
+    ffmpegkit::TagList tags;
+
+    if (value.IsObject()) {
+        tags.reserve(value.MemberCount());
+        for (auto member = value.MemberBegin(); member != value.MemberEnd();
+             ++member) {
+            if (member->value.IsString()) {
+                tags.emplace_back(
+                    ffmpegkit::TagName(member->name.GetString(),
+                                       member->name.GetStringLength()),
+                    std::string(member->value.GetString(),
+                                member->value.GetStringLength()));
+            }
+        }
+    }
+
+    return tags;
+}
+
+std::vector<ffmpegkit::SideDataFields> toSideData(const rapidjson::Value &value,
+                                                  bool *lossy) {
+    std::vector<ffmpegkit::SideDataFields> list;
+
+    if (!value.IsArray()) {
+        return list;
+    }
+
+    list.reserve(value.Size());
+    for (rapidjson::SizeType i = 0; i < value.Size(); i++) {
+        const rapidjson::Value &entry = value[i];
+        ffmpegkit::SideDataFields sideData;
+
+        if (!entry.IsObject()) {
+            continue;
+        }
+        for (auto member = entry.MemberBegin(); member != entry.MemberEnd();
+             ++member) {
+            const char *name = member->name.GetString();
+            const rapidjson::Value &field = member->value;
+            ffmpegkit::SideDataValue sideDataValue;
+
+            if (std::strcmp(name, "side_data_type") == 0) {
+                sideData.type = toInterned(field);
+                continue;
+            }
+
+            sideDataValue.name = ffmpegkit::InternedString::intern(
+                name, member->name.GetStringLength());
+            if (field.IsInt64()) {
+                sideDataValue.integer = field.GetInt64();
+            } else if (field.IsString()) {
+                sideDataValue.text =
+                    std::string(field.GetString(), field.GetStringLength());
+            } else {
+                *lossy = true;
+                continue;
+            }
+            sideData.values.push_back(std::move(sideDataValue));
+        }
+        list.push_back(std::move(sideData));
+    }
+
+    return list;
+}
+
+/* disposition flags in the order FFprobe prints them */
+const struct {
+    const char *name;
+    int64_t flag;
+} Dispositions[] = {
+    {"default", AV_DISPOSITION_DEFAULT},
+    {"dub", AV_DISPOSITION_DUB},
+    {"original", AV_DISPOSITION_ORIGINAL},
+    {"comment", AV_DISPOSITION_COMMENT},
+    {"lyrics", AV_DISPOSITION_LYRICS},
+    {"karaoke", AV_DISPOSITION_KARAOKE},
+    {"forced", AV_DISPOSITION_FORCED},
+    {"hearing_impaired", AV_DISPOSITION_HEARING_IMPAIRED},
+    {"visual_impaired", AV_DISPOSITION_VISUAL_IMPAIRED},
+    {"clean_effects", AV_DISPOSITION_CLEAN_EFFECTS},
+    {"attached_pic", AV_DISPOSITION_ATTACHED_PIC},
+    {"timed_thumbnails", AV_DISPOSITION_TIMED_THUMBNAILS},
+    {"non_diegetic", AV_DISPOSITION_NON_DIEGETIC},
+    {"captions", AV_DISPOSITION_CAPTIONS},
+    {"descriptions", AV_DISPOSITION_DESCRIPTIONS},
+    {"metadata", AV_DISPOSITION_METADATA},
+    {"dependent", AV_DISPOSITION_DEPENDENT},
+    {"still_image", AV_DISPOSITION_STILL_IMAGE}};
+
+ffmpegkit::Optional<int64_t> toDisposition(const rapidjson::Value &value,
+                                           bool *lossy) {
+    int64_t disposition = 0;
+
+    if (!value.IsObject()) {
+        return ffmpegkit::Optional<int64_t>();
+    }
+
+    for (auto &entry : Dispositions) {
+        auto member = value.FindMember(entry.name);
+        if (member != value.MemberEnd() &&
+            toInteger(member->value, lossy).valueOr(0) != 0) {
+            disposition |= entry.flag;
+        }
+    }
+
+    return disposition;
+}
+
+typedef rapidjson::Document::AllocatorType Allocator;
+
+void addValue(rapidjson::Value &object, const char *name,
+              rapidjson::Value &value, Allocator &allocator) {
+    rapidjson::Value key(name, (rapidjson::SizeType)std::strlen(name),
+                         allocator);
+    object.AddMember(key, value, allocator);
+}
+
+void addString(rapidjson::Value &object, const char *name,
+               const std::string &text, Allocator &allocator) {
+    rapidjson::Value value(text.c_str(), (rapidjson::SizeType)text.size(),
+                           allocator);
+    addValue(object, name, value, allocator);
+}
+
+void addString(rapidjson::Value &object, const char *name,
+               const ffmpegkit::InternedString &text, Allocator &allocator) {
+    if (text) {
+        addString(object, name, text.value(), allocator);
+    }
+}
+
+void addString(rapidjson::Value &object, const char *name,
+               const ffmpegkit::Optional<std::string> &text,
+               Allocator &allocator) {
+    if (text) {
+        addString(object, name, text.value(), allocator);
+    }
+}
+
+/* FFprobe prints these as strings */
+void addString(rapidjson::Value &object, const char *name,
+               const ffmpegkit::Optional<int64_t> &number,
+               Allocator &allocator) {
+    if (number) {
+        addString(object, name, std::to_string(number.value()), allocator);
+    }
+}
+
+void addString(rapidjson::Value &object, const char *name,
+               const ffmpegkit::Optional<double> &seconds,
+               Allocator &allocator) {
+    if (seconds) {
+        addString(object, name, ffmpegkit::formatSeconds(seconds.value()),
+                  allocator);
+    }
+}
+
+void addNumber(rapidjson::Value &object, const char *name,
+               const ffmpegkit::Optional<int64_t> &number,
+               Allocator &allocator) {
+    if (number) {
+        rapidjson::Value value(number.value());
+        addValue(object, name, value, allocator);
+    }
+}
+
+void addHex(rapidjson::Value &object, const char *name,
+            const ffmpegkit::Optional<int64_t> &number, const char *format,
+            Allocator &allocator) {
+    char buffer[32];
+
+    if (number) {
+        snprintf(buffer, sizeof(buffer), format, (uint64_t)number.value());
+        addString(object, name, std::string(buffer), allocator);
+    }
+}
+
+void addDisposition(rapidjson::Value &object,
+                    const ffmpegkit::Optional<int64_t> &disposition,
+                    Allocator &allocator) {
+    if (disposition) {
+        rapidjson::Value value(rapidjson::kObjectType);
+        for (auto &entry : Dispositions) {
+            addNumber(value, entry.name,
+                      (int64_t)((disposition.value() & entry.flag) ? 1 : 0),
+                      allocator);
+        }
+        addValue(object, "disposition", value, allocator);
+    }
+}
+
+void addTags(rapidjson::Value &object, const ffmpegkit::TagList &tags,
+             Allocator &allocator) {
+    if (!tags.empty()) {
+        rapidjson::Value value(rapidjson::kObjectType);
+        for (auto &tag : tags) {
+            addString(value, tag.first.c_str(), tag.second, allocator);
+        }
+        addValue(object, "tags", value, allocator);
+    }
+}
+
+void addSideData(rapidjson::Value &object,
+                 const std::vector<ffmpegkit::SideDataFields> &list,
+                 Allocator &allocator) {
+    if (!list.empty()) {
+        rapidjson::Value array(rapidjson::kArrayType);
+        for (auto &sideData : list) {
+            rapidjson::Value value(rapidjson::kObjectType);
+            addString(value, "side_data_type", sideData.type, allocator);
+            for (auto &sideDataValue : sideData.values) {
+                if (sideDataValue.integer) {
+                    addNumber(value, sideDataValue.name.c_str(),
+                              sideDataValue.integer, allocator);
+                } else {
+                    addString(value, sideDataValue.name.c_str(),
+                              sideDataValue.text, allocator);
+                }
+            }
+            array.PushBack(value, allocator);
+        }
+        addValue(object, "side_data_list", array, allocator);
+    }
+}
+
+} // namespace
+
+ffmpegkit::InternedString
+ffmpegkit::InternedString::intern(const char *value, size_t length) {
+    std::string key(value, length);
+    std::lock_guard<std::mutex> lock(internLock());
+    return InternedString(&*internPool().insert(std::move(key)).first);
+}
+
+ffmpegkit::InternedString
+ffmpegkit::InternedString::intern(const std::string &value) {
+    return intern(value.c_str(), value.size());
+}
+
+const std::string &ffmpegkit::InternedString::value() const {
+    static const std::string empty;
+    return _value != nullptr ? *_value : empty;
+}
+
+ffmpegkit::TagName::TagName(const char *value, size_t length)
+    : TagName(std::string(value, length)) {}
+
+ffmpegkit::TagName::TagName(const std::string &value) {
+    if (isKnownTagName(value)) {
+        _interned = InternedString::intern(value);
+    } else {
+        _owned = value;
+    }
+}
+
+const std::string *ffmpegkit::findTag(const TagList &tags, const char *name) {
+    for (auto &tag : tags) {
+        if (tag.first.value() == name) {
+            return &tag.second;
+        }
+    }
+    return nullptr;
+}
+
+std::string ffmpegkit::formatSeconds(double seconds) {
+    char buffer[48];
+    double rounded = std::round(std::fabs(seconds) * 1e6);
+
+    if (!std::isfinite(rounded) || rounded >= 9e18) {
+        return std::string();
+    }
+
+    int64_t micros = (int64_t)rounded;
+    snprintf(buffer, sizeof(buffer), "%s%lld.%06lld",
+             std::signbit(seconds) ? "-" : "", (long long)(micros / 1000000),
+             (long long)(micros % 1000000));
+
+    return std::string(buffer);
+}
+
+std::shared_ptr<std::string>
+ffmpegkit::toSharedString(const InternedString &value) {
+    if (value) {
+        return std::make_shared<std::string>(value.value());
+    } else {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<std::string>
+ffmpegkit::toSharedString(const Optional<int64_t> &value) {
+    if (value) {
+        return std::make_shared<std::string>(std::to_string(value.value()));
+    } else {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<std::string>
+ffmpegkit::toSharedString(const Optional<double> &value) {
+    if (value) {
+        return std::make_shared<std::string>(formatSeconds(value.value()));
+    } else {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<rapidjson::Value>
+ffmpegkit::toSharedTags(const TagList &tags) {
+    if (tags.empty()) {
+        return nullptr;
+    }
+
+    auto document = std::make_shared<rapidjson::Document>();
+    auto &allocator = document->GetAllocator();
+    document->SetObject();
+    for (auto &tag : tags) {
+        addString(*document, tag.first.c_str(), tag.second, allocator);
+    }
+
+    return document;
+}
+
+std::shared_ptr<int64_t>
+ffmpegkit::toSharedNumber(const Optional<int64_t> &value) {
+    if (value) {
+        return std::make_shared<int64_t>(value.value());
+    } else {
+        return nullptr;
+    }
+}
+
+ffmpegkit::LazyJsonDocument::LazyJsonDocument(const std::string &json)
+    : _json{json} {}
+
+ffmpegkit::LazyJsonDocument::LazyJsonDocument(
+    std::shared_ptr<rapidjson::Document> document)
+    : _document{document} {}
+
+ffmpegkit::LazyJsonDocument::LazyJsonDocument(
+    std::function<std::shared_ptr<rapidjson::Document>()> builder)
+    : _builder{builder} {}
+
+const rapidjson::Value &ffmpegkit::LazyJsonDocument::getRoot() {
+    static const rapidjson::Value null;
+
+    std::call_once(_parsed, [this]() {
+        if (_builder) {
+            _document = _builder();
+            _builder = nullptr;
+        } else if (_document == nullptr) {
+            auto document = std::make_shared<rapidjson::Document>();
+            document->Parse(_json.c_str());
+            if (!document->HasParseError()) {
+                _document = document;
+            }
+            std::string().swap(_json);
+        }
+    });
+
+    return _document != nullptr ? *_document : null;
+}
+
+const rapidjson::Value *
+ffmpegkit::LazyJsonDocument::findMember(const rapidjson::Value *value,
+                                        const char *key) {
+    if (value == nullptr || !value->IsObject()) {
+        return nullptr;
+    }
+    auto member = value->FindMember(key);
+    return member != value->MemberEnd() ? &member->value : nullptr;
+}
+
+const rapidjson::Value *
+ffmpegkit::LazyJsonDocument::findElement(const rapidjson::Value &root,
+                                         const char *key, size_t index) {
+    const rapidjson::Value *array = findMember(&root, key);
+    if (array == nullptr || !array->IsArray() || index >= array->Size()) {
+        return nullptr;
+    }
+    return &(*array)[(rapidjson::SizeType)index];
+}
+
+std::shared_ptr<rapidjson::Document>
+ffmpegkit::LazyJsonDocument::copy(const rapidjson::Value &value) {
+    auto document = std::make_shared<rapidjson::Document>();
+    document->CopyFrom(value, document->GetAllocator());
+    return document;
+}
+
+ffmpegkit::FormatFields
+ffmpegkit::FormatFields::from(const rapidjson::Value &value) {
+    FormatFields fields;
+
+    if (!value.IsObject()) {
+        return fields;
+    }
+
+    for (auto member = value.MemberBegin(); member != value.MemberEnd();
+         ++member) {
+        const char *name = member->name.GetString();
+        const rapidjson::Value &field = member->value;
+
+        if (std::strcmp(name, "filename") == 0) {
+            if (field.IsString()) {
+                fields.filename = std::string(field.GetString(),
+                                              field.GetStringLength());
+            }
+        } else if (std::strcmp(name, "format_name") == 0) {
+            fields.formatName = toInterned(field);
+        } else if (std::strcmp(name, "format_long_name") == 0) {
+            fields.formatLongName = toInterned(field);
+        } else if (std::strcmp(name, "nb_streams") == 0) {
+            fields.nbStreams = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "nb_programs") == 0) {
+            fields.nbPrograms = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "probe_score") == 0) {
+            fields.probeScore = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "start_time") == 0) {
+            fields.startTime = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "duration") == 0) {
+            fields.duration = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "size") == 0) {
+            fields.size = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "bit_rate") == 0) {
+            fields.bitRate = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "tags") == 0) {
+            fields.tags = toTags(field);
+        }
+    }
+
+    return fields;
+}
+
+ffmpegkit::StreamFields
+ffmpegkit::StreamFields::from(const rapidjson::Value &value) {
+    StreamFields fields;
+
+    if (!value.IsObject()) {
+        return fields;
+    }
+
+    for (auto member = value.MemberBegin(); member != value.MemberEnd();
+         ++member) {
+        const char *name = member->name.GetString();
+        const rapidjson::Value &field = member->value;
+
+        if (std::strcmp(name, "index") == 0) {
+            fields.index = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "codec_type") == 0) {
+            fields.type = toInterned(field);
+        } else if (std::strcmp(name, "codec_name") == 0) {
+            fields.codec = toInterned(field);
+        } else if (std::strcmp(name, "codec_long_name") == 0) {
+            fields.codecLong = toInterned(field);
+        } else if (std::strcmp(name, "profile") == 0) {
+            fields.profile = toInterned(field);
+        } else if (std::strcmp(name, "codec_tag_string") == 0) {
+            fields.codecTag = toInterned(field);
+        } else if (std::strcmp(name, "codec_tag") == 0) {
+            fields.codecTagValue = toHexInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "id") == 0) {
+            fields.id = toHexInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "bit_rate") == 0) {
+            fields.bitRate = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "bits_per_raw_sample") == 0) {
+            fields.bitsPerRawSample = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "nb_frames") == 0) {
+            fields.nbFrames = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "extradata_size") == 0) {
+            fields.extradataSize = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "disposition") == 0) {
+            fields.disposition = toDisposition(field, &fields.lossy);
+        } else if (std::strcmp(name, "time_base") == 0) {
+            fields.timeBase = toInterned(field);
+        } else if (std::strcmp(name, "codec_time_base") == 0) {
+            fields.codecTimeBase = toInterned(field);
+        } else if (std::strcmp(name, "start_pts") == 0) {
+            fields.startPts = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "start_time") == 0) {
+            fields.startTime = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "duration_ts") == 0) {
+            fields.durationTs = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "duration") == 0) {
+            fields.duration = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "pix_fmt") == 0) {
+            fields.format = toInterned(field);
+        } else if (std::strcmp(name, "width") == 0) {
+            fields.width = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "height") == 0) {
+            fields.height = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "coded_width") == 0) {
+            fields.codedWidth = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "coded_height") == 0) {
+            fields.codedHeight = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "has_b_frames") == 0) {
+            fields.hasBFrames = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "refs") == 0) {
+            fields.refs = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "level") == 0) {
+            fields.level = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "sample_aspect_ratio") == 0) {
+            fields.sampleAspectRatio = toInterned(field);
+        } else if (std::strcmp(name, "display_aspect_ratio") == 0) {
+            fields.displayAspectRatio = toInterned(field);
+        } else if (std::strcmp(name, "avg_frame_rate") == 0) {
+            fields.averageFrameRate = toInterned(field);
+        } else if (std::strcmp(name, "r_frame_rate") == 0) {
+            fields.realFrameRate = toInterned(field);
+        } else if (std::strcmp(name, "field_order") == 0) {
+            fields.fieldOrder = toInterned(field);
+        } else if (std::strcmp(name, "color_range") == 0) {
+            fields.colorRange = toInterned(field);
+        } else if (std::strcmp(name, "color_space") == 0) {
+            fields.colorSpace = toInterned(field);
+        } else if (std::strcmp(name, "color_transfer") == 0) {
+            fields.colorTransfer = toInterned(field);
+        } else if (std::strcmp(name, "color_primaries") == 0) {
+            fields.colorPrimaries = toInterned(field);
+        } else if (std::strcmp(name, "chroma_location") == 0) {
+            fields.chromaLocation = toInterned(field);
+        } else if (std::strcmp(name, "sample_rate") == 0) {
+            fields.sampleRate = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "sample_fmt") == 0) {
+            fields.sampleFormat = toInterned(field);
+        } else if (std::strcmp(name, "channels") == 0) {
+            fields.channels = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "channel_layout") == 0) {
+            fields.channelLayout = toInterned(field);
+        } else if (std::strcmp(name, "bits_per_sample") == 0) {
+            fields.bitsPerSample = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "initial_padding") == 0) {
+            fields.initialPadding = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "tags") == 0) {
+            fields.tags = toTags(field);
+        } else if (std::strcmp(name, "side_data_list") == 0) {
+            fields.sideData = toSideData(field, &fields.lossy);
+        }
+    }
+
+    return fields;
+}
+
+ffmpegkit::ChapterFields
+ffmpegkit::ChapterFields::from(const rapidjson::Value &value) {
+    ChapterFields fields;
+
+    if (!value.IsObject()) {
+        return fields;
+    }
+
+    for (auto member = value.MemberBegin(); member != value.MemberEnd();
+         ++member) {
+        const char *name = member->name.GetString();
+        const rapidjson::Value &field = member->value;
+
+        if (std::strcmp(name, "id") == 0) {
+            fields.id = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "time_base") == 0) {
+            fields.timeBase = toInterned(field);
+        } else if (std::strcmp(name, "start") == 0) {
+            fields.start = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "start_time") == 0) {
+            fields.startTime = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "end") == 0) {
+            fields.end = toInteger(field, &fields.lossy);
+        } else if (std::strcmp(name, "end_time") == 0) {
+            fields.endTime = toDecimal(field, &fields.lossy);
+        } else if (std::strcmp(name, "tags") == 0) {
+            fields.tags = toTags(field);
+        }
+    }
+
+    return fields;
+}
+
+void ffmpegkit::FormatFields::write(
+    rapidjson::Value &object,
+    rapidjson::Document::AllocatorType &allocator) const {
+    addString(object, "filename", filename, allocator);
+    addNumber(object, "nb_streams", nbStreams, allocator);
+    addNumber(object, "nb_programs", nbPrograms, allocator);
+    addString(object, "format_name", formatName, allocator);
+    addString(object, "format_long_name", formatLongName, allocator);
+    addString(object, "start_time", startTime, allocator);
+    addString(object, "duration", duration, allocator);
+    addString(object, "size", size, allocator);
+    addString(object, "bit_rate", bitRate, allocator);
+    addNumber(object, "probe_score", probeScore, allocator);
+    addTags(object, tags, allocator);
+}
+
+void ffmpegkit::StreamFields::write(
+    rapidjson::Value &object,
+    rapidjson::Document::AllocatorType &allocator) const {
+    addNumber(object, "index", index, allocator);
+    addString(object, "codec_name", codec, allocator);
+    addString(object, "codec_long_name", codecLong, allocator);
+    addString(object, "profile", profile, allocator);
+    addString(object, "codec_type", type, allocator);
+    addString(object, "codec_tag_string", codecTag, allocator);
+    addHex(object, "codec_tag", codecTagValue, "0x%04" PRIx64, allocator);
+    addNumber(object, "width", width, allocator);
+    addNumber(object, "height", height, allocator);
+    addNumber(object, "coded_width", codedWidth, allocator);
+    addNumber(object, "coded_height", codedHeight, allocator);
+    addNumber(object, "has_b_frames", hasBFrames, allocator);
+    addString(object, "sample_aspect_ratio", sampleAspectRatio, allocator);
+    addString(object, "display_aspect_ratio", displayAspectRatio, allocator);
+    addString(object, "pix_fmt", format, allocator);
+    addNumber(object, "level", level, allocator);
+    addString(object, "color_range", colorRange, allocator);
+    addString(object, "color_space", colorSpace, allocator);
+    addString(object, "color_transfer", colorTransfer, allocator);
+    addString(object, "color_primaries", colorPrimaries, allocator);
+    addString(object, "chroma_location", chromaLocation, allocator);
+    addString(object, "field_order", fieldOrder, allocator);
+    addNumber(object, "refs", refs, allocator);
+    addString(object, "sample_fmt", sampleFormat, allocator);
+    addString(object, "sample_rate", sampleRate, allocator);
+    addNumber(object, "channels", channels, allocator);
+    addString(object, "channel_layout", channelLayout, allocator);
+    addNumber(object, "bits_per_sample", bitsPerSample, allocator);
+    addNumber(object, "initial_padding", initialPadding, allocator);
+    addHex(object, "id", id, "0x%" PRIx64, allocator);
+    addString(object, "r_frame_rate", realFrameRate, allocator);
+    addString(object, "avg_frame_rate", averageFrameRate, allocator);
+    addString(object, "time_base", timeBase, allocator);
+    addString(object, "codec_time_base", codecTimeBase, allocator);
+    addNumber(object, "start_pts", startPts, allocator);
+    addString(object, "start_time", startTime, allocator);
+    addNumber(object, "duration_ts", durationTs, allocator);
+    addString(object, "duration", duration, allocator);
+    addString(object, "bit_rate", bitRate, allocator);
+    addString(object, "bits_per_raw_sample", bitsPerRawSample, allocator);
+    addString(object, "nb_frames", nbFrames, allocator);
+    addNumber(object, "extradata_size", extradataSize, allocator);
+    addDisposition(object, disposition, allocator);
+    addTags(object, tags, allocator);
+    addSideData(object, sideData, allocator);
+}
+
+void ffmpegkit::ChapterFields::write(
+    rapidjson::Value &object,
+    rapidjson::Document::AllocatorType &allocator) const {
+    addNumber(object, "id", id, allocator);
+    addString(object, "time_base", timeBase, allocator);
+    addNumber(object, "start", start, allocator);
+    addString(object, "start_time", startTime, allocator);
+    addNumber(object, "end", end, allocator);
+    addString(object, "end_time", endTime, allocator);
+    addTags(object, tags, allocator);
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_FIELDS_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_FIELDS_H
+
+// OVERRIDING THE MACRO TO PREVENT APPLICATION TERMINATION
+#define RAPIDJSON_ASSERT(x)
+#include "rapidjson/document.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ffmpegkit {
+
+/**
+ * A value that may be missing.
+ */
+template <typename T> class Optional {
+  public:
+    Optional() : _present{false}, _value{} {}
+
+    Optional(const T &value) : _present{true}, _value{value} {}
+
+    bool hasValue() const { return _present; }
+
+    explicit operator bool() const { return _present; }
+
+    /**
+     * Returns the value. Only meaningful if hasValue() is true.
+     */
+    const T &value() const { return _value; }
+
+    T valueOr(const T &fallback) const { return _present ? _value : fallback; }
+
+  private:
+    bool _present;
+    T _value;
+};
+
+/**
+ * An immutable string stored once in a process wide pool.
+ *
+ * Used for values that repeat across media files such as codec names, pixel
+ * formats or time bases. Copies are a single pointer and equal strings compare
+ * by address. Pooled strings are never released, so this must not be used for
+ * unbounded values like file names or tag values.
+ */
+class InternedString {
+  public:
+    InternedString() : _value{nullptr} {}
+
+    static InternedString intern(const char *value, size_t length);
+
+    static InternedString intern(const std::string &value);
+
+    bool hasValue() const { return _value != nullptr; }
+
+    explicit operator bool() const { return _value != nullptr; }
+
+    /**
+     * Returns the string, an empty string if there is no value.
+     */
+    const std::string &value() const;
+
+    const char *c_str() const { return value().c_str(); }
+
+    bool operator==(const InternedString &other) const {
+        return _value == other._value;
+    }
+
+    bool operator!=(const InternedString &other) const {
+        return _value != other._value;
+    }
+
+  private:
+    explicit InternedString(const std::string *value) : _value{value} {}
+
+    const std::string *_value;
+};
+
+/**
+ * The name of a tag. Names that are common across media files, like title or
+ * language, are interned. Other names are owned, since files can use any
+ * number of different names and the pool is never released.
+ */
+class TagName {
+  public:
+    TagName(const char *value, size_t length);
+
+    explicit TagName(const std::string &value);
+
+    const std::string &value() const {
+        return _interned ? _interned.value() : _owned;
+    }
+
+    const char *c_str() const { return value().c_str(); }
+
+  private:
+    InternedString _interned;
+    std::string _owned;
+};
+
+/**
+ * Tag values are owned.
+ */
+typedef std::vector<std::pair<TagName, std::string>> TagList;
+
+/**
+ * Returns the value of the tag or nullptr if the tag is not defined.
+ */
+const std::string *findTag(const TagList &tags, const char *name);
+
+/**
+ * Formats seconds the way FFprobe prints them, with six decimals.
+ */
+std::string formatSeconds(double seconds);
+
+/**
+ * Returns a copy of the value for the getters using shared pointers, nullptr
+ * if there is no value.
+ */
+std::shared_ptr<std::string> toSharedString(const InternedString &value);
+
+std::shared_ptr<std::string> toSharedString(const Optional<int64_t> &value);
+
+std::shared_ptr<std::string> toSharedString(const Optional<double> &value);
+
+std::shared_ptr<int64_t> toSharedNumber(const Optional<int64_t> &value);
+
+/**
+ * Returns the tags as a json object for the getters, nullptr if there are no
+ * tags.
+ */
+std::shared_ptr<rapidjson::Value> toSharedTags(const TagList &tags);
+
+/**
+ * Keeps FFprobe's json output and parses it on first use.
+ *
+ * Typed fields are extracted once by MediaInformationJsonParser; this is only
+ * consulted by the key based getters, for keys that are not extracted.
+ */
+class LazyJsonDocument {
+  public:
+    explicit LazyJsonDocument(const std::string &json);
+
+    explicit LazyJsonDocument(std::shared_ptr<rapidjson::Document> document);
+
+    /**
+     * Creates the document using builder on first use.
+     */
+    explicit LazyJsonDocument(
+        std::function<std::shared_ptr<rapidjson::Document>()> builder);
+
+    /**
+     * Returns the root value, a null value if the json is not valid.
+     */
+    const rapidjson::Value &getRoot();
+
+    /**
+     * Returns the member of value associated with the key or nullptr if it
+     * is not defined.
+     */
+    static const rapidjson::Value *findMember(const rapidjson::Value *value,
+                                              const char *key);
+
+    /**
+     * Returns the element of the array member of root associated with the key
+     * or nullptr if it is not defined.
+     */
+    static const rapidjson::Value *findElement(const rapidjson::Value &root,
+                                               const char *key,
+                                               size_t index);
+
+    /**
+     * Returns a deep copy of value which owns its memory.
+     */
+    static std::shared_ptr<rapidjson::Document>
+    copy(const rapidjson::Value &value);
+
+  private:
+    std::string _json;
+    std::function<std::shared_ptr<rapidjson::Document>()> _builder;
+    std::once_flag _parsed;
+    std::shared_ptr<rapidjson::Document> _document;
+};
+
+/**
+ * Flags of the fields that hold estimated values in FormatFields and
+ * StreamFields. Fields that are not flagged are authoritative, either read
+ * from the container or measured on the packets. Only the in-process probe
+ * sets them.
+ */
+enum EstimatedField : uint32_t {
+    EstimatedStartTime = 1 << 0,
+    EstimatedDuration = 1 << 1,
+    EstimatedBitRate = 1 << 2,
+    EstimatedFrameRate = 1 << 3,
+
+    /* stream analysis was skipped or cut short, codec parameters are the ones
+     * declared by the container headers and may be incomplete */
+    EstimatedCodecParameters = 1 << 4
+};
+
+/**
+ * Format fields of a media file.
+ */
+struct FormatFields {
+    Optional<std::string> filename;
+    InternedString formatName;
+    InternedString formatLongName;
+    Optional<int64_t> nbStreams;
+    Optional<int64_t> nbPrograms;
+    Optional<int64_t> probeScore;
+
+    /* in seconds */
+    Optional<double> startTime;
+    Optional<double> duration;
+
+    /* in bytes */
+    Optional<int64_t> size;
+
+    /* in bits per second */
+    Optional<int64_t> bitRate;
+
+    TagList tags;
+
+    /* set if a numeric value is printed in a form that can't be parsed, e.g.
+     * with units */
+    bool lossy = false;
+
+    /* EstimatedField flags */
+    uint32_t estimated = 0;
+
+    static FormatFields from(const rapidjson::Value &value);
+
+    /**
+     * Adds the fields to object using the keys and value types of FFprobe's
+     * json output.
+     */
+    void write(rapidjson::Value &object,
+               rapidjson::Document::AllocatorType &allocator) const;
+};
+
+/**
+ * A value of a side data entry. It is printed as a json number if integer is
+ * set and as a string otherwise.
+ */
+struct SideDataValue {
+    InternedString name;
+    Optional<int64_t> integer;
+    std::string text;
+};
+
+/**
+ * A side data entry of a stream, with the type specific values FFprobe prints
+ * for it.
+ */
+struct SideDataFields {
+    InternedString type;
+    std::vector<SideDataValue> values;
+};
+
+/**
+ * Fields of a single stream.
+ */
+struct StreamFields {
+    Optional<int64_t> index;
+    InternedString type;
+    InternedString codec;
+    InternedString codecLong;
+    InternedString profile;
+    InternedString codecTag;
+    Optional<int64_t> codecTagValue;
+
+    /* only printed for formats with stream ids, e.g. mpegts */
+    Optional<int64_t> id;
+    Optional<int64_t> bitRate;
+    Optional<int64_t> bitsPerRawSample;
+    Optional<int64_t> nbFrames;
+    Optional<int64_t> extradataSize;
+
+    /* AV_DISPOSITION_* flags */
+    Optional<int64_t> disposition;
+    InternedString timeBase;
+    InternedString codecTimeBase;
+    Optional<int64_t> startPts;
+    Optional<double> startTime;
+    Optional<int64_t> durationTs;
+    Optional<double> duration;
+
+    /* video */
+    InternedString format;
+    Optional<int64_t> width;
+    Optional<int64_t> height;
+    Optional<int64_t> codedWidth;
+    Optional<int64_t> codedHeight;
+    Optional<int64_t> hasBFrames;
+    Optional<int64_t> refs;
+    Optional<int64_t> level;
+    InternedString sampleAspectRatio;
+    InternedString displayAspectRatio;
+    InternedString averageFrameRate;
+    InternedString realFrameRate;
+    InternedString fieldOrder;
+    InternedString colorRange;
+    InternedString colorSpace;
+    InternedString colorTransfer;
+    InternedString colorPrimaries;
+    InternedString chromaLocation;
+
+    /* audio */
+    Optional<int64_t> sampleRate;
+    InternedString sampleFormat;
+    Optional<int64_t> channels;
+    InternedString channelLayout;
+    Optional<int64_t> bitsPerSample;
+    Optional<int64_t> initialPadding;
+
+    TagList tags;
+    std::vector<SideDataFields> sideData;
+
+    /* set if a numeric value is printed in a form that can't be parsed, e.g.
+     * with units */
+    bool lossy = false;
+
+    /* EstimatedField flags */
+    uint32_t estimated = 0;
+
+    static StreamFields from(const rapidjson::Value &value);
+
+    /**
+     * Adds the fields to object using the keys and value types of FFprobe's
+     * json output.
+     */
+    void write(rapidjson::Value &object,
+               rapidjson::Document::AllocatorType &allocator) const;
+};
+
+/**
+ * Fields of a single chapter.
+ */
+struct ChapterFields {
+    Optional<int64_t> id;
+    InternedString timeBase;
+    Optional<int64_t> start;
+    Optional<double> startTime;
+    Optional<int64_t> end;
+    Optional<double> endTime;
+    TagList tags;
+
+    /* set if a numeric value is printed in a form that can't be parsed, e.g.
+     * with units */
+    bool lossy = false;
+
+    static ChapterFields from(const rapidjson::Value &value);
+
+    /**
+     * Adds the fields to object using the keys and value types of FFprobe's
+     * json output.
+     */
+    void write(rapidjson::Value &object,
+               rapidjson::Document::AllocatorType &allocator) const;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_FIELDS_H
@@ -25,6 +25,7 @@
 #include "rapidjson/reader.h"
 #include <memory>
 
+static const char *MediaInformationJsonParserKeyFormat = "format";
 static const char *MediaInformationJsonParserKeyStreams = "streams";
 static const char *MediaInformationJsonParserKeyChapters = "chapters";
 
@@ -43,50 +44,49 @@ ffmpegkit::MediaInformationJsonParser::from(
 std::shared_ptr<ffmpegkit::MediaInformation>
 ffmpegkit::MediaInformationJsonParser::fromWithError(
     const std::string &ffprobeJsonOutput) {
-    std::shared_ptr<rapidjson::Document> document =
-        std::make_shared<rapidjson::Document>();
+    rapidjson::Document document;
 
-    document->Parse(ffprobeJsonOutput.c_str());
+    document.Parse(ffprobeJsonOutput.c_str());
 
-    if (document->HasParseError()) {
-        throw std::runtime_error(GetParseError_En(document->GetParseError()));
+    if (document.HasParseError()) {
+        throw std::runtime_error(GetParseError_En(document.GetParseError()));
     } else {
-        std::shared_ptr<
-            std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>
-            streams = std::make_shared<
-                std::vector<std::shared_ptr<ffmpegkit::StreamInformation>>>();
-        std::shared_ptr<std::vector<std::shared_ptr<ffmpegkit::Chapter>>>
-            chapters = std::make_shared<
-                std::vector<std::shared_ptr<ffmpegkit::Chapter>>>();
+        // FIELDS ARE EXTRACTED IN A SINGLE PASS, THE DOCUMENT IS RELEASED AND
+        // PARSED AGAIN ONLY IF A KEY THAT IS NOT EXTRACTED IS REQUESTED
+        auto json = std::make_shared<ffmpegkit::LazyJsonDocument>(
+            ffprobeJsonOutput);
+        std::vector<ffmpegkit::StreamInformation> streams;
+        std::vector<ffmpegkit::Chapter> chapters;
+        ffmpegkit::FormatFields format;
 
-        if (document->HasMember(MediaInformationJsonParserKeyStreams)) {
-            rapidjson::Value &streamArray =
-                (*document.get())[MediaInformationJsonParserKeyStreams];
-            if (streamArray.IsArray()) {
-                for (rapidjson::SizeType i = 0; i < streamArray.Size(); i++) {
-                    auto stream = std::make_shared<rapidjson::Value>();
-                    *stream = streamArray[i];
-                    streams->push_back(
-                        std::make_shared<ffmpegkit::StreamInformation>(stream));
-                }
+        auto formatValue = ffmpegkit::LazyJsonDocument::findMember(
+            &document, MediaInformationJsonParserKeyFormat);
+        if (formatValue != nullptr) {
+            format = ffmpegkit::FormatFields::from(*formatValue);
+        }
+
+        auto streamArray = ffmpegkit::LazyJsonDocument::findMember(
+            &document, MediaInformationJsonParserKeyStreams);
+        if (streamArray != nullptr && streamArray->IsArray()) {
+            streams.reserve(streamArray->Size());
+            for (rapidjson::SizeType i = 0; i < streamArray->Size(); i++) {
+                streams.emplace_back(
+                    ffmpegkit::StreamFields::from((*streamArray)[i]), json, i);
             }
         }
 
-        if (document->HasMember(MediaInformationJsonParserKeyChapters)) {
-            rapidjson::Value &chapterArray =
-                (*document.get())[MediaInformationJsonParserKeyChapters];
-            if (chapterArray.IsArray()) {
-                for (rapidjson::SizeType i = 0; i < chapterArray.Size(); i++) {
-                    auto chapter = std::make_shared<rapidjson::Value>();
-                    *chapter = chapterArray[i];
-                    chapters->push_back(
-                        std::make_shared<ffmpegkit::Chapter>(chapter));
-                }
+        auto chapterArray = ffmpegkit::LazyJsonDocument::findMember(
+            &document, MediaInformationJsonParserKeyChapters);
+        if (chapterArray != nullptr && chapterArray->IsArray()) {
+            chapters.reserve(chapterArray->Size());
+            for (rapidjson::SizeType i = 0; i < chapterArray->Size(); i++) {
+                chapters.emplace_back(
+                    ffmpegkit::ChapterFields::from((*chapterArray)[i]), json,
+                    i);
             }
         }
 
         return std::make_shared<ffmpegkit::MediaInformation>(
-            std::static_pointer_cast<rapidjson::Value>(document), streams,
-            chapters);
+            format, std::move(streams), std::move(chapters), json);
     }
 }
@@ -0,0 +1,634 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+#include "libavutil/channel_layout.h"
+#include "libavutil/display.h"
+#include "libavutil/dovi_meta.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mastering_display_metadata.h"
+#include "libavutil/opt.h"
+#include "libavutil/pixdesc.h"
+#include "libavutil/spherical.h"
+#include "libavutil/stereo3d.h"
+#include "libavutil/time.h"
+}
+#include "MediaInformationProbe.h"
+#include <cmath>
+#include <cstring>
+
+extern "C" int cancelRequested(long sessionId);
+
+namespace {
+
+struct ProbeInterrupt {
+    long sessionId;
+
+    /* av_gettime_relative() value, zero for none */
+    int64_t deadline;
+    bool expired;
+};
+
+int probeInterrupt(void *opaque) {
+    ProbeInterrupt *interrupt = (ProbeInterrupt *)opaque;
+
+    if (interrupt->deadline != 0 && !interrupt->expired &&
+        av_gettime_relative() >= interrupt->deadline) {
+        interrupt->expired = true;
+    }
+
+    return interrupt->expired ||
+           (interrupt->sessionId != 0 && cancelRequested(interrupt->sessionId));
+}
+
+/**
+ * Returns whether the container headers define the parameters stream
+ * analysis would otherwise look for.
+ */
+bool hasHeaderParameters(const AVStream *stream) {
+    const AVCodecParameters *parameters = stream->codecpar;
+
+    switch (parameters->codec_type) {
+    case AVMEDIA_TYPE_VIDEO:
+        return parameters->codec_id != AV_CODEC_ID_NONE &&
+               parameters->width > 0 && parameters->height > 0;
+    case AVMEDIA_TYPE_AUDIO:
+        return parameters->codec_id != AV_CODEC_ID_NONE &&
+               parameters->sample_rate > 0 &&
+               parameters->ch_layout.nb_channels > 0;
+    case AVMEDIA_TYPE_SUBTITLE:
+        return parameters->codec_id != AV_CODEC_ID_NONE;
+    case AVMEDIA_TYPE_UNKNOWN:
+        return false;
+    default:
+        return true;
+    }
+}
+
+bool needsAnalysis(const AVFormatContext *context) {
+    if (context->nb_streams == 0 || (context->ctx_flags & AVFMTCTX_NOHEADER)) {
+        return true;
+    }
+    for (unsigned int i = 0; i < context->nb_streams; i++) {
+        if (!hasHeaderParameters(context->streams[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ffmpegkit::InternedString intern(const char *value) {
+    if (value == NULL) {
+        return ffmpegkit::InternedString();
+    }
+    return ffmpegkit::InternedString::intern(value, std::strlen(value));
+}
+
+ffmpegkit::InternedString internRational(AVRational value, char separator) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%d%c%d", value.num, separator,
+             value.den);
+    return intern(buffer);
+}
+
+ffmpegkit::Optional<int64_t> toTimestamp(int64_t timestamp) {
+    if (timestamp == AV_NOPTS_VALUE) {
+        return ffmpegkit::Optional<int64_t>();
+    }
+    return timestamp;
+}
+
+ffmpegkit::Optional<double> toSeconds(int64_t timestamp, AVRational timeBase) {
+    if (timestamp == AV_NOPTS_VALUE) {
+        return ffmpegkit::Optional<double>();
+    }
+    return timestamp * av_q2d(timeBase);
+}
+
+ffmpegkit::TagList toTags(const AVDictionary *metadata) {
+    ffmpegkit::TagList tags;
+    const AVDictionaryEntry *tag = NULL;
+
+    tags.reserve(av_dict_count(metadata));
+    while ((tag = av_dict_iterate(metadata, tag))) {
+        tags.emplace_back(ffmpegkit::TagName(tag->key, std::strlen(tag->key)),
+                          std::string(tag->value));
+    }
+
+    return tags;
+}
+
+ffmpegkit::FormatFields toFormatFields(AVFormatContext *context) {
+    ffmpegkit::FormatFields fields;
+    int64_t size = context->pb ? avio_size(context->pb) : -1;
+
+    fields.filename = std::string(context->url);
+    fields.nbStreams = (int64_t)context->nb_streams;
+    fields.nbPrograms = (int64_t)context->nb_programs;
+    fields.formatName = intern(context->iformat->name);
+    if (context->iformat->long_name) {
+        fields.formatLongName = intern(context->iformat->long_name);
+    }
+    fields.startTime = toSeconds(context->start_time, AV_TIME_BASE_Q);
+    fields.duration = toSeconds(context->duration, AV_TIME_BASE_Q);
+    if (size >= 0) {
+        fields.size = size;
+    }
+    if (context->bit_rate > 0) {
+        fields.bitRate = context->bit_rate;
+    }
+    fields.probeScore = (int64_t)context->probe_score;
+    fields.tags = toTags(context->metadata);
+
+    return fields;
+}
+
+ffmpegkit::InternedString toFieldOrder(enum AVFieldOrder fieldOrder) {
+    switch (fieldOrder) {
+    case AV_FIELD_PROGRESSIVE:
+        return intern("progressive");
+    case AV_FIELD_TT:
+        return intern("tt");
+    case AV_FIELD_BB:
+        return intern("bb");
+    case AV_FIELD_TB:
+        return intern("tb");
+    case AV_FIELD_BT:
+        return intern("bt");
+    default:
+        return ffmpegkit::InternedString();
+    }
+}
+
+void addInteger(ffmpegkit::SideDataFields &sideData, const char *name,
+                int64_t value) {
+    ffmpegkit::SideDataValue sideDataValue;
+    sideDataValue.name = intern(name);
+    sideDataValue.integer = value;
+    sideData.values.push_back(std::move(sideDataValue));
+}
+
+void addText(ffmpegkit::SideDataFields &sideData, const char *name,
+             const std::string &value) {
+    ffmpegkit::SideDataValue sideDataValue;
+    sideDataValue.name = intern(name);
+    sideDataValue.text = value;
+    sideData.values.push_back(std::move(sideDataValue));
+}
+
+void addRational(ffmpegkit::SideDataFields &sideData, const char *name,
+                 AVRational value) {
+    addText(sideData, name, internRational(value, '/').value());
+}
+
+/**
+ * Formats a display matrix the way FFprobe prints it, one row per line.
+ */
+std::string toDisplayMatrix(const uint8_t *data) {
+    std::string matrix("\n");
+    char buffer[16];
+
+    for (int row = 0; row < 3; row++) {
+        snprintf(buffer, sizeof(buffer), "%08x: ", row);
+        matrix += buffer;
+        for (int column = 0; column < 3; column++) {
+            snprintf(buffer, sizeof(buffer), " %11d",
+                     (int32_t)AV_RN32(data + (row * 3 + column) * 4));
+            matrix += buffer;
+        }
+        matrix += "\n";
+    }
+
+    return matrix;
+}
+
+/**
+ * Converts a side data entry of the stream with the keys FFprobe prints for
+ * it. Only the type is set for dynamic HDR10+ metadata and WebVTT entries.
+ */
+ffmpegkit::SideDataFields toSideDataFields(const AVCodecParameters *parameters,
+                                           const AVPacketSideData *entry) {
+    ffmpegkit::SideDataFields sideData;
+    const char *name = av_packet_side_data_name(entry->type);
+
+    sideData.type = intern(name ? name : "unknown");
+
+    if (entry->type == AV_PKT_DATA_DISPLAYMATRIX && entry->size >= 9 * 4) {
+        double rotation = av_display_rotation_get((int32_t *)entry->data);
+        if (std::isnan(rotation)) {
+            rotation = 0;
+        }
+        addText(sideData, "displaymatrix", toDisplayMatrix(entry->data));
+        addInteger(sideData, "rotation", (int64_t)rotation);
+    } else if (entry->type == AV_PKT_DATA_STEREO3D) {
+        const AVStereo3D *stereo = (const AVStereo3D *)entry->data;
+        addText(sideData, "type", av_stereo3d_type_name(stereo->type));
+        addInteger(sideData, "inverted",
+                   (stereo->flags & AV_STEREO3D_FLAG_INVERT) ? 1 : 0);
+    } else if (entry->type == AV_PKT_DATA_SPHERICAL) {
+        const AVSphericalMapping *spherical =
+            (const AVSphericalMapping *)entry->data;
+        addText(sideData, "projection",
+                av_spherical_projection_name(spherical->projection));
+        if (spherical->projection == AV_SPHERICAL_CUBEMAP) {
+            addInteger(sideData, "padding", spherical->padding);
+        } else if (spherical->projection ==
+                   AV_SPHERICAL_EQUIRECTANGULAR_TILE) {
+            size_t left, top, right, bottom;
+            av_spherical_tile_bounds(spherical, parameters->width,
+                                     parameters->height, &left, &top, &right,
+                                     &bottom);
+            addInteger(sideData, "bound_left", (int64_t)left);
+            addInteger(sideData, "bound_top", (int64_t)top);
+            addInteger(sideData, "bound_right", (int64_t)right);
+            addInteger(sideData, "bound_bottom", (int64_t)bottom);
+        }
+        addInteger(sideData, "yaw",
+                   (int64_t)((double)spherical->yaw / (1 << 16)));
+        addInteger(sideData, "pitch",
+                   (int64_t)((double)spherical->pitch / (1 << 16)));
+        addInteger(sideData, "roll",
+                   (int64_t)((double)spherical->roll / (1 << 16)));
+    } else if (entry->type == AV_PKT_DATA_SKIP_SAMPLES && entry->size == 10) {
+        addInteger(sideData, "skip_samples", AV_RL32(entry->data));
+        addInteger(sideData, "discard_padding", AV_RL32(entry->data + 4));
+        addInteger(sideData, "skip_reason", AV_RL8(entry->data + 8));
+        addInteger(sideData, "discard_reason", AV_RL8(entry->data + 9));
+    } else if (entry->type == AV_PKT_DATA_MASTERING_DISPLAY_METADATA) {
+        const AVMasteringDisplayMetadata *metadata =
+            (const AVMasteringDisplayMetadata *)entry->data;
+        if (metadata->has_primaries) {
+            addRational(sideData, "red_x", metadata->display_primaries[0][0]);
+            addRational(sideData, "red_y", metadata->display_primaries[0][1]);
+            addRational(sideData, "green_x",
+                        metadata->display_primaries[1][0]);
+            addRational(sideData, "green_y",
+                        metadata->display_primaries[1][1]);
+            addRational(sideData, "blue_x", metadata->display_primaries[2][0]);
+            addRational(sideData, "blue_y", metadata->display_primaries[2][1]);
+            addRational(sideData, "white_point_x", metadata->white_point[0]);
+            addRational(sideData, "white_point_y", metadata->white_point[1]);
+        }
+        if (metadata->has_luminance) {
+            addRational(sideData, "min_luminance", metadata->min_luminance);
+            addRational(sideData, "max_luminance", metadata->max_luminance);
+        }
+    } else if (entry->type == AV_PKT_DATA_CONTENT_LIGHT_LEVEL) {
+        const AVContentLightMetadata *metadata =
+            (const AVContentLightMetadata *)entry->data;
+        addInteger(sideData, "max_content", metadata->MaxCLL);
+        addInteger(sideData, "max_average", metadata->MaxFALL);
+    } else if (entry->type == AV_PKT_DATA_DOVI_CONF) {
+        const AVDOVIDecoderConfigurationRecord *dovi =
+            (const AVDOVIDecoderConfigurationRecord *)entry->data;
+        addInteger(sideData, "dv_version_major", dovi->dv_version_major);
+        addInteger(sideData, "dv_version_minor", dovi->dv_version_minor);
+        addInteger(sideData, "dv_profile", dovi->dv_profile);
+        addInteger(sideData, "dv_level", dovi->dv_level);
+        addInteger(sideData, "rpu_present_flag", dovi->rpu_present_flag);
+        addInteger(sideData, "el_present_flag", dovi->el_present_flag);
+        addInteger(sideData, "bl_present_flag", dovi->bl_present_flag);
+        addInteger(sideData, "dv_bl_signal_compatibility_id",
+                   dovi->dv_bl_signal_compatibility_id);
+    } else if (entry->type == AV_PKT_DATA_AUDIO_SERVICE_TYPE) {
+        addInteger(sideData, "service_type",
+                   *(const enum AVAudioServiceType *)entry->data);
+    } else if (entry->type == AV_PKT_DATA_MPEGTS_STREAM_ID) {
+        addInteger(sideData, "id", *entry->data);
+    } else if (entry->type == AV_PKT_DATA_CPB_PROPERTIES) {
+        const AVCPBProperties *properties =
+            (const AVCPBProperties *)entry->data;
+        addInteger(sideData, "max_bitrate", properties->max_bitrate);
+        addInteger(sideData, "min_bitrate", properties->min_bitrate);
+        addInteger(sideData, "avg_bitrate", properties->avg_bitrate);
+        addInteger(sideData, "buffer_size", properties->buffer_size);
+        addInteger(sideData, "vbv_delay", (int64_t)properties->vbv_delay);
+    } else if (entry->type == AV_PKT_DATA_AFD && entry->size > 0) {
+        addInteger(sideData, "active_format", *entry->data);
+    }
+
+    return sideData;
+}
+
+/**
+ * Returns the default of a decoder option, which is what FFprobe prints for
+ * values only set once frames are decoded.
+ */
+int64_t decoderDefault(const char *name) {
+    const AVClass *codecClass = avcodec_get_class();
+    const AVOption *option =
+        av_opt_find(&codecClass, name, NULL, 0, AV_OPT_SEARCH_FAKE_OBJ);
+
+    return option ? option->default_val.i64 : 0;
+}
+
+ffmpegkit::StreamFields toStreamFields(AVFormatContext *context,
+                                       AVStream *stream) {
+    ffmpegkit::StreamFields fields;
+    AVCodecParameters *parameters = stream->codecpar;
+    const AVCodecDescriptor *descriptor =
+        avcodec_descriptor_get(parameters->codec_id);
+    const char *profile =
+        avcodec_profile_name(parameters->codec_id, parameters->profile);
+    bool decodable = avcodec_find_decoder(parameters->codec_id) != NULL;
+    char buffer[128];
+
+    fields.index = (int64_t)stream->index;
+    if (descriptor) {
+        fields.codec = intern(descriptor->name);
+        fields.codecLong =
+            intern(descriptor->long_name ? descriptor->long_name : "unknown");
+    }
+    if (profile) {
+        fields.profile = intern(profile);
+    } else if (parameters->profile != AV_PROFILE_UNKNOWN) {
+        snprintf(buffer, sizeof(buffer), "%d", parameters->profile);
+        fields.profile = intern(buffer);
+    }
+    fields.type = intern(av_get_media_type_string(parameters->codec_type));
+    fields.codecTag =
+        intern(av_fourcc_make_string(buffer, parameters->codec_tag));
+    fields.codecTagValue = (int64_t)parameters->codec_tag;
+    if (context->iformat->flags & AVFMT_SHOW_IDS) {
+        fields.id = (int64_t)stream->id;
+    }
+
+    switch (parameters->codec_type) {
+    case AVMEDIA_TYPE_VIDEO: {
+        AVRational sar = av_guess_sample_aspect_ratio(context, stream, NULL);
+        AVRational dar;
+
+        fields.width = (int64_t)parameters->width;
+        fields.height = (int64_t)parameters->height;
+        fields.hasBFrames = (int64_t)parameters->video_delay;
+        if (sar.num) {
+            fields.sampleAspectRatio = internRational(sar, ':');
+            av_reduce(&dar.num, &dar.den, parameters->width * sar.num,
+                      parameters->height * sar.den, 1024 * 1024);
+            fields.displayAspectRatio = internRational(dar, ':');
+        }
+        fields.format =
+            intern(av_get_pix_fmt_name((enum AVPixelFormat)parameters->format));
+        fields.level = (int64_t)parameters->level;
+        if (parameters->color_range != AVCOL_RANGE_UNSPECIFIED) {
+            fields.colorRange =
+                intern(av_color_range_name(parameters->color_range));
+        }
+        if (parameters->color_space != AVCOL_SPC_UNSPECIFIED) {
+            fields.colorSpace =
+                intern(av_color_space_name(parameters->color_space));
+        }
+        if (parameters->color_trc != AVCOL_TRC_UNSPECIFIED) {
+            fields.colorTransfer =
+                intern(av_color_transfer_name(parameters->color_trc));
+        }
+        if (parameters->color_primaries != AVCOL_PRI_UNSPECIFIED) {
+            fields.colorPrimaries =
+                intern(av_color_primaries_name(parameters->color_primaries));
+        }
+        if (parameters->chroma_location != AVCHROMA_LOC_UNSPECIFIED) {
+            fields.chromaLocation =
+                intern(av_chroma_location_name(parameters->chroma_location));
+        }
+        fields.fieldOrder = toFieldOrder(parameters->field_order);
+        if (decodable) {
+            fields.refs = decoderDefault("refs");
+        }
+    } break;
+    case AVMEDIA_TYPE_AUDIO:
+        fields.sampleFormat = intern(
+            av_get_sample_fmt_name((enum AVSampleFormat)parameters->format));
+        fields.sampleRate = (int64_t)parameters->sample_rate;
+        fields.channels = (int64_t)parameters->ch_layout.nb_channels;
+        if (parameters->ch_layout.order != AV_CHANNEL_ORDER_UNSPEC) {
+            av_channel_layout_describe(&parameters->ch_layout, buffer,
+                                       sizeof(buffer));
+            fields.channelLayout = intern(buffer);
+        }
+        fields.bitsPerSample =
+            (int64_t)av_get_bits_per_sample(parameters->codec_id);
+        fields.initialPadding = (int64_t)parameters->initial_padding;
+        break;
+    case AVMEDIA_TYPE_SUBTITLE:
+        if (parameters->width) {
+            fields.width = (int64_t)parameters->width;
+        }
+        if (parameters->height) {
+            fields.height = (int64_t)parameters->height;
+        }
+        break;
+    default:
+        break;
+    }
+
+    fields.realFrameRate = internRational(stream->r_frame_rate, '/');
+    fields.averageFrameRate = internRational(stream->avg_frame_rate, '/');
+    fields.timeBase = internRational(stream->time_base, '/');
+    fields.startPts = toTimestamp(stream->start_time);
+    fields.startTime = toSeconds(stream->start_time, stream->time_base);
+    fields.durationTs = toTimestamp(stream->duration);
+    fields.duration = toSeconds(stream->duration, stream->time_base);
+    if (parameters->bit_rate > 0) {
+        fields.bitRate = parameters->bit_rate;
+    }
+    if (decodable && parameters->bits_per_raw_sample > 0) {
+        fields.bitsPerRawSample = (int64_t)parameters->bits_per_raw_sample;
+    }
+    if (stream->nb_frames) {
+        fields.nbFrames = stream->nb_frames;
+    }
+    if (parameters->extradata_size > 0) {
+        fields.extradataSize = (int64_t)parameters->extradata_size;
+    }
+    fields.disposition = (int64_t)stream->disposition;
+    fields.tags = toTags(stream->metadata);
+    for (int i = 0; i < parameters->nb_coded_side_data; i++) {
+        fields.sideData.push_back(
+            toSideDataFields(parameters, &parameters->coded_side_data[i]));
+    }
+
+    return fields;
+}
+
+ffmpegkit::ChapterFields toChapterFields(AVChapter *chapter) {
+    ffmpegkit::ChapterFields fields;
+
+    fields.id = chapter->id;
+    fields.timeBase = internRational(chapter->time_base, '/');
+    fields.start = chapter->start;
+    fields.startTime = toSeconds(chapter->start, chapter->time_base);
+    fields.end = chapter->end;
+    fields.endTime = toSeconds(chapter->end, chapter->time_base);
+    fields.tags = toTags(chapter->metadata);
+
+    return fields;
+}
+
+/**
+ * Fills the format timings stream analysis computes from the stream timings,
+ * the same way libavformat does, and flags them as estimated.
+ */
+void estimateTimings(const AVFormatContext *context,
+                     ffmpegkit::FormatFields &fields) {
+    int64_t start = INT64_MAX;
+    int64_t end = INT64_MIN;
+
+    for (unsigned int i = 0; i < context->nb_streams; i++) {
+        const AVStream *stream = context->streams[i];
+        int64_t streamStart = 0;
+
+        if (stream->start_time != AV_NOPTS_VALUE) {
+            streamStart = av_rescale_q(stream->start_time, stream->time_base,
+                                       AV_TIME_BASE_Q);
+            start = FFMIN(start, streamStart);
+        }
+        if (stream->duration != AV_NOPTS_VALUE) {
+            end = FFMAX(end, streamStart + av_rescale_q(stream->duration,
+                                                        stream->time_base,
+                                                        AV_TIME_BASE_Q));
+        }
+    }
+
+    if (!fields.startTime && start != INT64_MAX) {
+        fields.startTime = toSeconds(start, AV_TIME_BASE_Q);
+        fields.estimated |= ffmpegkit::EstimatedStartTime;
+    }
+    if (!fields.duration && end != INT64_MIN) {
+        int64_t duration = end - (start != INT64_MAX ? start : 0);
+        if (duration > 0) {
+            fields.duration = toSeconds(duration, AV_TIME_BASE_Q);
+            fields.estimated |= ffmpegkit::EstimatedDuration;
+        }
+    }
+    if (!fields.bitRate && fields.size && fields.duration &&
+        fields.duration.value() > 0) {
+        fields.bitRate =
+            (int64_t)(fields.size.value() * 8 / fields.duration.value());
+        fields.estimated |= ffmpegkit::EstimatedBitRate;
+    }
+}
+
+} // namespace
+
+int ffmpegkit::MediaInformationProbe::probe(
+    const std::string &path, const long sessionId,
+    std::shared_ptr<ffmpegkit::MediaInformation> &mediaInformation) {
+    return probe(path, sessionId, ffmpegkit::MediaInformationProbeOptions(),
+                 mediaInformation);
+}
+
+int ffmpegkit::MediaInformationProbe::probe(
+    const std::string &path, const long sessionId,
+    const ffmpegkit::MediaInformationProbeOptions &probeOptions,
+    std::shared_ptr<ffmpegkit::MediaInformation> &mediaInformation) {
+    AVFormatContext *context = avformat_alloc_context();
+    AVDictionary *options = NULL;
+    ProbeInterrupt interrupt = {sessionId, 0, false};
+    bool analysed = true;
+    bool analysisComplete = true;
+    char error[AV_ERROR_MAX_STRING_SIZE];
+    int ret;
+
+    if (context == NULL) {
+        return AVERROR(ENOMEM);
+    }
+    if (probeOptions.getDeadline() > 0) {
+        interrupt.deadline =
+            av_gettime_relative() + (int64_t)probeOptions.getDeadline() * 1000;
+    }
+    context->interrupt_callback.callback = probeInterrupt;
+    context->interrupt_callback.opaque = &interrupt;
+
+    // SAME OPTIONS AND ANALYSIS AS FFPROBE
+    av_dict_set(&options, "scan_all_pmts", "1", 0);
+    ret = avformat_open_input(&context, path.c_str(), NULL, &options);
+    av_dict_free(&options);
+    if (ret < 0 && interrupt.expired) {
+        ret = AVERROR(ETIMEDOUT);
+    }
+    if (ret >= 0 && probeOptions.isQuick()) {
+        // HEADERS ARE ENOUGH, OTHERWISE ANALYSE AS LITTLE AS POSSIBLE
+        analysed = needsAnalysis(context);
+        analysisComplete = false;
+        if (probeOptions.getQuickProbeSize() > 0) {
+            context->probesize =
+                FFMIN(context->probesize, probeOptions.getQuickProbeSize());
+        }
+        if (probeOptions.getQuickAnalyzeDuration() > 0) {
+            context->max_analyze_duration =
+                context->max_analyze_duration > 0
+                    ? FFMIN(context->max_analyze_duration,
+                            probeOptions.getQuickAnalyzeDuration())
+                    : probeOptions.getQuickAnalyzeDuration();
+        }
+    }
+    if (ret >= 0 && analysed) {
+        ret = avformat_find_stream_info(context, NULL);
+
+        // AN EXPIRED DEADLINE ONLY CUTS THE ANALYSIS SHORT
+        if (interrupt.expired) {
+            analysisComplete = false;
+            ret = 0;
+        }
+    }
+    if (ret < 0) {
+        av_strerror(ret, error, sizeof(error));
+        av_log(NULL, AV_LOG_ERROR, "%s: %s\n", path.c_str(), error);
+        avformat_close_input(&context);
+        return ret;
+    }
+
+    auto format = toFormatFields(context);
+    std::vector<ffmpegkit::StreamFields> streams;
+    std::vector<ffmpegkit::ChapterFields> chapters;
+
+    for (unsigned int i = 0; i < context->nb_streams; i++) {
+        streams.push_back(toStreamFields(context, context->streams[i]));
+    }
+    for (unsigned int i = 0; i < context->nb_chapters; i++) {
+        chapters.push_back(toChapterFields(context->chapters[i]));
+    }
+
+    if (analysed &&
+        context->duration_estimation_method == AVFMT_DURATION_FROM_BITRATE) {
+        format.estimated |= ffmpegkit::EstimatedDuration;
+        for (auto &stream : streams) {
+            if (stream.duration) {
+                stream.estimated |= ffmpegkit::EstimatedDuration;
+            }
+        }
+    }
+    if (!analysisComplete) {
+        estimateTimings(context, format);
+        format.estimated |= ffmpegkit::EstimatedCodecParameters;
+        for (auto &stream : streams) {
+            stream.estimated |= ffmpegkit::EstimatedCodecParameters |
+                                ffmpegkit::EstimatedFrameRate;
+        }
+    }
+
+    avformat_close_input(&context);
+
+    mediaInformation =
+        ffmpegkit::MediaInformation::fromFields(format, streams, chapters);
+
+    return 0;
+}
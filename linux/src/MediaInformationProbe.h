@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_PROBE_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_PROBE_H
+
+#include "MediaInformation.h"
+#include "MediaInformationProbeOptions.h"
+#include <memory>
+#include <string>
+
+namespace ffmpegkit {
+
+/**
+ * Extracts media information in-process with libavformat.
+ *
+ * <p>This is an alternative to running FFprobe and parsing its json output.
+ * The input is opened and analysed the same way FFprobe does, then fields are
+ * copied straight from the demuxer. Fields that FFprobe only reports after
+ * opening a decoder, like coded width and height, are not filled.
+ *
+ * <p>The json document of the key based getters has the keys of the fields
+ * in MediaInformationFields.h. Compared to FFprobe's -show_format
+ * -show_streams -show_chapters output it does not have:
+ * <ul>
+ * <li>coded_width, coded_height, closed_captions and film_grain, which need an
+ * opened decoder</li>
+ * <li>max_bit_rate, extradata_hash and the private options of the decoder and
+ * the demuxer</li>
+ * </ul>
+ * refs is the decoder default and bits_per_raw_sample is the demuxer's value,
+ * like FFprobe prints them before any frame is decoded. Entries of
+ * side_data_list with dynamic HDR10+ metadata or WebVTT data only have their
+ * side_data_type. tools/parity/probe_parity.cpp compares both outputs on a
+ * media file.
+ */
+class MediaInformationProbe {
+  public:
+    /**
+     * Opens the input and extracts its media information.
+     *
+     * @param path             path or url of a media file
+     * @param sessionId        session whose cancel request interrupts the
+     * probe, zero for none
+     * @param mediaInformation set to the media information extracted
+     * @return zero on success, a negative AVERROR code otherwise
+     */
+    static int
+    probe(const std::string &path, const long sessionId,
+          std::shared_ptr<ffmpegkit::MediaInformation> &mediaInformation);
+
+    /**
+     * Opens the input and extracts its media information using the given
+     * options.
+     *
+     * @param path             path or url of a media file
+     * @param sessionId        session whose cancel request interrupts the
+     * probe, zero for none
+     * @param probeOptions     probe options
+     * @param mediaInformation set to the media information extracted
+     * @return zero on success, AVERROR(ETIMEDOUT) if the deadline expired
+     * before the input was opened, a negative AVERROR code otherwise
+     */
+    static int
+    probe(const std::string &path, const long sessionId,
+          const ffmpegkit::MediaInformationProbeOptions &probeOptions,
+          std::shared_ptr<ffmpegkit::MediaInformation> &mediaInformation);
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_PROBE_H
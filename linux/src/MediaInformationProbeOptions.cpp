@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MediaInformationProbeOptions.h"
+
+ffmpegkit::MediaInformationProbeOptions::MediaInformationProbeOptions()
+    : _quick{false}, _deadline{0}, _quickProbeSize{DefaultQuickProbeSize},
+      _quickAnalyzeDuration{DefaultQuickAnalyzeDuration} {}
+
+void ffmpegkit::MediaInformationProbeOptions::setQuick(const bool quick) {
+    _quick = quick;
+}
+
+bool ffmpegkit::MediaInformationProbeOptions::isQuick() const {
+    return _quick;
+}
+
+void ffmpegkit::MediaInformationProbeOptions::setDeadline(const int deadline) {
+    _deadline = deadline;
+}
+
+int ffmpegkit::MediaInformationProbeOptions::getDeadline() const {
+    return _deadline;
+}
+
+void ffmpegkit::MediaInformationProbeOptions::setQuickProbeSize(
+    const int64_t quickProbeSize) {
+    _quickProbeSize = quickProbeSize;
+}
+
+int64_t ffmpegkit::MediaInformationProbeOptions::getQuickProbeSize() const {
+    return _quickProbeSize;
+}
+
+void ffmpegkit::MediaInformationProbeOptions::setQuickAnalyzeDuration(
+    const int64_t quickAnalyzeDuration) {
+    _quickAnalyzeDuration = quickAnalyzeDuration;
+}
+
+int64_t
+ffmpegkit::MediaInformationProbeOptions::getQuickAnalyzeDuration() const {
+    return _quickAnalyzeDuration;
+}
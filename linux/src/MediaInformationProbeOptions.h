@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_INFORMATION_PROBE_OPTIONS_H
+#define FFMPEG_KIT_MEDIA_INFORMATION_PROBE_OPTIONS_H
+
+#include <stdint.h>
+
+namespace ffmpegkit {
+
+/**
+ * Options of the in-process media information probe.
+ */
+class MediaInformationProbeOptions {
+  public:
+    /* in bytes */
+    static constexpr int64_t DefaultQuickProbeSize = 1024 * 1024;
+
+    /* in microseconds */
+    static constexpr int64_t DefaultQuickAnalyzeDuration = 500000;
+
+    MediaInformationProbeOptions();
+
+    /**
+     * Sets whether stream analysis is skipped when the container headers
+     * already define the codec and the dimensions or the sample rate and
+     * channels of every stream. If they don't, streams are analysed using at
+     * most the quick probe size and the quick analyze duration. Disabled by
+     * default.
+     *
+     * <p>Quick results may lack the fields only the analysis fills, like
+     * pixel formats, and flag the fields they estimate instead.
+     */
+    void setQuick(const bool quick);
+
+    bool isQuick() const;
+
+    /**
+     * Sets the wall-clock time limit of a probe in milliseconds, zero for no
+     * limit. Probes that are still opening the input when the deadline
+     * expires fail. Probes analysing the streams stop the analysis and
+     * return what is known, flagged as estimated.
+     */
+    void setDeadline(const int deadline);
+
+    int getDeadline() const;
+
+    /**
+     * Sets the maximum number of bytes read to analyse the streams in quick
+     * mode.
+     */
+    void setQuickProbeSize(const int64_t quickProbeSize);
+
+    int64_t getQuickProbeSize() const;
+
+    /**
+     * Sets the maximum duration of content analysed in quick mode, in
+     * microseconds.
+     */
+    void setQuickAnalyzeDuration(const int64_t quickAnalyzeDuration);
+
+    int64_t getQuickAnalyzeDuration() const;
+
+  private:
+    bool _quick;
+    int _deadline;
+    int64_t _quickProbeSize;
+    int64_t _quickAnalyzeDuration;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_INFORMATION_PROBE_OPTIONS_H
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_RECORD_H
+#define FFMPEG_KIT_MEDIA_RECORD_H
+
+#include <stdint.h>
+
+namespace ffmpegkit {
+
+/**
+ * A packet or a frame read by FFprobe. Timestamps are in the time base of the
+ * stream and are INT64_MIN, FFmpeg's AV_NOPTS_VALUE, when they are not
+ * defined.
+ */
+struct MediaRecord {
+    enum Type { Packet, Frame };
+
+    Type type;
+    int streamIndex;
+    int timeBaseNum;
+    int timeBaseDen;
+    int64_t pts;
+
+    /* dts of the packet, or of the packet a frame was decoded from */
+    int64_t dts;
+    int64_t duration;
+
+    /* byte position in the input, -1 if not known */
+    int64_t pos;
+
+    /* size of the packet, or of the packet a frame was decoded from */
+    int size;
+
+    /* AV_PKT_FLAG_* for packets, AV_FRAME_FLAG_* for frames */
+    int flags;
+    bool key;
+
+    /* AVPictureType of video frames, AV_PICTURE_TYPE_NONE otherwise */
+    int pictType;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_RECORD_H
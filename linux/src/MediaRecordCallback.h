@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEDIA_RECORD_CALLBACK_H
+#define FFMPEG_KIT_MEDIA_RECORD_CALLBACK_H
+
+#include "MediaRecord.h"
+#include <functional>
+#include <vector>
+
+namespace ffmpegkit {
+
+/**
+ * <p>Callback function that receives the packets and frames read by FFprobe,
+ * in batches and in reading order. <p>It is called from the thread running
+ * FFprobe. The vector is reused for the next batch, records that are needed
+ * later must be copied.
+ *
+ * @param records batch of records
+ */
+typedef std::function<void(const std::vector<ffmpegkit::MediaRecord> &records)>
+    MediaRecordCallback;
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEDIA_RECORD_CALLBACK_H
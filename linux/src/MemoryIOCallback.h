@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_MEMORY_IO_CALLBACK_H
+#define FFMPEG_KIT_MEMORY_IO_CALLBACK_H
+
+#include <cstdint>
+#include <functional>
+
+namespace ffmpegkit {
+
+/**
+ * <p>Callback that supplies the data read from a memory:// url.
+ *
+ * @param buffer buffer to fill
+ * @param size   maximum number of bytes to copy into the buffer
+ * @return number of bytes copied, zero at the end of the stream or a negative
+ * AVERROR code on failure
+ */
+typedef std::function<int(uint8_t *buffer, int size)> MemoryReadCallback;
+
+/**
+ * <p>Callback that consumes the data written to a memory:// url.
+ *
+ * @param buffer data written
+ * @param size   number of bytes in the buffer
+ * @return number of bytes consumed or a negative AVERROR code on failure
+ */
+typedef std::function<int(const uint8_t *buffer, int size)>
+    MemoryWriteCallback;
+
+/**
+ * <p>Callback that repositions a memory:// url.
+ *
+ * @param offset new position, relative to whence
+ * @param whence SEEK_SET, SEEK_CUR, SEEK_END or AVSEEK_SIZE (0x10000) to only
+ * query the total size
+ * @return the new position, the total size for AVSEEK_SIZE or a negative
+ * AVERROR code on failure
+ */
+typedef std::function<int64_t(int64_t offset, int whence)> MemorySeekCallback;
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_MEMORY_IO_CALLBACK_H
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OutputStatistics.h"
+
+ffmpegkit::OutputStatistics::OutputStatistics(const long sessionId,
+                                              const int fileIndex,
+                                              const std::string &url,
+                                              const uint64_t packets,
+                                              const uint64_t size,
+                                              const uint64_t bytesWritten,
+                                              const std::string &md5,
+                                              const std::string &sha256)
+    : _sessionId{sessionId}, _fileIndex{fileIndex}, _url{url},
+      _packets{packets}, _size{size}, _bytesWritten{bytesWritten}, _md5{md5},
+      _sha256{sha256} {}
+
+long ffmpegkit::OutputStatistics::getSessionId() { return _sessionId; }
+
+int ffmpegkit::OutputStatistics::getFileIndex() { return _fileIndex; }
+
+std::string ffmpegkit::OutputStatistics::getUrl() { return _url; }
+
+uint64_t ffmpegkit::OutputStatistics::getPackets() { return _packets; }
+
+uint64_t ffmpegkit::OutputStatistics::getSize() { return _size; }
+
+uint64_t ffmpegkit::OutputStatistics::getBytesWritten() {
+    return _bytesWritten;
+}
+
+std::string ffmpegkit::OutputStatistics::getMd5() { return _md5; }
+
+std::string ffmpegkit::OutputStatistics::getSha256() { return _sha256; }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFMPEG_KIT_OUTPUT_STATISTICS_H
+#define FFMPEG_KIT_OUTPUT_STATISTICS_H
+
+#include <stdint.h>
+#include <string>
+
+namespace ffmpegkit {
+
+/**
+ * Muxing statistics of a single output file of an FFmpeg execute session.
+ * Created once for each output, when its trailer is written.
+ */
+class OutputStatistics {
+  public:
+    OutputStatistics(const long sessionId, const int fileIndex,
+                     const std::string &url, const uint64_t packets,
+                     const uint64_t size, const uint64_t bytesWritten,
+                     const std::string &md5, const std::string &sha256);
+    long getSessionId();
+    int getFileIndex();
+    std::string getUrl();
+    uint64_t getPackets();
+    uint64_t getSize();
+
+    /**
+     * Returns the number of bytes written to the output, including headers,
+     * rewritten ranges and container overhead. Zero for outputs that are not
+     * written through a single protocol, like segmented outputs.
+     */
+    uint64_t getBytesWritten();
+
+    /**
+     * Returns the MD5 digest of the completed output file as a lowercase hex
+     * string, empty unless requested with the -digest option.
+     */
+    std::string getMd5();
+
+    /**
+     * Returns the SHA-256 digest of the completed output file as a lowercase
+     * hex string, empty unless requested with the -digest option.
+     */
+    std::string getSha256();
+
+  private:
+    long _sessionId;
+    int _fileIndex;
+    std::string _url;
+    uint64_t _packets;
+    uint64_t _size;
+    uint64_t _bytesWritten;
+    std::string _md5;
+    std::string _sha256;
+};
+
+} // namespace ffmpegkit
+
+#endif // FFMPEG_KIT_OUTPUT_STATISTICS_H
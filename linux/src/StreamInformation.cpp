@@ -19,90 +19,116 @@
 
 #include "StreamInformation.h"
 
+static constexpr const char *StreamInformationKeyStreams = "streams";
+
 ffmpegkit::StreamInformation::StreamInformation(
     std::shared_ptr<rapidjson::Value> streamInformationValue)
-    : _streamInformationValue{streamInformationValue} {}
+    : _position{-1} {
+    if (streamInformationValue != nullptr) {
+        _fields = StreamFields::from(*streamInformationValue);
+        _json = std::make_shared<LazyJsonDocument>(
+            LazyJsonDocument::copy(*streamInformationValue));
+    }
+}
+
+ffmpegkit::StreamInformation::StreamInformation(
+    const StreamFields &fields, std::shared_ptr<LazyJsonDocument> json,
+    size_t position)
+    : _fields{fields}, _json{json}, _position{(int64_t)position} {}
+
+const ffmpegkit::StreamFields &
+ffmpegkit::StreamInformation::getFields() const {
+    return _fields;
+}
 
 std::shared_ptr<int64_t> ffmpegkit::StreamInformation::getIndex() {
-    return getNumberProperty(KeyIndex);
+    return toSharedNumber(_fields.index);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getType() {
-    return getStringProperty(KeyType);
+    return toSharedString(_fields.type);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getCodec() {
-    return getStringProperty(KeyCodec);
+    return toSharedString(_fields.codec);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getCodecLong() {
-    return getStringProperty(KeyCodecLong);
+    return toSharedString(_fields.codecLong);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getFormat() {
-    return getStringProperty(KeyFormat);
+    return toSharedString(_fields.format);
 }
 
 std::shared_ptr<int64_t> ffmpegkit::StreamInformation::getWidth() {
-    return getNumberProperty(KeyWidth);
+    return toSharedNumber(_fields.width);
 }
 
 std::shared_ptr<int64_t> ffmpegkit::StreamInformation::getHeight() {
-    return getNumberProperty(KeyHeight);
+    return toSharedNumber(_fields.height);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getBitrate() {
-    return getStringProperty(KeyBitRate);
+    if (_fields.bitRate || !_fields.lossy) {
+        return toSharedString(_fields.bitRate);
+    } else {
+        return getStringProperty(KeyBitRate);
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getSampleRate() {
-    return getStringProperty(KeySampleRate);
+    if (_fields.sampleRate || !_fields.lossy) {
+        return toSharedString(_fields.sampleRate);
+    } else {
+        return getStringProperty(KeySampleRate);
+    }
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getSampleFormat() {
-    return getStringProperty(KeySampleFormat);
+    return toSharedString(_fields.sampleFormat);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getChannelLayout() {
-    return getStringProperty(KeyChannelLayout);
+    return toSharedString(_fields.channelLayout);
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::StreamInformation::getSampleAspectRatio() {
-    return getStringProperty(KeySampleAspectRatio);
+    return toSharedString(_fields.sampleAspectRatio);
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::StreamInformation::getDisplayAspectRatio() {
-    return getStringProperty(KeyDisplayAspectRatio);
+    return toSharedString(_fields.displayAspectRatio);
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::StreamInformation::getAverageFrameRate() {
-    return getStringProperty(KeyAverageFrameRate);
+    return toSharedString(_fields.averageFrameRate);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getRealFrameRate() {
-    return getStringProperty(KeyRealFrameRate);
+    return toSharedString(_fields.realFrameRate);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getTimeBase() {
-    return getStringProperty(KeyTimeBase);
+    return toSharedString(_fields.timeBase);
 }
 
 std::shared_ptr<std::string> ffmpegkit::StreamInformation::getCodecTimeBase() {
-    return getStringProperty(KeyCodecTimeBase);
+    return toSharedString(_fields.codecTimeBase);
 }
 
 std::shared_ptr<rapidjson::Value> ffmpegkit::StreamInformation::getTags() {
-    return getProperty(KeyTags);
+    return toSharedTags(_fields.tags);
 }
 
 std::shared_ptr<std::string>
 ffmpegkit::StreamInformation::getStringProperty(const char *key) {
-    if (_streamInformationValue->HasMember(key)) {
-        return std::make_shared<std::string>(
-            (*_streamInformationValue)[key].GetString());
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsString()) {
+        return std::make_shared<std::string>(value->GetString());
     } else {
         return nullptr;
     }
@@ -110,9 +136,10 @@ ffmpegkit::StreamInformation::getStringProperty(const char *key) {
 
 std::shared_ptr<int64_t>
 ffmpegkit::StreamInformation::getNumberProperty(const char *key) {
-    if (_streamInformationValue->HasMember(key)) {
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr && value->IsNumber()) {
         return std::make_shared<int64_t>(
-            (*_streamInformationValue)[key].GetInt64());
+            value->IsInt64() ? value->GetInt64() : (int64_t)value->GetDouble());
     } else {
         return nullptr;
     }
@@ -120,10 +147,9 @@ ffmpegkit::StreamInformation::getNumberProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::StreamInformation::getProperty(const char *key) {
-    if (_streamInformationValue->HasMember(key)) {
-        auto value = std::make_shared<rapidjson::Value>();
-        *value = (*_streamInformationValue)[key];
-        return value;
+    auto value = LazyJsonDocument::findMember(getValue(), key);
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
@@ -131,11 +157,21 @@ ffmpegkit::StreamInformation::getProperty(const char *key) {
 
 std::shared_ptr<rapidjson::Value>
 ffmpegkit::StreamInformation::getAllProperties() {
-    if (_streamInformationValue != nullptr) {
-        auto all = std::make_shared<rapidjson::Value>();
-        *all = (*_streamInformationValue);
-        return all;
+    auto value = getValue();
+    if (value != nullptr) {
+        return LazyJsonDocument::copy(*value);
     } else {
         return nullptr;
     }
 }
+
+const rapidjson::Value *ffmpegkit::StreamInformation::getValue() const {
+    if (_json == nullptr) {
+        return nullptr;
+    } else if (_position < 0) {
+        return &_json->getRoot();
+    } else {
+        return LazyJsonDocument::findElement(
+            _json->getRoot(), StreamInformationKeyStreams, (size_t)_position);
+    }
+}
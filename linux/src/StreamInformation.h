@@ -22,6 +22,7 @@
 
 // OVERRIDING THE MACRO TO PREVENT APPLICATION TERMINATION
 #define RAPIDJSON_ASSERT(x)
+#include "MediaInformationFields.h"
 #include "rapidjson/document.h"
 #include <memory>
 #include <string>
@@ -54,6 +55,23 @@ class StreamInformation {
 
     StreamInformation(std::shared_ptr<rapidjson::Value> streamInformationValue);
 
+    /**
+     * Creates a stream from fields already extracted. Keys that are not
+     * extracted are looked up in the element of the streams array at the
+     * given position of the json document.
+     */
+    StreamInformation(const StreamFields &fields,
+                      std::shared_ptr<LazyJsonDocument> json,
+                      size_t position);
+
+    /**
+     * Returns the typed fields of this stream. Unlike the other getters this
+     * neither allocates nor accesses the json document.
+     *
+     * @return stream fields
+     */
+    const StreamFields &getFields() const;
+
     /**
      * Returns stream index.
      *
@@ -210,7 +228,13 @@ class StreamInformation {
     std::shared_ptr<rapidjson::Value> getAllProperties();
 
   private:
-    std::shared_ptr<rapidjson::Value> _streamInformationValue;
+    const rapidjson::Value *getValue() const;
+
+    StreamFields _fields;
+    std::shared_ptr<LazyJsonDocument> _json;
+
+    /* -1 if the root of the document is the stream */
+    int64_t _position;
 };
 
 } // namespace ffmpegkit
@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fftools_digest_io.h"
+
+#include "libavutil/avstring.h"
+#include "libavutil/common.h"
+#include "libavutil/error.h"
+#include "libavutil/log.h"
+#include "libavutil/mem.h"
+#include "libavutil/md5.h"
+#include "libavutil/opt.h"
+#include "libavutil/sha.h"
+
+#define DIGEST_IO_BUFFER_SIZE 32768
+/* distance between saved hash states; after a rewrite the file is read
+ * back from the last state before the rewritten offset to its end */
+#define DIGEST_IO_CHECKPOINT (16 << 20)
+
+typedef struct DigestCheckpoint {
+    int64_t offset;
+    /* av_md5_size bytes of MD5 state followed by av_sha_size of SHA state */
+    uint8_t *state;
+} DigestCheckpoint;
+
+struct DigestIO {
+    /* the wrapped context and the hashing context in front of it */
+    AVIOContext *inner;
+    AVIOContext *pb;
+    char *url;
+    /* interrupt callback and options the file was opened with */
+    AVIOInterruptCB int_cb;
+    AVDictionary *opts;
+
+    /* io_open of the muxer, see digest_io_set_muxer() */
+    int (*io_open)(AVFormatContext *s, AVIOContext **pb, const char *url,
+                   int flags, AVDictionary **options);
+
+    struct AVMD5 *md5;
+    struct AVSHA *sha;
+
+    /* bytes [0, hashed) of the file went through the hashes */
+    int64_t hashed;
+    /* position of the inner context */
+    int64_t pos;
+    /* end of the written data */
+    int64_t end;
+    /* lowest offset below hashed that was written again, INT64_MAX if none */
+    int64_t dirty;
+
+    DigestCheckpoint *checkpoints;
+    int nb_checkpoints;
+
+    int finished;
+    char md5_hex[33];
+    char sha256_hex[65];
+};
+
+int digest_io_parse(void *logctx, const char *spec, int *types) {
+    char *list = av_strdup(spec);
+    char *name, *save = NULL;
+    int ret = 0;
+
+    if (!list)
+        return AVERROR(ENOMEM);
+
+    *types = 0;
+    for (name = av_strtok(list, ",+", &save); name;
+         name = av_strtok(NULL, ",+", &save)) {
+        if (!av_strcasecmp(name, "md5")) {
+            *types |= DIGEST_IO_MD5;
+        } else if (!av_strcasecmp(name, "sha256")) {
+            *types |= DIGEST_IO_SHA256;
+        } else {
+            av_log(logctx, AV_LOG_ERROR,
+                   "Unknown digest '%s', supported digests are md5 and "
+                   "sha256\n",
+                   name);
+            ret = AVERROR(EINVAL);
+            break;
+        }
+    }
+
+    av_free(list);
+    return ret;
+}
+
+/* whether the '+' or '-' separated list of flags sets name */
+static int digest_flag_set(const char *flags, const char *name) {
+    int set = 0;
+
+    while (*flags) {
+        int remove = *flags == '-';
+        size_t len;
+
+        if (*flags == '+' || *flags == '-')
+            flags++;
+        len = strcspn(flags, "+-");
+        if (len == strlen(name) && !strncmp(flags, name, len))
+            set = !remove;
+        flags += len;
+    }
+
+    return set;
+}
+
+int digest_io_check_muxer(void *logctx, const AVOutputFormat *oformat,
+                          const AVDictionary *opts) {
+    static const char *const fragment_flags[] = {
+        "frag_keyframe", "empty_moov", "frag_custom", "frag_every_frame",
+        "dash",          "cmaf",       "isml"};
+    const AVClass *priv_class = oformat->priv_class;
+    const AVDictionaryEntry *movflags;
+    const char *flags;
+    int fragmented;
+
+    if (!priv_class || !av_opt_find(&priv_class, "movflags", NULL, 0,
+                                    AV_OPT_SEARCH_FAKE_OBJ))
+        return 0;
+
+    movflags = av_dict_get(opts, "movflags", NULL, 0);
+    flags = movflags ? movflags->value : "";
+
+    /* ismv output is always fragmented */
+    fragmented = !strcmp(oformat->name, "ismv") ||
+                 av_dict_get(opts, "frag_duration", NULL, 0) ||
+                 av_dict_get(opts, "frag_size", NULL, 0);
+    for (int i = 0; i < FF_ARRAY_ELEMS(fragment_flags); i++)
+        fragmented |= digest_flag_set(flags, fragment_flags[i]);
+
+    if (!fragmented || digest_flag_set(flags, "faststart") ||
+        digest_flag_set(flags, "global_sidx")) {
+        av_log(logctx, AV_LOG_ERROR,
+               "Option -digest is not supported for a %s output unless it is "
+               "fragmented, e.g. with -movflags frag_keyframe+empty_moov, "
+               "and written without +faststart or +global_sidx: the muxer "
+               "rewrites the start of the file at the end, which would have "
+               "to be read back in full\n",
+               oformat->name);
+        return AVERROR(EINVAL);
+    }
+
+    return 0;
+}
+
+static void digest_checkpoint_save(DigestIO *d) {
+    DigestCheckpoint *checkpoints, *c;
+
+    checkpoints = av_realloc_array(d->checkpoints, d->nb_checkpoints + 1,
+                                   sizeof(*checkpoints));
+    if (!checkpoints)
+        return;
+    d->checkpoints = checkpoints;
+
+    c = &d->checkpoints[d->nb_checkpoints];
+    c->state = av_malloc(av_md5_size + av_sha_size);
+    if (!c->state)
+        return;
+    c->offset = d->hashed;
+    if (d->md5)
+        memcpy(c->state, d->md5, av_md5_size);
+    if (d->sha)
+        memcpy(c->state + av_md5_size, d->sha, av_sha_size);
+    d->nb_checkpoints++;
+}
+
+/* go back to the last saved state at or before offset */
+static void digest_checkpoint_restore(DigestIO *d, int64_t offset) {
+    while (d->nb_checkpoints &&
+           d->checkpoints[d->nb_checkpoints - 1].offset > offset)
+        av_freep(&d->checkpoints[--d->nb_checkpoints].state);
+
+    if (d->nb_checkpoints) {
+        DigestCheckpoint *c = &d->checkpoints[d->nb_checkpoints - 1];
+
+        if (d->md5)
+            memcpy(d->md5, c->state, av_md5_size);
+        if (d->sha)
+            memcpy(d->sha, c->state + av_md5_size, av_sha_size);
+        d->hashed = c->offset;
+    } else {
+        if (d->md5)
+            av_md5_init(d->md5);
+        if (d->sha)
+            av_sha_init(d->sha, 256);
+        d->hashed = 0;
+    }
+}
+
+static void digest_hash(DigestIO *d, const uint8_t *buf, int64_t size) {
+    while (size > 0) {
+        int64_t next =
+            (d->hashed / DIGEST_IO_CHECKPOINT + 1) * DIGEST_IO_CHECKPOINT;
+        int64_t len = FFMIN(size, next - d->hashed);
+
+        if (d->md5)
+            av_md5_update(d->md5, buf, len);
+        if (d->sha)
+            av_sha_update(d->sha, buf, len);
+        d->hashed += len;
+        buf += len;
+        size -= len;
+
+        if (d->hashed == next)
+            digest_checkpoint_save(d);
+    }
+}
+
+/* hash the part of [pos, pos + size) that continues the hashed range; data
+ * after a gap is left to digest_io_finish() */
+static void digest_update(DigestIO *d, int64_t pos, const uint8_t *buf,
+                          int size) {
+    if (d->dirty != INT64_MAX || pos > d->hashed || pos + size <= d->hashed)
+        return;
+
+    digest_hash(d, buf + (d->hashed - pos), pos + size - d->hashed);
+}
+
+static int digest_io_read(void *opaque, uint8_t *buf, int buf_size) {
+    DigestIO *d = opaque;
+    int ret = avio_read_partial(d->inner, buf, buf_size);
+
+    if (ret == 0)
+        return AVERROR_EOF;
+    if (ret < 0)
+        return ret;
+
+    digest_update(d, d->pos, buf, ret);
+    d->pos += ret;
+
+    return ret;
+}
+
+#if FF_API_AVIO_WRITE_NONCONST
+static int digest_io_write(void *opaque, uint8_t *buf, int buf_size) {
+#else
+static int digest_io_write(void *opaque, const uint8_t *buf, int buf_size) {
+#endif
+    DigestIO *d = opaque;
+
+    avio_write(d->inner, buf, buf_size);
+    if (d->inner->error < 0)
+        return d->inner->error;
+
+    if (d->pos < d->hashed)
+        d->dirty = FFMIN(d->dirty, d->pos);
+    digest_update(d, d->pos, buf, buf_size);
+    d->pos += buf_size;
+    d->end = FFMAX(d->end, d->pos);
+
+    return buf_size;
+}
+
+static int64_t digest_io_seek(void *opaque, int64_t offset, int whence) {
+    DigestIO *d = opaque;
+    int64_t ret;
+
+    if (whence == AVSEEK_SIZE) {
+        /* the size must include what the inner context still buffers */
+        if (d->pb->write_flag)
+            avio_flush(d->inner);
+        return avio_size(d->inner);
+    }
+
+    ret = avio_seek(d->inner, offset, whence);
+    if (ret >= 0)
+        d->pos = ret;
+
+    return ret;
+}
+
+int digest_io_wrap(DigestIO **pd, AVIOContext **pb, const char *url,
+                   const AVIOInterruptCB *int_cb, const AVDictionary *opts,
+                   int types) {
+    AVIOContext *inner = *pb;
+    DigestIO *d;
+    uint8_t *buffer;
+
+    d = av_mallocz(sizeof(*d));
+    if (!d)
+        return AVERROR(ENOMEM);
+
+    d->inner = inner;
+    d->dirty = INT64_MAX;
+    d->url = av_strdup(url);
+    if (!d->url)
+        goto fail;
+    if (int_cb)
+        d->int_cb = *int_cb;
+    if (av_dict_copy(&d->opts, opts, 0) < 0)
+        goto fail;
+
+    if (types & DIGEST_IO_MD5) {
+        d->md5 = av_md5_alloc();
+        if (!d->md5)
+            goto fail;
+        av_md5_init(d->md5);
+    }
+    if (types & DIGEST_IO_SHA256) {
+        d->sha = av_sha_alloc();
+        if (!d->sha)
+            goto fail;
+        av_sha_init(d->sha, 256);
+    }
+
+    buffer = av_malloc(DIGEST_IO_BUFFER_SIZE);
+    if (!buffer)
+        goto fail;
+    d->pb = avio_alloc_context(buffer, DIGEST_IO_BUFFER_SIZE,
+                               inner->write_flag, d,
+                               inner->write_flag ? NULL : digest_io_read,
+                               inner->write_flag ? digest_io_write : NULL,
+                               inner->seekable ? digest_io_seek : NULL);
+    if (!d->pb) {
+        av_free(buffer);
+        goto fail;
+    }
+    d->pb->seekable = inner->seekable;
+
+    *pd = d;
+    *pb = d->pb;
+
+    return 0;
+fail:
+    av_freep(&d->md5);
+    av_freep(&d->sha);
+    av_freep(&d->url);
+    av_dict_free(&d->opts);
+    av_free(d);
+    return AVERROR(ENOMEM);
+}
+
+static int digest_io_open(AVFormatContext *s, AVIOContext **pb,
+                          const char *url, int flags,
+                          AVDictionary **options) {
+    DigestIO *d = s->opaque;
+
+    /* a muxer reading its own output must see all the data written so far */
+    if (!strcmp(url, d->url)) {
+        avio_flush(d->pb);
+        avio_flush(d->inner);
+    }
+
+    return d->io_open(s, pb, url, flags, options);
+}
+
+void digest_io_set_muxer(DigestIO *d, AVFormatContext *s) {
+    d->io_open = s->io_open;
+    s->io_open = digest_io_open;
+    s->opaque = d;
+}
+
+static void digest_hex(char *dst, const uint8_t *digest, int size) {
+    for (int i = 0; i < size; i++)
+        snprintf(dst + 2 * i, 3, "%02x", digest[i]);
+}
+
+/* hash [hashed, size) of the file as it is now */
+static int digest_read_back(DigestIO *d, int64_t size) {
+    AVIOContext *rpb = NULL;
+    AVDictionary *opts = NULL;
+    uint8_t *buf;
+    int64_t start = d->hashed;
+    int ret;
+
+    buf = av_malloc(DIGEST_IO_BUFFER_SIZE);
+    if (!buf)
+        return AVERROR(ENOMEM);
+
+    ret = av_dict_copy(&opts, d->opts, 0);
+    if (ret >= 0)
+        ret = avio_open2(&rpb, d->url, AVIO_FLAG_READ,
+                         d->int_cb.callback ? &d->int_cb : NULL, &opts);
+    av_dict_free(&opts);
+    if (ret >= 0) {
+        int64_t pos = avio_seek(rpb, d->hashed, SEEK_SET);
+        if (pos < 0)
+            ret = pos;
+    }
+
+    while (ret >= 0 && d->hashed < size) {
+        ret = avio_read(rpb, buf,
+                        FFMIN(size - d->hashed, DIGEST_IO_BUFFER_SIZE));
+        if (ret == 0)
+            ret = AVERROR_EOF;
+        if (ret > 0)
+            digest_hash(d, buf, ret);
+    }
+
+    avio_closep(&rpb);
+    av_free(buf);
+
+    if (ret < 0)
+        return ret;
+
+    av_log(NULL, AV_LOG_INFO,
+           "Read back %" PRId64 " bytes of %s to complete its digest\n",
+           size - start, d->url);
+
+    return 0;
+}
+
+int digest_io_finish(DigestIO *d) {
+    uint8_t digest[32];
+    int64_t size;
+    int ret = 0;
+
+    if (d->finished)
+        return 0;
+    d->finished = 1;
+
+    if (d->pb->write_flag) {
+        avio_flush(d->pb);
+        avio_flush(d->inner);
+        size = d->end;
+    } else {
+        size = avio_size(d->inner);
+        /* an input that cannot be read again must have been read to the
+         * end */
+        if (size < 0 && !d->inner->eof_reached)
+            ret = AVERROR(ENOSYS);
+        size = FFMAX(size, d->hashed);
+    }
+
+    if (ret >= 0 && FFMIN(d->dirty, d->hashed) < size) {
+        digest_checkpoint_restore(d, FFMIN(d->dirty, d->hashed));
+        d->dirty = INT64_MAX;
+        ret = digest_read_back(d, size);
+    }
+
+    if (ret < 0) {
+        av_log(NULL, AV_LOG_WARNING,
+               "Could not complete the digest of %s: %s\n",
+               d->url, av_err2str(ret));
+        return ret;
+    }
+
+    if (d->md5) {
+        av_md5_final(d->md5, digest);
+        digest_hex(d->md5_hex, digest, 16);
+    }
+    if (d->sha) {
+        av_sha_final(d->sha, digest);
+        digest_hex(d->sha256_hex, digest, 32);
+    }
+
+    return 0;
+}
+
+const char *digest_io_md5(const DigestIO *d) {
+    return d && d->md5_hex[0] ? d->md5_hex : NULL;
+}
+
+const char *digest_io_sha256(const DigestIO *d) {
+    return d && d->sha256_hex[0] ? d->sha256_hex : NULL;
+}
+
+int digest_io_closep(DigestIO **pd, AVIOContext **pb) {
+    DigestIO *d = *pd;
+    int ret;
+
+    if (!d)
+        return pb ? avio_closep(pb) : 0;
+
+    if (d->pb->write_flag)
+        avio_flush(d->pb);
+    av_freep(&d->pb->buffer);
+    avio_context_free(&d->pb);
+    ret = avio_closep(&d->inner);
+
+    for (int i = 0; i < d->nb_checkpoints; i++)
+        av_freep(&d->checkpoints[i].state);
+    av_freep(&d->checkpoints);
+    av_freep(&d->md5);
+    av_freep(&d->sha);
+    av_freep(&d->url);
+    av_dict_free(&d->opts);
+    av_freep(pd);
+
+    if (pb)
+        *pb = NULL;
+
+    return ret;
+}
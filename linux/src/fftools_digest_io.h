@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FFTOOLS_DIGEST_IO_H
+#define FFTOOLS_DIGEST_IO_H
+
+#include "libavformat/avformat.h"
+#include "libavformat/avio.h"
+#include "libavutil/dict.h"
+
+enum DigestIOType {
+    DIGEST_IO_MD5 = 1 << 0,
+    DIGEST_IO_SHA256 = 1 << 1,
+};
+
+/**
+ * An AVIOContext placed in front of another one, which computes digests of
+ * the file while it is being written or read.
+ *
+ * Bytes are hashed as they pass through, so a file that is written or read
+ * from start to end is never read again. When an output is rewritten below
+ * the hashed position, e.g. when a muxer patches its header in the trailer,
+ * or when parts of an input are never read, the missing range is read back
+ * from the file, starting at the last saved hash state before it and up
+ * to the end of the file, since both digests must see the bytes in order.
+ * The read back is logged with its size.
+ *
+ * Muxers of the mov family patch the mdat size at the start of the file and
+ * +faststart rewrites all of it, which would always cost a full read, so
+ * their outputs must be fragmented, see digest_io_check_muxer().
+ */
+typedef struct DigestIO DigestIO;
+
+/**
+ * Parse a list of digest names separated by ',' or '+' into a mask of
+ * DigestIOType values.
+ */
+int digest_io_parse(void *logctx, const char *spec, int *types);
+
+/**
+ * Check that the digest of an output of the given muxer can be computed
+ * while it is written. Outputs of the mov family must be fragmented and must
+ * not use +faststart or +global_sidx.
+ *
+ * @param opts options of the muxer
+ * @return 0 if supported, AVERROR(EINVAL) with an error logged otherwise
+ */
+int digest_io_check_muxer(void *logctx, const AVOutputFormat *oformat,
+                          const AVDictionary *opts);
+
+/**
+ * Wrap an opened AVIOContext. On success *pb is replaced with the hashing
+ * context, which must then be closed with digest_io_closep().
+ *
+ * @param url    url of the file, used to read back missing ranges
+ * @param int_cb interrupt callback the file was opened with, may be NULL
+ * @param opts   options the file was opened with, may be NULL; both are
+ *               used again to read back missing ranges
+ */
+int digest_io_wrap(DigestIO **pd, AVIOContext **pb, const char *url,
+                   const AVIOInterruptCB *int_cb, const AVDictionary *opts,
+                   int types);
+
+/**
+ * Make the muxer of s write out the data buffered in front of its output
+ * before it opens the output again, e.g. to read it back while shifting the
+ * data. s->io_open and s->opaque are replaced, so d must stay open until
+ * the muxer has written the trailer.
+ */
+void digest_io_set_muxer(DigestIO *d, AVFormatContext *s);
+
+/**
+ * Complete the digests. For outputs this must be called once the muxer has
+ * written the trailer, for inputs once demuxing has stopped.
+ */
+int digest_io_finish(DigestIO *d);
+
+/**
+ * Return the digest as a lowercase hex string, NULL if it was not requested
+ * or could not be completed.
+ */
+const char *digest_io_md5(const DigestIO *d);
+const char *digest_io_sha256(const DigestIO *d);
+
+/**
+ * Close the hashing context and the context it wraps, or only *pb when *pd is
+ * NULL. Both pointers are set to NULL.
+ */
+int digest_io_closep(DigestIO **pd, AVIOContext **pb);
+
+#endif // FFTOOLS_DIGEST_IO_H
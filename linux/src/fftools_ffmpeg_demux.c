@@ -26,6 +26,27 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - demuxer thread sends packets to the main thread in batches
+ * - demuxer queue size adapts between thread_queue_size and
+ * thread_queue_size_max, producer/consumer stall times are recorded and
+ * forwarded through input_stats_callback
+ * - packets passed to the main thread come from a per-input ObjPool, returned
+ * by ifile_packet_release()
+ * - stream_loop_cache option added, packets of a looped input are cached and
+ * replayed instead of seeking and demuxing the input again
+ * - bytes read from the input AVIOContext logged and forwarded through
+ * input_stats_callback
+ * - concat_prefetch and concat_prefetch_size options added, the first bytes
+ * of the next local entries of a concat list are read ahead on a background
+ * thread
+ * - input AVIOContext wrapped by DigestIO when the digest option is set,
+ * digests forwarded through input_stats_callback
+ * - seeks with -ss use the seek index sidecar file of the input when there
+ * is one, seek_index option added
+ * - file_fadvise option set on file: inputs by the session page cache policy
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -38,14 +59,24 @@
  * - fftools_ffmpeg_mux.h include added
  */
 
+#include <fcntl.h>
 #include <float.h>
+#include <stdatomic.h>
 #include <stdint.h>
 
+#include "fftools_digest_io.h"
+#include "fftools_seek_index.h"
 #include "fftools_ffmpeg.h"
 #include "fftools_ffmpeg_mux.h"
+#include "fftools_objpool.h"
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 
 #include "libavutil/avassert.h"
 #include "libavutil/avstring.h"
+#include "libavutil/bprint.h"
 #include "libavutil/display.h"
 #include "libavutil/error.h"
 #include "libavutil/intreadwrite.h"
@@ -63,6 +94,11 @@
 
 #include "ffmpeg_context.h"
 
+extern void (*input_stats_callback)(int, const char *, uint64_t, uint64_t,
+                                    double, double, int, int, int, uint64_t,
+                                    uint64_t, uint64_t, const char *,
+                                    const char *);
+
 static const char *const opt_name_discard[] = {"discard", NULL};
 static const char *const opt_name_reinit_filters[] = {"reinit_filter", NULL};
 static const char *const opt_name_fix_sub_duration[] = {"fix_sub_duration",
@@ -81,6 +117,87 @@ static const char *const opt_name_display_rotations[] = {"display_rotation",
 static const char *const opt_name_display_hflips[] = {"display_hflip", NULL};
 static const char *const opt_name_display_vflips[] = {"display_vflip", NULL};
 
+/* upper bound for Demuxer.batch_size */
+#define DEMUX_MSG_MAX_PACKETS 16
+/* a partially filled batch is never held back for longer than this (in us) */
+#define DEMUX_MSG_MAX_DELAY 10000
+/* default upper bound for the adaptive demuxer queue size */
+#define DEMUX_QUEUE_MAX_DEFAULT 32
+/* number of messages after which the demuxer queue may shrink */
+#define DEMUX_QUEUE_WINDOW 256
+/* default bound for the data read ahead by -concat_prefetch, in bytes */
+#define CONCAT_PREFETCH_SIZE_DEFAULT (32 << 20)
+/* interval at which the prefetch thread checks the demuxer position (in us) */
+#define CONCAT_PREFETCH_POLL 50000
+
+enum LoopCacheState {
+    /* not enabled, or the input did not fit */
+    LOOP_CACHE_OFF,
+    /* waiting for a pass that starts at the beginning of the input */
+    LOOP_CACHE_WAIT,
+    /* caching the packets of the current pass */
+    LOOP_CACHE_FILL,
+    /* a full pass is cached, packets are read from the cache */
+    LOOP_CACHE_REPLAY,
+};
+
+typedef struct PrefetchEntry {
+    char *url;
+    /* values of the duration, inpoint and outpoint directives */
+    int64_t user_duration;
+    int64_t inpoint;
+    int64_t outpoint;
+    /* playing time of the entry in AV_TIME_BASE units, AV_NOPTS_VALUE when
+     * it could not be found */
+    int64_t duration;
+} PrefetchEntry;
+
+/* -concat_prefetch state; the concat demuxer opens and probes each entry of
+ * the list only when the previous one ends, so the prefetch thread asks the
+ * kernel to read the first bytes of the next local entries ahead of time,
+ * which leaves their headers in the page cache. Entries are not opened as
+ * media files, which would read them twice, and entries that are not local
+ * files are skipped */
+typedef struct ConcatPrefetch {
+    void *logctx;
+    char *list_url;
+    /* protocol white and black lists of the input, used to read the list */
+    AVDictionary *opts;
+    /* the safe option of the concat demuxer */
+    int safe;
+    /* number of entries prefetched ahead of the one being demuxed */
+    int depth;
+    /* bytes read ahead for each entry, so that at most depth * entry_size
+     * bytes of pre-read data are waiting to be used */
+    int64_t entry_size;
+
+    /* owned by the prefetch thread until it is joined */
+    PrefetchEntry *entries;
+    int nb_entries;
+    int nb_prefetched;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    atomic_int stop;
+    /* latest timestamp returned by the concat demuxer, in AV_TIME_BASE */
+    atomic_int_least64_t ts;
+    /* number of times the packet positions went back, i.e. the concat
+     * demuxer moved on to the next entry */
+    atomic_int switches;
+
+    /* owned by the demuxer thread; the stream whose packet positions are
+     * followed and its last position */
+    int pos_stream;
+    int64_t last_pos;
+} ConcatPrefetch;
+
+typedef struct DemuxMsg {
+    AVPacket *pkt[DEMUX_MSG_MAX_PACKETS];
+    int nb_pkt;
+    int looping;
+} DemuxMsg;
+
 typedef struct DemuxStream {
     InputStream ist;
 
@@ -106,6 +223,11 @@ typedef struct DemuxStream {
     int64_t min_pts; /* pts with the smallest value in a current stream */
     int64_t max_pts; /* pts with the higher value in a current stream */
 
+    /* duration of the last frame reported by the decoder when looping, reused
+     * when the loop is replayed from the packet cache */
+    int64_t loop_last_duration;
+    int loop_last_duration_set;
+
     /* number of packets successfully read for this stream */
     uint64_t nb_packets;
     // combined size of all the packets read
@@ -137,21 +259,72 @@ typedef struct Demuxer {
     /* number of streams that the user was warned of */
     int nb_streams_warn;
 
+    /* -stream_loop packet cache, owned by the demuxer thread; holds the
+     * packets of one full pass over the input as returned by the demuxer */
+    int64_t loop_cache_max;
+    enum LoopCacheState loop_cache_state;
+    AVPacket **loop_cache;
+    int nb_loop_cache;
+    unsigned int loop_cache_alloc;
+    int64_t loop_cache_size;
+    int loop_cache_pos;
+
     double readrate_initial_burst;
 
+    int prefetch_depth;
+    int64_t prefetch_size;
+    ConcatPrefetch *prefetch;
+
+    /* hashes the input while it is read, see the digest option */
+    DigestIO *digest;
+
     AVThreadMessageQueue *in_thread_queue;
     int thread_queue_size;
     pthread_t thread;
     int non_blocking;
+    /* maximum number of packets sent to the main thread in one message */
+    int batch_size;
+
+    /* the queue is allocated with thread_queue_max entries, the producer keeps
+     * at most queue_limit messages in it; queue_limit moves between
+     * thread_queue_size and thread_queue_max */
+    int thread_queue_max;
+    atomic_int queue_limit;
+    int queue_limit_peak;
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_cond;
+    atomic_int producer_waiting;
+    atomic_int queue_closed;
+
+    /* stall telemetry, in microseconds; producer_blocked is written by the
+     * demuxer thread, the rest is owned by the main thread */
+    atomic_int_least64_t producer_blocked;
+    atomic_uint nb_producer_blocks;
+    int64_t consumer_starved;
+    int64_t starve_start;
+
+    /* adaptation window state, owned by the main thread */
+    unsigned window_msgs;
+    unsigned window_blocks;
+    int window_starved;
+    int window_peak;
+
+    /* packets sent to the main thread are taken from pkt_pool through
+     * pkt_cache_send by the demuxer thread and returned through pkt_cache_recv
+     * by the main thread */
+    ObjPool *pkt_pool;
+    ObjPoolCache *pkt_cache_send;
+    ObjPoolCache *pkt_cache_recv;
+    ObjPoolStats pkt_pool_stats;
+
+    /* last message received by the main thread, its packets are handed out
+     * one at a time starting at recv_idx */
+    DemuxMsg recv_msg;
+    int recv_idx;
 
     int read_started;
 } Demuxer;
 
-typedef struct DemuxMsg {
-    AVPacket *pkt;
-    int looping;
-} DemuxMsg;
-
 static DemuxStream *ds_from_ist(InputStream *ist) { return (DemuxStream *)ist; }
 
 static Demuxer *demuxer_from_ifile(InputFile *f) { return (Demuxer *)f; }
@@ -193,17 +366,23 @@ static void ifile_duration_update(Demuxer *d, DemuxStream *ds,
     }
 }
 
-static int seek_to_start(Demuxer *d) {
+// account for the duration of the pass that just ended, so that the
+// timestamps of the next pass follow it
+static int loop_duration_update(Demuxer *d) {
     InputFile *ifile = &d->f;
-    AVFormatContext *is = ifile->ctx;
-    int ret;
+    int ret = 0;
 
-    ret = avformat_seek_file(is, -1, INT64_MIN, is->start_time, is->start_time,
-                             0);
-    if (ret < 0)
-        return ret;
+    if (ifile->audio_duration_queue_size &&
+        d->loop_cache_state == LOOP_CACHE_REPLAY) {
+        /* the content of every pass is the same, so are the durations the
+         * decoders reported at the end of the first one */
+        for (int i = 0; i < ifile->nb_streams; i++) {
+            DemuxStream *ds = ds_from_ist(ifile->streams[i]);
 
-    if (ifile->audio_duration_queue_size) {
+            if (ds->loop_last_duration_set)
+                ifile_duration_update(d, ds, ds->loop_last_duration);
+        }
+    } else if (ifile->audio_duration_queue_size) {
         /* duration is the length of the last frame in a stream
          * when audio stream is present we don't care about
          * last video frame length because it's not defined exactly */
@@ -219,6 +398,8 @@ static int seek_to_start(Demuxer *d) {
             got_durations++;
 
             ds = ds_from_ist(ifile->streams[dur.stream_idx]);
+            ds->loop_last_duration = dur.duration;
+            ds->loop_last_duration_set = 1;
             ifile_duration_update(d, ds, dur.duration);
         }
     } else {
@@ -247,6 +428,138 @@ static int seek_to_start(Demuxer *d) {
     return ret;
 }
 
+static void loop_cache_free(Demuxer *d) {
+    for (int i = 0; i < d->nb_loop_cache; i++)
+        av_packet_free(&d->loop_cache[i]);
+    av_freep(&d->loop_cache);
+    d->nb_loop_cache = 0;
+    d->loop_cache_alloc = 0;
+    d->loop_cache_size = 0;
+}
+
+static int loop_cache_add(Demuxer *d, const AVPacket *pkt) {
+    InputFile *f = &d->f;
+    AVPacket *cached;
+    size_t side_data_size = 0;
+    int ret;
+
+    /* packets of discarded or unknown streams are dropped on every pass */
+    if (pkt->stream_index >= f->nb_streams ||
+        f->streams[pkt->stream_index]->discard)
+        return 0;
+
+    for (int i = 0; i < pkt->side_data_elems; i++)
+        side_data_size += pkt->side_data[i].size;
+    d->loop_cache_size += sizeof(*pkt) + pkt->size + side_data_size;
+
+    if (d->loop_cache_size > d->loop_cache_max) {
+        av_log(d, AV_LOG_VERBOSE,
+               "Input exceeds the stream_loop_cache size of %" PRId64
+               " bytes, looping without the cache\n",
+               d->loop_cache_max);
+        d->loop_cache_state = LOOP_CACHE_OFF;
+        loop_cache_free(d);
+        return 0;
+    }
+
+    if (d->nb_loop_cache >= d->loop_cache_alloc) {
+        unsigned int new_alloc = FFMAX(2 * d->loop_cache_alloc, 64);
+        AVPacket **tmp = av_realloc_array(d->loop_cache, new_alloc,
+                                          sizeof(*d->loop_cache));
+        if (!tmp)
+            return AVERROR(ENOMEM);
+        d->loop_cache = tmp;
+        d->loop_cache_alloc = new_alloc;
+    }
+
+    cached = av_packet_alloc();
+    if (!cached)
+        return AVERROR(ENOMEM);
+
+    ret = av_packet_ref(cached, pkt);
+    if (ret < 0) {
+        av_packet_free(&cached);
+        return ret;
+    }
+
+    d->loop_cache[d->nb_loop_cache++] = cached;
+
+    return 0;
+}
+
+// read the next packet of the current pass, either from the input or from
+// the loop cache
+static int demux_read_packet(Demuxer *d, AVPacket *pkt) {
+    int ret;
+
+    if (d->loop_cache_state == LOOP_CACHE_REPLAY) {
+        if (d->loop_cache_pos >= d->nb_loop_cache)
+            return AVERROR_EOF;
+        return av_packet_ref(pkt, d->loop_cache[d->loop_cache_pos++]);
+    }
+
+    ret = av_read_frame(d->f.ctx, pkt);
+    if (ret >= 0 && d->loop_cache_state == LOOP_CACHE_FILL) {
+        ret = loop_cache_add(d, pkt);
+        if (ret < 0)
+            av_packet_unref(pkt);
+    }
+
+    return ret;
+}
+
+// start the next pass of a looped input
+static int loop_restart(Demuxer *d, int read_ret) {
+    InputFile *ifile = &d->f;
+    AVFormatContext *is = ifile->ctx;
+    int ret;
+
+    switch (d->loop_cache_state) {
+    case LOOP_CACHE_REPLAY:
+        d->loop_cache_pos = 0;
+        return loop_duration_update(d);
+    case LOOP_CACHE_FILL:
+        /* only a pass that ended in a clean EOF can be replayed */
+        if (read_ret != AVERROR_EOF || !d->nb_loop_cache) {
+            d->loop_cache_state = LOOP_CACHE_OFF;
+            loop_cache_free(d);
+            break;
+        }
+
+        /* the decoders still report the durations at the end of this pass,
+         * later passes reuse them */
+        ret = loop_duration_update(d);
+        if (ret < 0)
+            return ret;
+
+        av_log(d, AV_LOG_VERBOSE,
+               "Replaying %d cached packets (%" PRId64 " bytes) for the "
+               "following loops\n",
+               d->nb_loop_cache, d->loop_cache_size);
+        d->loop_cache_state = LOOP_CACHE_REPLAY;
+        d->loop_cache_pos = 0;
+
+        /* no one waits for decoder durations from now on, do not let the
+         * decoders block on sending them */
+        if (ifile->audio_duration_queue)
+            av_thread_message_queue_set_err_send(ifile->audio_duration_queue,
+                                                 AVERROR_EOF);
+        return 0;
+    case LOOP_CACHE_WAIT:
+        d->loop_cache_state = LOOP_CACHE_FILL;
+        break;
+    default:
+        break;
+    }
+
+    ret = avformat_seek_file(is, -1, INT64_MIN, is->start_time, is->start_time,
+                             0);
+    if (ret < 0)
+        return ret;
+
+    return loop_duration_update(d);
+}
+
 static void ts_discontinuity_detect(Demuxer *d, InputStream *ist,
                                     AVPacket *pkt) {
     InputFile *ifile = &d->f;
@@ -497,8 +810,8 @@ static int ts_fixup(Demuxer *d, AVPacket *pkt) {
     return 0;
 }
 
-// process an input packet into a message to send to the consumer thread
-// src is always cleared by this function
+// process an input packet and append it to a message to send to the consumer
+// thread; src is always cleared by this function
 static int input_packet_process(Demuxer *d, DemuxMsg *msg, AVPacket *src) {
     InputFile *f = &d->f;
     InputStream *ist = f->streams[src->stream_index];
@@ -506,10 +819,10 @@ static int input_packet_process(Demuxer *d, DemuxMsg *msg, AVPacket *src) {
     AVPacket *pkt;
     int ret = 0;
 
-    pkt = av_packet_alloc();
-    if (!pkt) {
+    ret = objpool_cache_get(d->pkt_cache_send, (void **)&pkt);
+    if (ret < 0) {
         av_packet_unref(src);
-        return AVERROR(ENOMEM);
+        return ret;
     }
     av_packet_move_ref(pkt, src);
 
@@ -536,11 +849,12 @@ static int input_packet_process(Demuxer *d, DemuxMsg *msg, AVPacket *src) {
                              &AV_TIME_BASE_Q));
     }
 
-    msg->pkt = pkt;
+    av_assert0(msg->nb_pkt < FF_ARRAY_ELEMS(msg->pkt));
+    msg->pkt[msg->nb_pkt++] = pkt;
     pkt = NULL;
 
 fail:
-    av_packet_free(&pkt);
+    objpool_cache_release(d->pkt_cache_send, (void **)&pkt);
 
     return ret;
 }
@@ -581,6 +895,509 @@ static void discard_unused_programs(InputFile *ifile) {
     }
 }
 
+static int demux_queue_adaptive(const Demuxer *d) {
+    return d->thread_queue_max > d->thread_queue_size;
+}
+
+// wait until the queue holds fewer messages than the current adaptive limit
+static void demux_queue_wait(Demuxer *d) {
+    AVThreadMessageQueue *q = d->in_thread_queue;
+
+    pthread_mutex_lock(&d->queue_lock);
+    atomic_store(&d->producer_waiting, 1);
+    while (!atomic_load(&d->queue_closed) &&
+           av_thread_message_queue_nb_elems(q) >= atomic_load(&d->queue_limit))
+        pthread_cond_wait(&d->queue_cond, &d->queue_lock);
+    atomic_store(&d->producer_waiting, 0);
+    pthread_mutex_unlock(&d->queue_lock);
+}
+
+// wake the demuxer thread up if it is waiting in demux_queue_wait()
+static void demux_queue_wake(Demuxer *d) {
+    if (!atomic_load(&d->producer_waiting))
+        return;
+
+    pthread_mutex_lock(&d->queue_lock);
+    pthread_cond_signal(&d->queue_cond);
+    pthread_mutex_unlock(&d->queue_lock);
+}
+
+// called by the main thread for every message received; grows the queue when
+// the producer had to wait while the consumer went hungry in the same window,
+// shrinks it after a full window with no waiting and low occupancy
+static void demux_queue_adapt(Demuxer *d) {
+    unsigned nb_blocks = atomic_load(&d->nb_producer_blocks);
+    int limit = atomic_load(&d->queue_limit), new_limit = limit;
+    int queued;
+
+    if (!demux_queue_adaptive(d))
+        return;
+
+    queued = av_thread_message_queue_nb_elems(d->in_thread_queue) + 1;
+    d->window_peak = FFMAX(d->window_peak, queued);
+    d->window_msgs++;
+
+    if (d->window_starved && nb_blocks != d->window_blocks &&
+        limit < d->thread_queue_max)
+        new_limit = FFMIN(2 * limit, d->thread_queue_max);
+    else if (d->window_msgs < DEMUX_QUEUE_WINDOW)
+        return;
+    else if (nb_blocks == d->window_blocks && d->window_peak * 4 <= limit)
+        new_limit = FFMAX(limit / 2, d->thread_queue_size);
+
+    if (new_limit != limit) {
+        av_log(d, AV_LOG_VERBOSE, "Demuxer queue size %d -> %d\n", limit,
+               new_limit);
+        atomic_store(&d->queue_limit, new_limit);
+        d->queue_limit_peak = FFMAX(d->queue_limit_peak, new_limit);
+        demux_queue_wake(d);
+    }
+
+    d->window_msgs = 0;
+    d->window_blocks = nb_blocks;
+    d->window_starved = 0;
+    d->window_peak = 0;
+}
+
+static void demux_msg_free(DemuxMsg *msg, ObjPoolCache *pc) {
+    for (int i = 0; i < msg->nb_pkt; i++)
+        objpool_cache_release(pc, (void **)&msg->pkt[i]);
+    msg->nb_pkt = 0;
+}
+
+// send the packets batched in msg to the consumer thread; msg is always
+// emptied by this function
+static int demux_msg_send(Demuxer *d, DemuxMsg *msg, unsigned *flags) {
+    InputFile *f = &d->f;
+    int64_t wait_start = 0;
+    int ret;
+
+    if (!msg->nb_pkt)
+        return 0;
+
+    /* account for the time spent waiting for the consumer to make room */
+    if (av_thread_message_queue_nb_elems(d->in_thread_queue) >=
+        atomic_load(&d->queue_limit)) {
+        wait_start = av_gettime_relative();
+        if (demux_queue_adaptive(d))
+            demux_queue_wait(d);
+    }
+
+    ret = av_thread_message_queue_send(d->in_thread_queue, msg, *flags);
+    if (*flags && ret == AVERROR(EAGAIN)) {
+        *flags = 0;
+        ret = av_thread_message_queue_send(d->in_thread_queue, msg, *flags);
+        av_log(f, AV_LOG_WARNING,
+               "Thread message queue blocking; consider raising the "
+               "thread_queue_size option (current value: %d)\n",
+               d->thread_queue_size);
+    }
+
+    if (wait_start) {
+        atomic_fetch_add(&d->producer_blocked,
+                         av_gettime_relative() - wait_start);
+        atomic_fetch_add(&d->nb_producer_blocks, 1);
+    }
+    if (ret < 0) {
+        if (ret != AVERROR_EOF)
+            av_log(f, AV_LOG_ERROR, "Unable to send packet to main thread: %s\n",
+                   av_err2str(ret));
+        demux_msg_free(msg, d->pkt_cache_send);
+        return ret;
+    }
+
+    /* packet ownership moved to the consumer */
+    msg->nb_pkt = 0;
+
+    return 0;
+}
+
+// decide whether a partially filled batch has to be sent right away
+static int demux_msg_flush_needed(Demuxer *d, const DemuxMsg *msg,
+                                  int64_t batch_start) {
+    if (msg->nb_pkt >= d->batch_size)
+        return 1;
+
+    /* never let the consumer starve while packets are waiting here */
+    if (!av_thread_message_queue_nb_elems(d->in_thread_queue))
+        return 1;
+
+    return av_gettime_relative() - batch_start >= DEMUX_MSG_MAX_DELAY;
+}
+
+static int prefetch_interrupt(void *opaque) {
+    ConcatPrefetch *p = opaque;
+    return atomic_load(&p->stop);
+}
+
+/* resolve a list entry relative to the list, like the concat demuxer does */
+static char *prefetch_entry_url(const char *list_url, const char *path) {
+    const char *sep = strrchr(list_url, '/');
+    size_t proto_len = strcspn(path, ":/");
+
+    if (path[0] == '/' || path[proto_len] == ':' || !sep)
+        return av_strdup(path);
+
+    return av_asprintf("%.*s%s", (int)(sep - list_url + 1), list_url, path);
+}
+
+/* same rule as the concat demuxer in safe mode: relative paths made of
+ * [A-Za-z0-9_-] components which do not start with a dot */
+static int prefetch_safe_filename(const char *f) {
+    const char *start = f;
+
+    for (; *f; f++) {
+        if (!((unsigned)((*f | 32) - 'a') < 26 || (unsigned)(*f - '0') < 10 ||
+              *f == '_' || *f == '-')) {
+            if (f == start)
+                return 0;
+            else if (*f == '/')
+                start = f + 1;
+            else if (*f != '.')
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int prefetch_entry_add(ConcatPrefetch *p, const char *path) {
+    PrefetchEntry *entries, *e;
+
+    if (p->safe && !prefetch_safe_filename(path)) {
+        av_log(p->logctx, AV_LOG_WARNING,
+               "Unsafe file name '%s' in the concat list, not prefetching\n",
+               path);
+        return AVERROR(EPERM);
+    }
+
+    entries = av_realloc_array(p->entries, p->nb_entries + 1, sizeof(*e));
+    if (!entries)
+        return AVERROR(ENOMEM);
+    p->entries = entries;
+
+    e = &p->entries[p->nb_entries];
+    e->url = prefetch_entry_url(p->list_url, path);
+    if (!e->url)
+        return AVERROR(ENOMEM);
+    e->user_duration = AV_NOPTS_VALUE;
+    e->inpoint = AV_NOPTS_VALUE;
+    e->outpoint = AV_NOPTS_VALUE;
+    e->duration = AV_NOPTS_VALUE;
+    p->nb_entries++;
+
+    return 0;
+}
+
+/* playing time of an entry computed like the concat demuxer does, known only
+ * when the list gives it with the duration or outpoint directives */
+static void prefetch_entry_duration(PrefetchEntry *e) {
+    if (e->user_duration != AV_NOPTS_VALUE) {
+        e->duration = e->user_duration;
+    } else if (e->outpoint != AV_NOPTS_VALUE) {
+        e->duration = e->outpoint -
+                      (e->inpoint != AV_NOPTS_VALUE ? e->inpoint : 0);
+    }
+}
+
+/* read the file entries of the list along with the directives that change
+ * their playing time, everything else is left to the concat demuxer */
+static int prefetch_list_read(ConcatPrefetch *p) {
+    const AVIOInterruptCB int_cb = {prefetch_interrupt, p};
+    AVIOContext *pb = NULL;
+    AVDictionary *opts = NULL;
+    AVBPrint bp;
+    char *line, *save = NULL;
+    int ret;
+
+    ret = av_dict_copy(&opts, p->opts, 0);
+    if (ret >= 0)
+        ret = avio_open2(&pb, p->list_url, AVIO_FLAG_READ, &int_cb, &opts);
+    av_dict_free(&opts);
+    if (ret < 0)
+        return ret;
+
+    av_bprint_init(&bp, 0, AV_BPRINT_SIZE_UNLIMITED);
+    ret = avio_read_to_bprint(pb, &bp, SIZE_MAX);
+    avio_closep(&pb);
+    if (ret >= 0 && !av_bprint_is_complete(&bp))
+        ret = AVERROR(ENOMEM);
+
+    for (line = av_strtok(bp.str, "\r\n", &save); ret >= 0 && line;
+         line = av_strtok(NULL, "\r\n", &save)) {
+        const char *cursor = line;
+        char *keyword = av_get_token(&cursor, " \t");
+        char *arg = av_get_token(&cursor, " \t");
+        PrefetchEntry *last =
+            p->nb_entries ? &p->entries[p->nb_entries - 1] : NULL;
+
+        if (!keyword || !arg) {
+            ret = AVERROR(ENOMEM);
+        } else if (!strcmp(keyword, "file") && *arg) {
+            ret = prefetch_entry_add(p, arg);
+        } else if (last && !strcmp(keyword, "duration")) {
+            av_parse_time(&last->user_duration, arg, 1);
+        } else if (last && !strcmp(keyword, "inpoint")) {
+            av_parse_time(&last->inpoint, arg, 1);
+        } else if (last && !strcmp(keyword, "outpoint")) {
+            av_parse_time(&last->outpoint, arg, 1);
+        }
+
+        av_free(keyword);
+        av_free(arg);
+    }
+
+    for (int i = 0; i < p->nb_entries; i++)
+        prefetch_entry_duration(&p->entries[i]);
+
+    av_bprint_finalize(&bp, NULL);
+    return ret;
+}
+
+/* ask the kernel to read the first size bytes of a local file in the
+ * background, without waiting for them */
+static int prefetch_readahead(const char *url, int64_t size) {
+#if HAVE_UNISTD_H && (defined(POSIX_FADV_WILLNEED) || defined(F_RDADVISE))
+    int fd, ret = 0;
+
+    av_strstart(url, "file:", &url);
+    fd = open(url, O_RDONLY);
+    if (fd < 0)
+        return AVERROR(errno);
+#if defined(POSIX_FADV_WILLNEED)
+    ret = AVERROR(posix_fadvise(fd, 0, size, POSIX_FADV_WILLNEED));
+#else
+    struct radvisory advice = {.ra_offset = 0,
+                               .ra_count = (int)FFMIN(size, INT_MAX)};
+    if (fcntl(fd, F_RDADVISE, &advice) < 0)
+        ret = AVERROR(errno);
+#endif
+    close(fd);
+    return ret;
+#else
+    return AVERROR(ENOSYS);
+#endif
+}
+
+static void prefetch_entry(ConcatPrefetch *p, PrefetchEntry *e) {
+    const char *proto = avio_find_protocol_name(e->url);
+    int ret;
+
+    if (!proto || strcmp(proto, "file")) {
+        av_log(p->logctx, AV_LOG_VERBOSE,
+               "Concat entry %s is not a local file, not prefetched\n",
+               e->url);
+        return;
+    }
+
+    ret = prefetch_readahead(e->url, p->entry_size);
+    if (ret < 0) {
+        av_log(p->logctx, AV_LOG_VERBOSE,
+               "Could not prefetch concat entry %s: %s\n", e->url,
+               av_err2str(ret));
+        return;
+    }
+
+    p->nb_prefetched++;
+    av_log(p->logctx, AV_LOG_DEBUG,
+           "Prefetched concat entry %s: %" PRId64 " bytes\n", e->url,
+           p->entry_size);
+}
+
+/* called by the demuxer thread for every packet returned; the concat
+ * demuxer passes on the byte positions of the entry being read, which go
+ * back when it opens the next entry */
+static void prefetch_track(ConcatPrefetch *p, const AVStream *st,
+                           const AVPacket *pkt) {
+    if (pkt->dts != AV_NOPTS_VALUE)
+        atomic_store(&p->ts,
+                     av_rescale_q(pkt->dts, st->time_base, AV_TIME_BASE_Q));
+
+    if (pkt->pos < 0)
+        return;
+    if (p->pos_stream < 0)
+        p->pos_stream = pkt->stream_index;
+    if (pkt->stream_index != p->pos_stream)
+        return;
+    if (pkt->pos < p->last_pos)
+        atomic_fetch_add(&p->switches, 1);
+    p->last_pos = pkt->pos;
+}
+
+/* index of the entry being demuxed, judged from the demuxer timestamps and
+ * the playing times of the first nb_known entries, or from the number of
+ * entry switches when the list does not give the playing times */
+static int prefetch_current(ConcatPrefetch *p, int nb_known) {
+    int64_t ts = atomic_load(&p->ts);
+    int64_t end = 0;
+    int current = nb_known;
+
+    for (int i = 0; i < nb_known; i++) {
+        if (p->entries[i].duration == AV_NOPTS_VALUE) {
+            current = i;
+            break;
+        }
+        end += p->entries[i].duration;
+        if (end > ts) {
+            current = i;
+            break;
+        }
+    }
+
+    return FFMAX(current, atomic_load(&p->switches));
+}
+
+static void *prefetch_thread(void *arg) {
+    FFmpegContext *context = (FFmpegContext *)arg;
+    loadFFmpegContext(context);
+    ConcatPrefetch *p = (ConcatPrefetch *)context->arg;
+    av_free(arg);
+
+    /* the first entry is already open in the concat demuxer */
+    int next = 1;
+    int ret;
+
+    ff_thread_setname("concat_prefetch");
+
+    ret = prefetch_list_read(p);
+    if (ret < 0) {
+        if (!atomic_load(&p->stop))
+            av_log(p->logctx, AV_LOG_WARNING,
+                   "Could not read the concat list for prefetching: %s\n",
+                   av_err2str(ret));
+        return NULL;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    while (!atomic_load(&p->stop) && next < p->nb_entries) {
+        if (next > prefetch_current(p, next) + p->depth) {
+            int64_t wake = av_gettime() + CONCAT_PREFETCH_POLL;
+            struct timespec abstime = {wake / 1000000,
+                                       (wake % 1000000) * 1000};
+
+            pthread_cond_timedwait(&p->cond, &p->lock, &abstime);
+            continue;
+        }
+
+        pthread_mutex_unlock(&p->lock);
+        prefetch_entry(p, &p->entries[next++]);
+        pthread_mutex_lock(&p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+
+    return NULL;
+}
+
+static void prefetch_stop(Demuxer *d) {
+    ConcatPrefetch *p = d->prefetch;
+
+    if (!p)
+        return;
+
+    pthread_mutex_lock(&p->lock);
+    atomic_store(&p->stop, 1);
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+
+    pthread_join(p->thread, NULL);
+
+    av_log(d, AV_LOG_VERBOSE, "Prefetched %d of %d concat entries\n",
+           p->nb_prefetched, FFMAX(p->nb_entries - 1, 0));
+
+    for (int i = 0; i < p->nb_entries; i++)
+        av_freep(&p->entries[i].url);
+    av_freep(&p->entries);
+    av_freep(&p->list_url);
+    av_dict_free(&p->opts);
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+    av_freep(&d->prefetch);
+}
+
+/* failing to start prefetching is not fatal, the concat demuxer still opens
+ * every entry by itself */
+static void prefetch_start(Demuxer *d) {
+    static const char *const inherited_opts[] = {"protocol_whitelist",
+                                                 "protocol_blacklist"};
+    InputFile *f = &d->f;
+    const char *proto;
+    ConcatPrefetch *p;
+    int64_t safe = 1;
+    int ret;
+
+    if (d->prefetch_depth <= 0)
+        return;
+
+    /* entries of a remote list are remote too, and would be fetched twice */
+    proto = avio_find_protocol_name(f->ctx->url);
+    if (!proto || strcmp(proto, "file")) {
+        av_log(d, AV_LOG_WARNING,
+               "Option -concat_prefetch ignored for a concat list which is "
+               "not a local file\n");
+        return;
+    }
+
+    p = av_mallocz(sizeof(*p));
+    if (!p)
+        return;
+
+    p->logctx = d;
+    p->depth = d->prefetch_depth;
+    p->entry_size = (d->prefetch_size > 0 ? d->prefetch_size
+                                          : CONCAT_PREFETCH_SIZE_DEFAULT) /
+                    p->depth;
+    p->pos_stream = -1;
+    p->last_pos = -1;
+    atomic_init(&p->stop, 0);
+    atomic_init(&p->ts, 0);
+    atomic_init(&p->switches, 0);
+
+    av_opt_get_int(f->ctx, "safe", AV_OPT_SEARCH_CHILDREN, &safe);
+    p->safe = safe > 0;
+
+    p->list_url = av_strdup(f->ctx->url);
+    if (!p->list_url)
+        goto fail;
+    for (int i = 0; i < FF_ARRAY_ELEMS(inherited_opts); i++) {
+        uint8_t *value = NULL;
+
+        if (av_opt_get(f->ctx, inherited_opts[i], 0, &value) < 0)
+            goto fail;
+        if (value && *value) {
+            if (av_dict_set(&p->opts, inherited_opts[i], (char *)value,
+                            AV_DICT_DONT_STRDUP_VAL) < 0)
+                goto fail;
+        } else
+            av_free(value);
+    }
+    if (pthread_mutex_init(&p->lock, NULL))
+        goto fail;
+    if (pthread_cond_init(&p->cond, NULL)) {
+        pthread_mutex_destroy(&p->lock);
+        goto fail;
+    }
+
+    FFmpegContext *context = saveFFmpegContext();
+    context->arg = p;
+
+    if ((ret = pthread_create(&p->thread, NULL, prefetch_thread, context))) {
+        av_log(d, AV_LOG_WARNING,
+               "Could not start the concat prefetch thread: %s\n",
+               strerror(ret));
+        av_free(context);
+        pthread_cond_destroy(&p->cond);
+        pthread_mutex_destroy(&p->lock);
+        goto fail;
+    }
+
+    d->prefetch = p;
+    return;
+fail:
+    av_dict_free(&p->opts);
+    av_free(p->list_url);
+    av_free(p);
+}
+
 static void thread_set_name(InputFile *f) {
     char name[16];
     snprintf(name, sizeof(name), "dmx%d:%s", f->index, f->ctx->iformat->name);
@@ -595,11 +1412,14 @@ static void *input_thread(void *arg) {
 
     InputFile *f = &d->f;
     AVPacket *pkt;
+    DemuxMsg msg = {{NULL}};
+    int64_t batch_start = 0;
     unsigned flags = d->non_blocking ? AV_THREAD_MESSAGE_NONBLOCK : 0;
     int ret = 0;
 
     pkt = av_packet_alloc();
-    if (!pkt) {
+    d->pkt_cache_send = objpool_cache_alloc(d->pkt_pool);
+    if (!pkt || !d->pkt_cache_send) {
         ret = AVERROR(ENOMEM);
         goto finish;
     }
@@ -610,22 +1430,44 @@ static void *input_thread(void *arg) {
 
     d->wallclock_start = av_gettime_relative();
 
-    while (1) {
-        DemuxMsg msg = {NULL};
+    /* the first pass can only be cached when it starts at the beginning of
+     * the input, like the following ones */
+    if (d->loop && d->loop_cache_max > 0)
+        d->loop_cache_state =
+            f->start_time == AV_NOPTS_VALUE ? LOOP_CACHE_FILL : LOOP_CACHE_WAIT;
 
-        ret = av_read_frame(f->ctx, pkt);
+    while (1) {
+        ret = demux_read_packet(d, pkt);
 
         if (ret == AVERROR(EAGAIN)) {
+            /* do not hold packets back while waiting for more input */
+            ret = demux_msg_send(d, &msg, &flags);
+            if (ret < 0)
+                break;
+
             av_usleep(10000);
             continue;
         }
         if (ret < 0) {
+            int err;
+
+            /* deliver the packets read so far before looping or finishing */
+            err = demux_msg_send(d, &msg, &flags);
+            if (err < 0) {
+                ret = err;
+                break;
+            }
+
             if (d->loop) {
+                DemuxMsg loop_msg = {{NULL}};
+                int read_ret = ret;
+
                 /* signal looping to the consumer thread */
-                msg.looping = 1;
-                ret = av_thread_message_queue_send(d->in_thread_queue, &msg, 0);
+                loop_msg.looping = 1;
+                ret = av_thread_message_queue_send(d->in_thread_queue,
+                                                   &loop_msg, 0);
                 if (ret >= 0)
-                    ret = seek_to_start(d);
+                    ret = loop_restart(d, read_ret);
                 if (ret >= 0)
                     continue;
 
@@ -655,6 +1497,10 @@ static void *input_thread(void *arg) {
             continue;
         }
 
+        if (d->prefetch)
+            prefetch_track(d->prefetch, f->ctx->streams[pkt->stream_index],
+                           pkt);
+
         if (pkt->flags & AV_PKT_FLAG_CORRUPT) {
             av_log(d, exit_on_error ? AV_LOG_FATAL : AV_LOG_WARNING,
                    "corrupt input packet in stream %d\n", pkt->stream_index);
@@ -672,22 +1518,13 @@ static void *input_thread(void *arg) {
         if (f->readrate)
             readrate_sleep(d);
 
-        ret = av_thread_message_queue_send(d->in_thread_queue, &msg, flags);
-        if (flags && ret == AVERROR(EAGAIN)) {
-            flags = 0;
-            ret = av_thread_message_queue_send(d->in_thread_queue, &msg, flags);
-            av_log(f, AV_LOG_WARNING,
-                   "Thread message queue blocking; consider raising the "
-                   "thread_queue_size option (current value: %d)\n",
-                   d->thread_queue_size);
-        }
-        if (ret < 0) {
-            if (ret != AVERROR_EOF)
-                av_log(f, AV_LOG_ERROR,
-                       "Unable to send packet to main thread: %s\n",
-                       av_err2str(ret));
-            av_packet_free(&msg.pkt);
-            break;
+        if (msg.nb_pkt == 1 && d->batch_size > 1)
+            batch_start = av_gettime_relative();
+
+        if (demux_msg_flush_needed(d, &msg, batch_start)) {
+            ret = demux_msg_send(d, &msg, &flags);
+            if (ret < 0)
+                break;
         }
     }
 
@@ -695,7 +1532,10 @@ finish:
     av_assert0(ret < 0);
     av_thread_message_queue_set_err_recv(d->in_thread_queue, ret);
 
+    demux_msg_free(&msg, d->pkt_cache_send);
+    objpool_cache_free(&d->pkt_cache_send);
     av_packet_free(&pkt);
+    loop_cache_free(d);
 
     av_log(d, AV_LOG_VERBOSE, "Terminating demuxer thread\n");
 
@@ -706,13 +1546,30 @@ static void thread_stop(Demuxer *d) {
     InputFile *f = &d->f;
     DemuxMsg msg;
 
+    prefetch_stop(d);
+
     if (!d->in_thread_queue)
         return;
     av_thread_message_queue_set_err_send(d->in_thread_queue, AVERROR_EOF);
+
+    pthread_mutex_lock(&d->queue_lock);
+    atomic_store(&d->queue_closed, 1);
+    pthread_cond_signal(&d->queue_cond);
+    pthread_mutex_unlock(&d->queue_lock);
+
     while (av_thread_message_queue_recv(d->in_thread_queue, &msg, 0) >= 0)
-        av_packet_free(&msg.pkt);
+        demux_msg_free(&msg, d->pkt_cache_recv);
+    demux_msg_free(&d->recv_msg, d->pkt_cache_recv);
+    d->recv_idx = 0;
 
     pthread_join(d->thread, NULL);
+
+    objpool_cache_free(&d->pkt_cache_recv);
+    objpool_stats(d->pkt_pool, &d->pkt_pool_stats);
+    objpool_free(&d->pkt_pool);
+
+    pthread_cond_destroy(&d->queue_cond);
+    pthread_mutex_destroy(&d->queue_lock);
     av_thread_message_queue_free(&d->in_thread_queue);
     av_thread_message_queue_free(&f->audio_duration_queue);
 }
@@ -721,18 +1578,53 @@ static int thread_start(Demuxer *d) {
     int ret;
     InputFile *f = &d->f;
 
-    if (d->thread_queue_size <= 0)
+    /* an explicit thread_queue_size without an upper bound keeps the queue
+     * size fixed, otherwise it adapts between the two */
+    if (d->thread_queue_size <= 0) {
         d->thread_queue_size = (nb_input_files > 1 ? 8 : 1);
+        if (d->thread_queue_max <= 0)
+            d->thread_queue_max = DEMUX_QUEUE_MAX_DEFAULT;
+    }
+    d->thread_queue_max = FFMAX(d->thread_queue_max, d->thread_queue_size);
+    atomic_init(&d->queue_limit, d->thread_queue_size);
+    d->queue_limit_peak = d->thread_queue_size;
 
     if (nb_input_files > 1 &&
         (f->ctx->pb ? !f->ctx->pb->seekable
                     : strcmp(f->ctx->iformat->name, "lavfi")))
         d->non_blocking = 1;
+
+    /* batching only pays off for inputs that are read as fast as possible;
+     * live sources and -readrate get every packet delivered immediately */
+    d->batch_size = (!f->readrate && f->ctx->pb && f->ctx->pb->seekable)
+                        ? DEMUX_MSG_MAX_PACKETS
+                        : 1;
+
     ret = av_thread_message_queue_alloc(&d->in_thread_queue,
-                                        d->thread_queue_size, sizeof(DemuxMsg));
+                                        d->thread_queue_max, sizeof(DemuxMsg));
     if (ret < 0)
         return ret;
 
+    ret = pthread_mutex_init(&d->queue_lock, NULL);
+    if (ret) {
+        av_thread_message_queue_free(&d->in_thread_queue);
+        return AVERROR(ret);
+    }
+    ret = pthread_cond_init(&d->queue_cond, NULL);
+    if (ret) {
+        pthread_mutex_destroy(&d->queue_lock);
+        av_thread_message_queue_free(&d->in_thread_queue);
+        return AVERROR(ret);
+    }
+
+    d->pkt_pool = objpool_alloc_packets();
+    if (d->pkt_pool)
+        d->pkt_cache_recv = objpool_cache_alloc(d->pkt_pool);
+    if (!d->pkt_cache_recv) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+
     if (d->loop) {
         int nb_audio_dec = 0;
 
@@ -768,15 +1660,20 @@ static int thread_start(Demuxer *d) {
 
     d->read_started = 1;
 
+    prefetch_start(d);
+
     return 0;
 fail:
+    objpool_cache_free(&d->pkt_cache_recv);
+    objpool_free(&d->pkt_pool);
+    pthread_cond_destroy(&d->queue_cond);
+    pthread_mutex_destroy(&d->queue_lock);
     av_thread_message_queue_free(&d->in_thread_queue);
     return ret;
 }
 
 int ifile_get_packet(InputFile *f, AVPacket **pkt) {
     Demuxer *d = demuxer_from_ifile(f);
-    DemuxMsg msg;
     int ret;
 
     if (!d->in_thread_queue) {
@@ -785,21 +1682,58 @@ int ifile_get_packet(InputFile *f, AVPacket **pkt) {
             return ret;
     }
 
-    ret = av_thread_message_queue_recv(
-        d->in_thread_queue, &msg,
-        d->non_blocking ? AV_THREAD_MESSAGE_NONBLOCK : 0);
-    if (ret < 0)
-        return ret;
-    if (msg.looping)
-        return 1;
+    if (d->recv_idx >= d->recv_msg.nb_pkt) {
+        DemuxMsg msg;
+        int64_t now, wait_start = 0;
+
+        /* the queue is empty, so the consumer is about to starve */
+        if (!d->starve_start &&
+            !av_thread_message_queue_nb_elems(d->in_thread_queue))
+            wait_start = av_gettime_relative();
+
+        ret = av_thread_message_queue_recv(
+            d->in_thread_queue, &msg,
+            d->non_blocking ? AV_THREAD_MESSAGE_NONBLOCK : 0);
+        if (ret == AVERROR(EAGAIN) && wait_start)
+            d->starve_start = wait_start;
+        if (ret < 0)
+            return ret;
+
+        if (d->starve_start)
+            wait_start = d->starve_start;
+        if (wait_start) {
+            now = av_gettime_relative();
+            d->consumer_starved += now - wait_start;
+            d->starve_start = 0;
+            d->window_starved = 1;
+        }
 
-    *pkt = msg.pkt;
+        demux_queue_wake(d);
+        demux_queue_adapt(d);
+
+        if (msg.looping)
+            return 1;
+
+        d->recv_msg = msg;
+        d->recv_idx = 0;
+    }
+
+    *pkt = d->recv_msg.pkt[d->recv_idx];
+    d->recv_msg.pkt[d->recv_idx++] = NULL;
     return 0;
 }
 
+void ifile_packet_release(InputFile *f, AVPacket **pkt) {
+    Demuxer *d = demuxer_from_ifile(f);
+
+    objpool_cache_release(d->pkt_cache_recv, (void **)pkt);
+}
+
 static void demux_final_stats(Demuxer *d) {
     InputFile *f = &d->f;
     uint64_t total_packets = 0, total_size = 0;
+    /* formats without a file, like devices, have no AVIOContext */
+    uint64_t bytes_read = f->ctx->pb ? f->ctx->pb->bytes_read : 0;
 
     av_log(f, AV_LOG_VERBOSE, "Input file #%d (%s):\n", f->index, f->ctx->url);
 
@@ -834,8 +1768,37 @@ static void demux_final_stats(Demuxer *d) {
     }
 
     av_log(f, AV_LOG_VERBOSE,
-           "  Total: %" PRIu64 " packets (%" PRIu64 " bytes) demuxed\n",
-           total_packets, total_size);
+           "  Total: %" PRIu64 " packets (%" PRIu64 " bytes) demuxed; %" PRIu64
+           " bytes read\n",
+           total_packets, total_size, bytes_read);
+
+    if (digest_io_md5(d->digest))
+        av_log(f, AV_LOG_INFO, "  MD5: %s\n", digest_io_md5(d->digest));
+    if (digest_io_sha256(d->digest))
+        av_log(f, AV_LOG_INFO, "  SHA-256: %s\n",
+               digest_io_sha256(d->digest));
+
+    av_log(f, AV_LOG_VERBOSE,
+           "  Queue: size %d-%d (peak %d); demuxer blocked %.3fs, "
+           "consumer starved %.3fs\n",
+           d->thread_queue_size, d->thread_queue_max, d->queue_limit_peak,
+           atomic_load(&d->producer_blocked) / 1000000.0,
+           d->consumer_starved / 1000000.0);
+    av_log(f, AV_LOG_VERBOSE,
+           "  Packet pool: %" PRIu64 " reused, %" PRIu64 " allocated, %" PRIu64
+           " freed early\n",
+           d->pkt_pool_stats.hits, d->pkt_pool_stats.misses,
+           d->pkt_pool_stats.frees);
+
+    if (input_stats_callback != NULL)
+        input_stats_callback(f->index, f->ctx->url, total_packets, total_size,
+                             atomic_load(&d->producer_blocked) / 1000.0,
+                             d->consumer_starved / 1000.0,
+                             d->thread_queue_size, d->thread_queue_max,
+                             d->queue_limit_peak, d->pkt_pool_stats.hits,
+                             d->pkt_pool_stats.misses, bytes_read,
+                             digest_io_md5(d->digest),
+                             digest_io_sha256(d->digest));
 }
 
 static void ist_free(InputStream **pist) {
@@ -866,6 +1829,9 @@ void ifile_close(InputFile **pf) {
 
     thread_stop(d);
 
+    if (d->read_started && d->digest)
+        digest_io_finish(d->digest);
+
     if (d->read_started)
         demux_final_stats(d);
 
@@ -873,7 +1839,10 @@ void ifile_close(InputFile **pf) {
         ist_free(&f->streams[i]);
     av_freep(&f->streams);
 
+    /* a wrapped AVIOContext is custom IO, which is not closed with the
+     * AVFormatContext */
     avformat_close_input(&f->ctx);
+    digest_io_closep(&d->digest, NULL);
 
     av_freep(pf);
 }
@@ -1561,9 +2530,52 @@ int ifile_open(const OptionsContext *o, const char *filename) {
                     AV_DICT_DONT_OVERWRITE);
         scan_all_pmts_set = 1;
     }
+
+    err = add_file_cache_options(&o->g->format_opts, filename, 0);
+    if (err < 0) {
+        avformat_free_context(ic);
+        return err;
+    }
+
+    /* the digest needs the file opened here, so that it is read through
+     * DigestIO */
+    if (o->digest) {
+        int types;
+
+        err = digest_io_parse(d, o->digest, &types);
+        if (err >= 0 && file_iformat && file_iformat->flags & AVFMT_NOFILE) {
+            av_log(d, AV_LOG_WARNING,
+                   "Option -digest ignored for a %s input\n",
+                   file_iformat->name);
+        } else if (err >= 0) {
+            /* the digest reads missing ranges back with the same options */
+            AVDictionary *protocol_opts = NULL;
+
+            err = av_dict_copy(&protocol_opts, o->g->format_opts, 0);
+            if (err >= 0)
+                err = avio_open2(&ic->pb, filename, AVIO_FLAG_READ,
+                                 &ic->interrupt_callback, &o->g->format_opts);
+            if (err >= 0) {
+                err = digest_io_wrap(&d->digest, &ic->pb, filename,
+                                     &ic->interrupt_callback, protocol_opts,
+                                     types);
+                if (err < 0)
+                    avio_closep(&ic->pb);
+            }
+            av_dict_free(&protocol_opts);
+        }
+        if (err < 0) {
+            av_log(d, AV_LOG_ERROR, "Error opening input: %s\n",
+                   av_err2str(err));
+            avformat_free_context(ic);
+            return err;
+        }
+    }
+
     /* open the input file with generic avformat function */
     err = avformat_open_input(&ic, filename, file_iformat, &o->g->format_opts);
     if (err < 0) {
+        digest_io_closep(&d->digest, NULL);
         av_log(d, AV_LOG_ERROR, "Error opening input: %s\n", av_err2str(err));
         if (err == AVERROR_PROTOCOL_NOT_FOUND)
             av_log(d, AV_LOG_ERROR, "Did you mean file:%s?\n", filename);
@@ -1660,8 +2672,14 @@ int ifile_open(const OptionsContext *o, const char *filename) {
                 seek_timestamp -= 3 * AV_TIME_BASE / 23;
             }
         }
-        ret = avformat_seek_file(ic, -1, INT64_MIN, seek_timestamp,
-                                 seek_timestamp, 0);
+        /* an exact byte offset from the sidecar index avoids searching for
+         * the keyframe in inputs with a poor or no index */
+        ret = AVERROR(ENOSYS);
+        if (o->seek_index)
+            ret = seek_index_seek(d, ic, filename, seek_timestamp);
+        if (ret < 0)
+            ret = avformat_seek_file(ic, -1, INT64_MIN, seek_timestamp,
+                                     seek_timestamp, 0);
         if (ret < 0) {
             av_log(d, AV_LOG_WARNING, "could not seek to position %0.3f\n",
                    (double)timestamp / AV_TIME_BASE);
@@ -1679,6 +2697,7 @@ int ifile_open(const OptionsContext *o, const char *filename) {
                             : timestamp);
     f->accurate_seek = o->accurate_seek;
     d->loop = o->loop;
+    d->loop_cache_max = o->loop_cache_size;
     d->duration = 0;
     d->time_base = (AVRational){1, 1};
     d->nb_streams_warn = ic->nb_streams;
@@ -1718,6 +2737,17 @@ int ifile_open(const OptionsContext *o, const char *filename) {
     }
 
     d->thread_queue_size = o->thread_queue_size;
+    d->thread_queue_max = o->thread_queue_size_max;
+
+    if (o->concat_prefetch > 0) {
+        if (!strcmp(ic->iformat->name, "concat")) {
+            d->prefetch_depth = o->concat_prefetch;
+            d->prefetch_size = o->concat_prefetch_size;
+        } else
+            av_log(d, AV_LOG_WARNING,
+                   "Option -concat_prefetch ignored for a %s input\n",
+                   ic->iformat->name);
+    }
 
     /* Add all the streams from the given input file to the demuxer */
     for (int i = 0; i < ic->nb_streams; i++) {
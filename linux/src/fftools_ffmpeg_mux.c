@@ -26,6 +26,18 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - muxer thread receives packets in batches using tq_receive_many()
+ * - muxing queue flush submits packets in batches using tq_send_many()
+ * - output scheduling heap updated when last_mux_dts changes
+ * - bytes written to the output AVIOContext logged and forwarded through
+ * output_stats_callback
+ * - output digests computed by DigestIO logged and forwarded through
+ * output_stats_callback
+ * - output size tracked from the highest position written instead of calling
+ * avio_size() for every packet
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -71,23 +83,25 @@
 
 #include "ffmpeg_context.h"
 
+extern void (*output_stats_callback)(int, const char *, uint64_t, uint64_t,
+                                     uint64_t, const char *, const char *);
+
 __thread int want_sdp = 1;
 
 MuxStream *ms_from_ost(OutputStream *ost) { return (MuxStream *)ost; }
 
 static Muxer *mux_from_of(OutputFile *of) { return (Muxer *)of; }
 
-static int64_t filesize(AVIOContext *pb) {
-    int64_t ret = -1;
+/* The output size is the highest position the muxer has reached. Unlike
+ * avio_size() this needs no seeks, works for non seekable outputs and counts
+ * buffered data. */
+static int64_t filesize(Muxer *mux, AVIOContext *pb) {
+    if (!pb)
+        return -1;
 
-    if (pb) {
-        ret = avio_size(pb);
-        if (ret <= 0) // FIXME improve avio_size() so it works with non seekable
-                      // output too
-            ret = avio_tell(pb);
-    }
+    mux->pos_max = FFMAX(mux->pos_max, avio_tell(pb));
 
-    return ret;
+    return mux->pos_max;
 }
 
 static int write_packet(Muxer *mux, OutputStream *ost, AVPacket *pkt) {
@@ -97,7 +111,7 @@ static int write_packet(Muxer *mux, OutputStream *ost, AVPacket *pkt) {
     uint64_t frame_num;
     int ret;
 
-    fs = filesize(s->pb);
+    fs = filesize(mux, s->pb);
     atomic_store(&mux->last_filesize, fs);
     if (fs >= mux->limit_filesize) {
         ret = AVERROR_EOF;
@@ -250,6 +264,9 @@ static void thread_set_name(OutputFile *of) {
     ff_thread_setname(name);
 }
 
+/* maximum number of packets moved across the muxer thread queue per lock */
+#define MUX_THREAD_BATCH 16
+
 static void *muxer_thread(void *arg) {
     FFmpegContext *context = (FFmpegContext *)arg;
     loadFFmpegContext(context);
@@ -257,47 +274,59 @@ static void *muxer_thread(void *arg) {
     av_free(arg);
 
     OutputFile *of = &mux->of;
-    AVPacket *pkt = NULL;
+    AVPacket *pkts[MUX_THREAD_BATCH] = {NULL};
+    int stream_idx[MUX_THREAD_BATCH];
     int ret = 0;
 
-    pkt = av_packet_alloc();
-    if (!pkt) {
-        ret = AVERROR(ENOMEM);
-        goto finish;
+    for (int i = 0; i < FF_ARRAY_ELEMS(pkts); i++) {
+        pkts[i] = av_packet_alloc();
+        if (!pkts[i]) {
+            ret = AVERROR(ENOMEM);
+            goto finish;
+        }
     }
 
     thread_set_name(of);
 
     while (1) {
-        OutputStream *ost;
-        int stream_idx, stream_eof = 0;
+        int nb_recv, nb_pkts;
 
-        ret = tq_receive(mux->tq, &stream_idx, pkt);
-        if (stream_idx < 0) {
+        nb_recv = tq_receive_many(mux->tq, stream_idx, (void **)pkts,
+                                  FF_ARRAY_ELEMS(pkts));
+        if (stream_idx[0] < 0) {
             av_log(mux, AV_LOG_VERBOSE, "All streams finished\n");
             ret = 0;
             break;
         }
 
-        ost = of->streams[stream_idx];
-        ret = sync_queue_process(mux, ost, ret < 0 ? NULL : pkt, &stream_eof);
-        av_packet_unref(pkt);
-        if (ret == AVERROR_EOF) {
-            if (stream_eof) {
-                tq_receive_finish(mux->tq, stream_idx);
-            } else {
-                av_log(mux, AV_LOG_VERBOSE, "Muxer returned EOF\n");
-                ret = 0;
-                break;
+        /* a stream EOF is processed as a single NULL packet */
+        nb_pkts = nb_recv < 0 ? 1 : nb_recv;
+
+        for (int i = 0; i < nb_pkts; i++) {
+            OutputStream *ost = of->streams[stream_idx[i]];
+            int stream_eof = 0;
+
+            ret = sync_queue_process(mux, ost, nb_recv < 0 ? NULL : pkts[i],
+                                     &stream_eof);
+            av_packet_unref(pkts[i]);
+            if (ret == AVERROR_EOF) {
+                if (stream_eof) {
+                    tq_receive_finish(mux->tq, stream_idx[i]);
+                } else {
+                    av_log(mux, AV_LOG_VERBOSE, "Muxer returned EOF\n");
+                    ret = 0;
+                    goto finish;
+                }
+            } else if (ret < 0) {
+                av_log(mux, AV_LOG_ERROR, "Error muxing a packet\n");
+                goto finish;
             }
-        } else if (ret < 0) {
-            av_log(mux, AV_LOG_ERROR, "Error muxing a packet\n");
-            break;
         }
     }
 
 finish:
-    av_packet_free(&pkt);
+    for (int i = 0; i < FF_ARRAY_ELEMS(pkts); i++)
+        av_packet_free(&pkts[i]);
 
     for (unsigned int i = 0; i < mux->fc->nb_streams; i++)
         tq_receive_finish(mux->tq, i);
@@ -328,6 +357,30 @@ finish:
     return ret == AVERROR_EOF ? 0 : ret;
 }
 
+// submit nb_pkts non-NULL packets at once; the packets are always unreffed
+static int thread_submit_packets(Muxer *mux, OutputStream *ost,
+                                 AVPacket **pkts, unsigned int nb_pkts) {
+    unsigned int nb_sent = 0;
+    int ret = 0;
+
+    if (!nb_pkts)
+        return 0;
+
+    if (!(ost->finished & MUXER_FINISHED)) {
+        ret = tq_send_many(mux->tq, ost->index, (void **)pkts, nb_pkts,
+                           &nb_sent);
+        if (ret >= 0)
+            return 0;
+    }
+
+    for (unsigned int i = nb_sent; i < nb_pkts; i++)
+        av_packet_unref(pkts[i]);
+
+    ost->finished |= MUXER_FINISHED;
+    tq_send_finish(mux->tq, ost->index);
+    return ret == AVERROR_EOF ? 0 : ret;
+}
+
 static int queue_packet(OutputStream *ost, AVPacket *pkt) {
     MuxStream *ms = ms_from_ost(ost);
     AVPacket *tmp_pkt = NULL;
@@ -394,9 +447,11 @@ int of_output_packet(OutputFile *of, OutputStream *ost, AVPacket *pkt) {
     const char *err_msg;
     int ret = 0;
 
-    if (pkt && pkt->dts != AV_NOPTS_VALUE)
+    if (pkt && pkt->dts != AV_NOPTS_VALUE) {
         ost->last_mux_dts =
             av_rescale_q(pkt->dts, pkt->time_base, AV_TIME_BASE_Q);
+        ost_sched_update(ost);
+    }
 
     /* apply the output bitstream filters */
     if (ms->bsf_ctx) {
@@ -560,17 +615,35 @@ static int thread_start(Muxer *mux) {
     for (int i = 0; i < fc->nb_streams; i++) {
         OutputStream *ost = mux->of.streams[i];
         MuxStream *ms = ms_from_ost(ost);
+        AVPacket *pkts[MUX_THREAD_BATCH];
+        unsigned int nb_pkts = 0;
         AVPacket *pkt;
 
         while (av_fifo_read(ms->muxing_queue, &pkt, 1) >= 0) {
-            ret = thread_submit_packet(mux, ost, pkt);
             if (pkt) {
                 ms->muxing_queue_data_size -= pkt->size;
-                av_packet_free(&pkt);
+                pkts[nb_pkts++] = pkt;
+                if (nb_pkts < FF_ARRAY_ELEMS(pkts))
+                    continue;
             }
+
+            ret = thread_submit_packets(mux, ost, pkts, nb_pkts);
+            for (unsigned int j = 0; j < nb_pkts; j++)
+                av_packet_free(&pkts[j]);
+            nb_pkts = 0;
+
+            /* a NULL packet signals EOF for this stream */
+            if (ret >= 0 && !pkt)
+                ret = thread_submit_packet(mux, ost, NULL);
             if (ret < 0)
                 return ret;
         }
+
+        ret = thread_submit_packets(mux, ost, pkts, nb_pkts);
+        for (unsigned int j = 0; j < nb_pkts; j++)
+            av_packet_free(&pkts[j]);
+        if (ret < 0)
+            return ret;
     }
 
     return 0;
@@ -830,8 +903,20 @@ static void mux_final_stats(Muxer *mux) {
     }
 
     av_log(of, AV_LOG_VERBOSE,
-           "  Total: %" PRIu64 " packets (%" PRIu64 " bytes) muxed\n",
-           total_packets, total_size);
+           "  Total: %" PRIu64 " packets (%" PRIu64 " bytes) muxed; %" PRId64
+           " bytes written\n",
+           total_packets, total_size, mux->bytes_written);
+
+    if (digest_io_md5(mux->digest))
+        av_log(of, AV_LOG_INFO, "  MD5: %s\n", digest_io_md5(mux->digest));
+    if (digest_io_sha256(mux->digest))
+        av_log(of, AV_LOG_INFO, "  SHA-256: %s\n",
+               digest_io_sha256(mux->digest));
+
+    if (output_stats_callback != NULL)
+        output_stats_callback(of->index, of->url, total_packets, total_size,
+                              mux->bytes_written, digest_io_md5(mux->digest),
+                              digest_io_sha256(mux->digest));
 
     if (total_size && file_size > 0 && file_size >= total_size) {
         snprintf(overhead, sizeof(overhead), "%f%%",
@@ -866,10 +951,29 @@ int of_write_trailer(OutputFile *of) {
         mux_result = err_merge(mux_result, ret);
     }
 
-    mux->last_filesize = filesize(fc->pb);
+    mux->last_filesize = filesize(mux, fc->pb);
+    if (fc->pb) {
+        /* a muxer that went back to rewrite an earlier region may have
+         * written past the highest position seen between packets */
+        if (avio_tell(fc->pb) < mux->pos_max) {
+            int64_t size = avio_size(fc->pb);
+            if (size > mux->pos_max)
+                mux->last_filesize = size;
+        }
+        mux->bytes_written = fc->pb->bytes_written;
+    }
+
+    /* an mp4/mov header patched above means the file is read back in full
+     * here, see fftools_digest_io.h */
+    if (mux->digest)
+        digest_io_finish(mux->digest);
+
+    /* the digests are owned by the hashing context, report them before it
+     * is closed */
+    mux_final_stats(mux);
 
     if (!(of->format->flags & AVFMT_NOFILE)) {
-        ret = avio_closep(&fc->pb);
+        ret = digest_io_closep(&mux->digest, &fc->pb);
         if (ret < 0) {
             av_log(mux, AV_LOG_ERROR, "Error closing file: %s\n",
                    av_err2str(ret));
@@ -877,8 +981,6 @@ int of_write_trailer(OutputFile *of) {
         }
     }
 
-    mux_final_stats(mux);
-
     // check whether anything was actually written
     ret = check_written(of);
     mux_result = err_merge(mux_result, ret);
@@ -952,14 +1054,14 @@ static void ost_free(OutputStream **post) {
     av_freep(post);
 }
 
-static void fc_close(AVFormatContext **pfc) {
+static void fc_close(AVFormatContext **pfc, DigestIO **digest) {
     AVFormatContext *fc = *pfc;
 
     if (!fc)
         return;
 
     if (!(fc->oformat->flags & AVFMT_NOFILE))
-        avio_closep(&fc->pb);
+        digest_io_closep(digest, &fc->pb);
     avformat_free_context(fc);
 
     *pfc = NULL;
@@ -986,7 +1088,7 @@ void of_free(OutputFile **pof) {
 
     av_packet_free(&mux->sq_pkt);
 
-    fc_close(&mux->fc);
+    fc_close(&mux->fc, &mux->digest);
 
     av_freep(pof);
 }
@@ -27,6 +27,12 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - output AVIOContext wrapped by DigestIO when the digest option is set
+ * - file_fadvise and file_direct options set on file: outputs by the session
+ * page cache policy
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -2846,18 +2852,53 @@ int of_open(const OptionsContext *o, const char *filename) {
     }
 
     if (!(oc->oformat->flags & AVFMT_NOFILE)) {
+        AVDictionary *protocol_opts = NULL;
+        int types = 0;
+
+        if (o->digest) {
+            err = digest_io_parse(mux, o->digest, &types);
+            if (err >= 0)
+                err = digest_io_check_muxer(mux, oc->oformat, mux->opts);
+            if (err < 0)
+                return err;
+        }
+
         /* test if it already exists to avoid losing precious files */
         err = assert_file_overwrite(filename);
         if (err < 0)
             return err;
 
+        err = add_file_cache_options(&mux->opts, filename, 1);
+        if (err < 0)
+            return err;
+
+        /* the digest reads missing ranges back with the same options */
+        if (o->digest) {
+            err = av_dict_copy(&protocol_opts, mux->opts, 0);
+            if (err < 0) {
+                av_dict_free(&protocol_opts);
+                return err;
+            }
+        }
+
         /* open the file */
         if ((err = avio_open2(&oc->pb, filename, AVIO_FLAG_WRITE,
                               &oc->interrupt_callback, &mux->opts)) < 0) {
             av_log(mux, AV_LOG_FATAL, "Error opening output %s: %s\n", filename,
                    av_err2str(err));
+            av_dict_free(&protocol_opts);
             return err;
         }
+
+        if (o->digest) {
+            err = digest_io_wrap(&mux->digest, &oc->pb, filename,
+                                 &oc->interrupt_callback, protocol_opts,
+                                 types);
+            av_dict_free(&protocol_opts);
+            if (err < 0)
+                return err;
+            digest_io_set_muxer(mux->digest, oc);
+        }
     } else if (strcmp(oc->oformat->name, "image2") == 0 &&
                !av_filename_number_test(filename)) {
         err = assert_file_overwrite(filename);
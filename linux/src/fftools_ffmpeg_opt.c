@@ -28,6 +28,10 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - thread_queue_size_max and seek_index initialized in init_options
+ *
  * 11.2024
  * --------------------------------------------------------
  * - FFmpeg 6.1 changes migrated
@@ -196,7 +200,9 @@ void init_options(OptionsContext *o) {
     o->limit_filesize = INT64_MAX;
     o->chapters_input_file = INT_MAX;
     o->accurate_seek = 1;
+    o->seek_index = 1;
     o->thread_queue_size = -1;
+    o->thread_queue_size_max = -1;
     o->input_sync_ref = -1;
     o->find_stream_info = 1;
     o->shortest_buf_duration = 10.f;
@@ -25,12 +25,20 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - pool made safe to share between threads: idle objects kept in a lock-free
+ * depot with adaptive capacity instead of a fixed array, per-thread
+ * ObjPoolCache and hit/miss/free counters added
+ *
  * 07.2023
  * --------------------------------------------------------
  * - FFmpeg 6.0 changes migrated
  * - fftools header names updated
  */
 
+#include <limits.h>
+#include <stdatomic.h>
 #include <stdint.h>
 
 #include "libavcodec/packet.h"
@@ -42,15 +50,172 @@
 
 #include "fftools_objpool.h"
 
+/* size of the shared depot, i.e. the upper bound for the pool capacity; must
+ * be a power of two */
+#define DEPOT_SIZE 256
+/* initial and minimum number of idle objects retained */
+#define CAPACITY_MIN 32
+/* number of gets after which the capacity may shrink */
+#define SHRINK_WINDOW 1024
+
+#define CACHE_SIZE 16
+
+/* one slot of the depot, a bounded multi-producer/multi-consumer ring where
+ * every slot carries a sequence number telling whether it is ready to be
+ * written or read at the current position */
+typedef struct DepotCell {
+    atomic_size_t seq;
+    void *obj;
+} DepotCell;
+
 struct ObjPool {
-    void *pool[32];
-    unsigned int pool_count;
+    DepotCell depot[DEPOT_SIZE];
+    atomic_size_t push_pos;
+    atomic_size_t pop_pos;
+    /* approximate number of objects in the depot */
+    atomic_uint nb_idle;
+    atomic_uint capacity;
+
+    /* objects freed because the depot was at capacity since the last miss */
+    atomic_uint nb_overflows;
+    atomic_uint window_gets;
+    atomic_uint window_low;
+
+    atomic_uint_least64_t hits;
+    atomic_uint_least64_t misses;
+    atomic_uint_least64_t frees;
 
     ObjPoolCBAlloc alloc;
     ObjPoolCBReset reset;
     ObjPoolCBFree free;
 };
 
+struct ObjPoolCache {
+    ObjPool *op;
+
+    void *objs[CACHE_SIZE];
+    unsigned int nb_objs;
+
+    uint64_t hits;
+    uint64_t misses;
+};
+
+static int depot_push(ObjPool *op, void *obj) {
+    size_t pos = atomic_load_explicit(&op->push_pos, memory_order_relaxed);
+
+    while (1) {
+        DepotCell *cell = &op->depot[pos & (DEPOT_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &op->push_pos, &pos, pos + 1, memory_order_relaxed,
+                    memory_order_relaxed)) {
+                cell->obj = obj;
+                atomic_store_explicit(&cell->seq, pos + 1,
+                                      memory_order_release);
+                atomic_fetch_add_explicit(&op->nb_idle, 1,
+                                          memory_order_relaxed);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return AVERROR(ENOSPC);
+        } else
+            pos = atomic_load_explicit(&op->push_pos, memory_order_relaxed);
+    }
+}
+
+static void *depot_pop(ObjPool *op) {
+    size_t pos = atomic_load_explicit(&op->pop_pos, memory_order_relaxed);
+
+    while (1) {
+        DepotCell *cell = &op->depot[pos & (DEPOT_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &op->pop_pos, &pos, pos + 1, memory_order_relaxed,
+                    memory_order_relaxed)) {
+                void *obj = cell->obj;
+                atomic_store_explicit(&cell->seq, pos + DEPOT_SIZE,
+                                      memory_order_release);
+                atomic_fetch_sub_explicit(&op->nb_idle, 1,
+                                          memory_order_relaxed);
+                return obj;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else
+            pos = atomic_load_explicit(&op->pop_pos, memory_order_relaxed);
+    }
+}
+
+// track the lowest idle count over a window of gets; when the pool never ran
+// below half of its capacity, the other half is dead weight
+static void pool_maybe_shrink(ObjPool *op) {
+    unsigned int idle, low, capacity;
+
+    idle = atomic_load_explicit(&op->nb_idle, memory_order_relaxed);
+    low = atomic_load_explicit(&op->window_low, memory_order_relaxed);
+
+    while (idle < low &&
+           !atomic_compare_exchange_weak_explicit(&op->window_low, &low, idle,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+        ;
+
+    if (atomic_fetch_add_explicit(&op->window_gets, 1, memory_order_relaxed) !=
+        SHRINK_WINDOW - 1)
+        return;
+
+    low = atomic_exchange_explicit(&op->window_low, UINT_MAX,
+                                   memory_order_relaxed);
+    atomic_store_explicit(&op->window_gets, 0, memory_order_relaxed);
+
+    capacity = atomic_load_explicit(&op->capacity, memory_order_relaxed);
+    if (capacity <= CAPACITY_MIN || low < capacity / 2)
+        return;
+
+    capacity = FFMAX(capacity / 2, CAPACITY_MIN);
+    atomic_store_explicit(&op->capacity, capacity, memory_order_relaxed);
+
+    while (atomic_load_explicit(&op->nb_idle, memory_order_relaxed) >
+           capacity) {
+        void *obj = depot_pop(op);
+        if (!obj)
+            break;
+        op->free(&obj);
+    }
+}
+
+// a miss after objects were freed for lack of room means the capacity is
+// too small for the number of objects in flight
+static void pool_maybe_grow(ObjPool *op) {
+    unsigned int capacity;
+
+    if (!atomic_exchange_explicit(&op->nb_overflows, 0, memory_order_relaxed))
+        return;
+
+    capacity = atomic_load_explicit(&op->capacity, memory_order_relaxed);
+    if (capacity < DEPOT_SIZE)
+        atomic_store_explicit(&op->capacity, FFMIN(2 * capacity, DEPOT_SIZE),
+                              memory_order_relaxed);
+}
+
+// hand a reset object over to the depot, freeing it if the pool is full
+static void pool_put(ObjPool *op, void *obj) {
+    if (atomic_load_explicit(&op->nb_idle, memory_order_relaxed) <
+            atomic_load_explicit(&op->capacity, memory_order_relaxed) &&
+        depot_push(op, obj) >= 0)
+        return;
+
+    atomic_fetch_add_explicit(&op->nb_overflows, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&op->frees, 1, memory_order_relaxed);
+    op->free(&obj);
+}
+
 ObjPool *objpool_alloc(ObjPoolCBAlloc cb_alloc, ObjPoolCBReset cb_reset,
                        ObjPoolCBFree cb_free) {
     ObjPool *op = av_mallocz(sizeof(*op));
@@ -58,6 +223,19 @@ ObjPool *objpool_alloc(ObjPoolCBAlloc cb_alloc, ObjPoolCBReset cb_reset,
     if (!op)
         return NULL;
 
+    for (size_t i = 0; i < DEPOT_SIZE; i++)
+        atomic_init(&op->depot[i].seq, i);
+    atomic_init(&op->push_pos, 0);
+    atomic_init(&op->pop_pos, 0);
+    atomic_init(&op->nb_idle, 0);
+    atomic_init(&op->capacity, CAPACITY_MIN);
+    atomic_init(&op->nb_overflows, 0);
+    atomic_init(&op->window_gets, 0);
+    atomic_init(&op->window_low, UINT_MAX);
+    atomic_init(&op->hits, 0);
+    atomic_init(&op->misses, 0);
+    atomic_init(&op->frees, 0);
+
     op->alloc = cb_alloc;
     op->reset = cb_reset;
     op->free = cb_free;
@@ -67,22 +245,29 @@ ObjPool *objpool_alloc(ObjPoolCBAlloc cb_alloc, ObjPoolCBReset cb_reset,
 
 void objpool_free(ObjPool **pop) {
     ObjPool *op = *pop;
+    void *obj;
 
     if (!op)
         return;
 
-    for (unsigned int i = 0; i < op->pool_count; i++)
-        op->free(&op->pool[i]);
+    while ((obj = depot_pop(op)))
+        op->free(&obj);
 
     av_freep(pop);
 }
 
 int objpool_get(ObjPool *op, void **obj) {
-    if (op->pool_count) {
-        *obj = op->pool[--op->pool_count];
-        op->pool[op->pool_count] = NULL;
-    } else
-        *obj = op->alloc();
+    *obj = depot_pop(op);
+    if (*obj) {
+        atomic_fetch_add_explicit(&op->hits, 1, memory_order_relaxed);
+        pool_maybe_shrink(op);
+        return 0;
+    }
+
+    atomic_fetch_add_explicit(&op->misses, 1, memory_order_relaxed);
+    pool_maybe_grow(op);
+
+    *obj = op->alloc();
 
     return *obj ? 0 : AVERROR(ENOMEM);
 }
@@ -92,15 +277,97 @@ void objpool_release(ObjPool *op, void **obj) {
         return;
 
     op->reset(*obj);
+    pool_put(op, *obj);
+
+    *obj = NULL;
+}
+
+ObjPoolCache *objpool_cache_alloc(ObjPool *op) {
+    ObjPoolCache *pc = av_mallocz(sizeof(*pc));
+
+    if (!pc)
+        return NULL;
+
+    pc->op = op;
+
+    return pc;
+}
+
+static void cache_flush_stats(ObjPoolCache *pc) {
+    atomic_fetch_add_explicit(&pc->op->hits, pc->hits, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pc->op->misses, pc->misses,
+                              memory_order_relaxed);
+    pc->hits = 0;
+    pc->misses = 0;
+}
+
+void objpool_cache_free(ObjPoolCache **ppc) {
+    ObjPoolCache *pc = *ppc;
+
+    if (!pc)
+        return;
+
+    for (unsigned int i = 0; i < pc->nb_objs; i++)
+        pool_put(pc->op, pc->objs[i]);
+    cache_flush_stats(pc);
+
+    av_freep(ppc);
+}
+
+int objpool_cache_get(ObjPoolCache *pc, void **obj) {
+    ObjPool *op = pc->op;
+
+    /* refill half of the cache from the depot in one go */
+    if (!pc->nb_objs) {
+        while (pc->nb_objs < CACHE_SIZE / 2) {
+            void *o = depot_pop(op);
+            if (!o)
+                break;
+            pc->objs[pc->nb_objs++] = o;
+        }
+        cache_flush_stats(pc);
+        if (pc->nb_objs)
+            pool_maybe_shrink(op);
+    }
+
+    if (pc->nb_objs) {
+        *obj = pc->objs[--pc->nb_objs];
+        pc->hits++;
+        return 0;
+    }
+
+    pc->misses++;
+    pool_maybe_grow(op);
+
+    *obj = op->alloc();
 
-    if (op->pool_count < FF_ARRAY_ELEMS(op->pool))
-        op->pool[op->pool_count++] = *obj;
-    else
-        op->free(obj);
+    return *obj ? 0 : AVERROR(ENOMEM);
+}
+
+void objpool_cache_release(ObjPoolCache *pc, void **obj) {
+    if (!*obj)
+        return;
 
+    pc->op->reset(*obj);
+
+    /* hand half of a full cache back to the depot in one go */
+    if (pc->nb_objs == CACHE_SIZE) {
+        while (pc->nb_objs > CACHE_SIZE / 2)
+            pool_put(pc->op, pc->objs[--pc->nb_objs]);
+        cache_flush_stats(pc);
+    }
+
+    pc->objs[pc->nb_objs++] = *obj;
     *obj = NULL;
 }
 
+void objpool_stats(ObjPool *op, ObjPoolStats *stats) {
+    stats->hits = atomic_load(&op->hits);
+    stats->misses = atomic_load(&op->misses);
+    stats->frees = atomic_load(&op->frees);
+    stats->capacity = atomic_load(&op->capacity);
+}
+
 static void *alloc_packet(void) { return av_packet_alloc(); }
 static void *alloc_frame(void) { return av_frame_alloc(); }
 
@@ -25,6 +25,10 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - ObjPoolCache per-thread front end, ObjPoolStats and objpool_stats() added
+ *
  * 07.2023
  * --------------------------------------------------------
  * - FFmpeg 6.0 changes migrated
@@ -33,8 +37,35 @@
 #ifndef FFTOOLS_OBJPOOL_H
 #define FFTOOLS_OBJPOOL_H
 
+#include <stdint.h>
+
+/**
+ * A pool of reusable objects.
+ *
+ * All functions except objpool_free() may be called concurrently from any
+ * number of threads. Idle objects are kept in a lock-free shared depot; the
+ * number of idle objects retained adapts to the observed demand.
+ */
 typedef struct ObjPool ObjPool;
 
+/**
+ * A per-thread front end to an ObjPool, which keeps a few objects local to
+ * the owning thread and exchanges them with the shared depot in bulk. A cache
+ * must only be used by one thread at a time.
+ */
+typedef struct ObjPoolCache ObjPoolCache;
+
+typedef struct ObjPoolStats {
+    /* number of gets served with a pooled object */
+    uint64_t hits;
+    /* number of gets that had to allocate a new object */
+    uint64_t misses;
+    /* number of releases that freed the object because the pool was full */
+    uint64_t frees;
+    /* current maximum number of idle objects retained */
+    unsigned int capacity;
+} ObjPoolStats;
+
 typedef void *(*ObjPoolCBAlloc)(void);
 typedef void (*ObjPoolCBReset)(void *);
 typedef void (*ObjPoolCBFree)(void **);
@@ -48,4 +79,19 @@ ObjPool *objpool_alloc_frames(void);
 int objpool_get(ObjPool *op, void **obj);
 void objpool_release(ObjPool *op, void **obj);
 
+ObjPoolCache *objpool_cache_alloc(ObjPool *op);
+/**
+ * Return all the objects held by the cache to its pool and free the cache.
+ */
+void objpool_cache_free(ObjPoolCache **pc);
+
+int objpool_cache_get(ObjPoolCache *pc, void **obj);
+void objpool_cache_release(ObjPoolCache *pc, void **obj);
+
+/**
+ * Retrieve the pool counters. Counters of caches that are still alive are
+ * only included up to their last exchange with the shared depot.
+ */
+void objpool_stats(ObjPool *op, ObjPoolStats *stats);
+
 #endif // FFTOOLS_OBJPOOL_H
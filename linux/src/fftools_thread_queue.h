@@ -25,6 +25,10 @@
  *
  * ffmpeg-kit changes by ARTHENICA LTD
  *
+ * 10.2026
+ * --------------------------------------------------------
+ * - tq_send_many() and tq_receive_many() added
+ *
  * 07.2023
  * --------------------------------------------------------
  * - FFmpeg 6.0 changes migrated
@@ -68,6 +72,22 @@ void tq_free(ThreadQueue **tq);
  * - AVERROR_EOF the receiving side has marked the given stream as finished
  */
 int tq_send(ThreadQueue *tq, unsigned int stream_idx, void *data);
+/**
+ * Send several items for the given stream to the queue.
+ *
+ * Behaves like calling tq_send() for each item, except that the queue lock is
+ * taken once and the consumer is woken up once for every run of items that
+ * fits into the queue.
+ *
+ * @param data array of nb_items items to send; items that were sent are moved
+ *             out of, the rest are left untouched
+ * @param nb_sent if non-NULL, the number of items that were sent is written
+ *                here, also on failure
+ * @return 0 when all the items were sent, otherwise the same error codes as
+ *         tq_send()
+ */
+int tq_send_many(ThreadQueue *tq, unsigned int stream_idx, void **data,
+                 unsigned int nb_items, unsigned int *nb_sent);
 /**
  * Mark the given stream finished from the sending side.
  */
@@ -88,6 +108,21 @@ void tq_send_finish(ThreadQueue *tq, unsigned int stream_idx);
  *   for each stream. When *stream_idx is -1, all streams are done.
  */
 int tq_receive(ThreadQueue *tq, int *stream_idx, void *data);
+/**
+ * Read up to nb_items items from the queue.
+ *
+ * Waits like tq_receive() until at least one item or an EOF is available, then
+ * also returns any items that are already queued, without waiting for more.
+ *
+ * @param stream_idx array of nb_items entries; the stream index of each item
+ *                   read is written here, on failure stream_idx[0] is set as
+ *                   tq_receive() sets *stream_idx
+ * @param data array of nb_items items that are written to on success
+ * @return the number of items read (> 0) or an error code as returned by
+ *         tq_receive()
+ */
+int tq_receive_many(ThreadQueue *tq, int *stream_idx, void **data,
+                    unsigned int nb_items);
 /**
  * Mark the given stream finished from the receiving side.
  */
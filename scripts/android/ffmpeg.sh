@@ -403,10 +403,15 @@ ${SED_INLINE} 's/static int av_log_level/__thread int av_log_level/g' "${BASEDIR
 if [[ ${NO_FFMPEG_KIT_PROTOCOLS} == "1" ]]; then
   echo -e "\nINFO: Disabled custom ffmpeg-kit protocols\n" 1>>"${BASEDIR}"/build.log 2>&1
 else
+  # ffmpeg-kit protocols use Linux calls hidden by the default feature macros
+  awk 'NR==1{print "#define _GNU_SOURCE"}1' libavformat/file.c > libavformat/file.c.tmp
+  cat libavformat/file.c.tmp > libavformat/file.c
+  awk -f ../../tools/protocols/libavformat_file.awk libavformat/file.c > libavformat/file.c.tmp
+  cat libavformat/file.c.tmp > libavformat/file.c
   cat ../../tools/protocols/libavformat_file.c >> libavformat/file.c
   cat ../../tools/protocols/libavutil_file.h >> libavutil/file.h
   cat ../../tools/protocols/libavutil_file.c >> libavutil/file.c
-  awk '{gsub(/ff_file_protocol;/,"ff_file_protocol;\nextern const URLProtocol ff_saf_protocol;")}1' libavformat/protocols.c > libavformat/protocols.c.tmp
+  awk '{gsub(/ff_file_protocol;/,"ff_file_protocol;\nextern const URLProtocol ff_saf_protocol;\nextern const URLProtocol ff_memory_protocol;\nextern const URLProtocol ff_blockcache_protocol;")}1' libavformat/protocols.c > libavformat/protocols.c.tmp
   cat libavformat/protocols.c.tmp > libavformat/protocols.c
   ${SED_INLINE} "s|av_strstart(proto_name, \"file\", NULL))|av_strstart(proto_name, \"file\", NULL) \|\| av_strstart(proto_name, \"saf\", NULL))|g" libavformat/hls.c 1>>"${BASEDIR}"/build.log 2>&1
   echo -e "\nINFO: Enabled custom ffmpeg-kit protocols\n" 1>>"${BASEDIR}"/build.log 2>&1
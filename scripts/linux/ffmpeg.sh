@@ -356,6 +356,19 @@ git checkout libavutil 1>>"${BASEDIR}"/build.log 2>&1
 # 1. Use thread local log levels
 ${SED_INLINE} 's/static int av_log_level/__thread int av_log_level/g' "${BASEDIR}"/src/"${LIB_NAME}"/libavutil/log.c 1>>"${BASEDIR}"/build.log 2>&1 || return 1
 
+# 2. Enable ffmpeg-kit protocols
+# ffmpeg-kit protocols use Linux calls hidden by the default feature macros
+awk 'NR==1{print "#define _GNU_SOURCE"}1' libavformat/file.c > libavformat/file.c.tmp
+cat libavformat/file.c.tmp > libavformat/file.c
+awk -f ../../tools/protocols/libavformat_file.awk libavformat/file.c > libavformat/file.c.tmp
+cat libavformat/file.c.tmp > libavformat/file.c
+cat ../../tools/protocols/libavformat_file.c >> libavformat/file.c
+cat ../../tools/protocols/libavutil_file.h >> libavutil/file.h
+cat ../../tools/protocols/libavutil_file.c >> libavutil/file.c
+awk '{gsub(/ff_file_protocol;/,"ff_file_protocol;\nextern const URLProtocol ff_memory_protocol;\nextern const URLProtocol ff_uring_protocol;\nextern const URLProtocol ff_blockcache_protocol;")}1' libavformat/protocols.c > libavformat/protocols.c.tmp
+cat libavformat/protocols.c.tmp > libavformat/protocols.c
+echo -e "\nINFO: Enabled custom ffmpeg-kit protocols\n" 1>>"${BASEDIR}"/build.log 2>&1
+
 ###################################################################
 
 ./configure \
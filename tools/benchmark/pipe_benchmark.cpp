@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Feeds a media file to FFmpeg through each kind of pipe FFmpegKitConfig
+ * offers and prints the throughput of a stream copy to the null muxer:
+ *
+ *   fifo     named pipe from registerNewFFmpegPipe, filled with write()
+ *   fd       anonymous pipe from registerNewFFmpegFdPipe, filled with write()
+ *   splice   anonymous pipe from registerNewFFmpegFdPipe, filled with
+ *            spliceFFmpegPipe from the file descriptor
+ *
+ * Build it against a linux bundle created by linux.sh:
+ *
+ *   BUNDLE=prebuilt/bundle-linux/ffmpeg-kit
+ *   g++ -std=c++11 tools/benchmark/pipe_benchmark.cpp -o pipe_benchmark \
+ *       -I${BUNDLE}/include -L${BUNDLE}/lib -lffmpegkit -lpthread
+ *
+ * Usage: pipe_benchmark [-n <runs>] [-s <pipe size>] <media file>
+ *
+ * Each method runs <runs> times, 5 by default, and the median is printed.
+ * <pipe size> is the capacity requested for the anonymous pipes, zero keeps
+ * the default. Exits with 1 if a run fails.
+ */
+
+#include <FFmpegKit.h>
+#include <FFmpegKitConfig.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+enum Method { Fifo, Fd, Splice };
+
+const char *const MethodNames[] = {"fifo", "fd", "splice"};
+
+/**
+ * Copies the file to the write end of a pipe with write().
+ */
+void writeFile(const char *path, const int pipeFd) {
+    std::vector<char> buffer(1 << 16);
+    int fd = open(path, O_RDONLY);
+    ssize_t rc;
+
+    while (fd >= 0 && (rc = read(fd, buffer.data(), buffer.size())) > 0) {
+        for (ssize_t written = 0; written < rc;) {
+            ssize_t n = write(pipeFd, buffer.data() + written, rc - written);
+            if (n <= 0) {
+                close(fd);
+                return;
+            }
+            written += n;
+        }
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void spliceFile(const char *path, const int pipeFd) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd >= 0) {
+        ffmpegkit::FFmpegKitConfig::spliceFFmpegPipe(fd, pipeFd, 0);
+        close(fd);
+    }
+}
+
+/**
+ * Runs a stream copy of the file through a pipe created with the given
+ * method and returns the time it took in seconds, a negative value if it
+ * failed.
+ */
+double run(const Method method, const char *path, const int pipeSize) {
+    std::shared_ptr<std::string> url;
+    std::thread feeder;
+    int callerFd = -1;
+
+    if (method == Fifo) {
+        url = ffmpegkit::FFmpegKitConfig::registerNewFFmpegPipe();
+    } else {
+        url = ffmpegkit::FFmpegKitConfig::registerNewFFmpegFdPipe(
+            true, pipeSize, &callerFd);
+    }
+    if (url == nullptr) {
+        return -1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (method == Fifo) {
+        const std::string fifo = *url;
+        feeder = std::thread([fifo, path]() {
+            // BLOCKS UNTIL FFMPEG OPENS THE FIFO
+            int fd = open(fifo.c_str(), O_WRONLY);
+            if (fd >= 0) {
+                writeFile(path, fd);
+                close(fd);
+            }
+        });
+    } else {
+        feeder = std::thread([method, callerFd, path]() {
+            if (method == Splice) {
+                spliceFile(path, callerFd);
+            } else {
+                writeFile(path, callerFd);
+            }
+            close(callerFd);
+        });
+    }
+
+    auto session = ffmpegkit::FFmpegKit::execute("-hide_banner -y -i " +
+                                                 *url + " -c copy -f null -");
+
+    if (method == Fifo) {
+        // UNBLOCKS THE FEEDER IF FFMPEG NEVER OPENED THE FIFO
+        int fd = open(url->c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd >= 0) {
+            close(fd);
+        }
+        ffmpegkit::FFmpegKitConfig::closeFFmpegPipe(*url);
+    } else {
+        ffmpegkit::FFmpegKitConfig::closeFFmpegFdPipe(*url);
+    }
+    feeder.join();
+
+    auto end = std::chrono::steady_clock::now();
+
+    if (!session->getReturnCode()->isValueSuccess()) {
+        return -1;
+    }
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 5;
+    int pipeSize = 0;
+    int i = 1;
+    struct stat st;
+
+    for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        if (std::strcmp(argv[i], "-n") == 0) {
+            runs = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "-s") == 0) {
+            pipeSize = std::atoi(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (i + 1 != argc || runs <= 0 || stat(argv[i], &st) != 0) {
+        std::fprintf(stderr,
+                     "Usage: %s [-n <runs>] [-s <pipe size>] <media file>\n",
+                     argv[0]);
+        return 2;
+    }
+
+    // FFMPEG MAY STOP READING BEFORE THE FEEDER HAS WRITTEN EVERYTHING
+    std::signal(SIGPIPE, SIG_IGN);
+    ffmpegkit::FFmpegKitConfig::setLogLevel(ffmpegkit::LevelAVLogError);
+
+    std::printf("%-8s %12s %12s\n", "method", "seconds", "MB/s");
+
+    for (Method method : {Fifo, Fd, Splice}) {
+        std::vector<double> durations;
+
+        for (int n = 0; n < runs; n++) {
+            double duration = run(method, argv[i], pipeSize);
+            if (duration < 0) {
+                std::printf("%-8s %12s\n", MethodNames[method], "failed");
+                return 1;
+            }
+            durations.push_back(duration);
+        }
+
+        std::sort(durations.begin(), durations.end());
+        double median = durations[durations.size() / 2];
+        std::printf("%-8s %12.3f %12.1f\n", MethodNames[method], median,
+                    median > 0 ? st.st_size / median / 1e6 : 0.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Differential fuzzer for json_find_escape() of fftools_ffprobe.c. Random
+ * buffers are searched with json_find_escape() and with the scalar loop
+ * json_escape_str() used before it, and the positions found must be equal.
+ *
+ * The buffers are biased towards the bytes around the boundaries of the
+ * search, control characters, '"', '\', DEL and non-ASCII bytes, and are
+ * searched from every alignment so both the 16 byte loop and the tail are
+ * covered.
+ *
+ * json_find_escape() is static, so it is extracted from the source first:
+ *
+ *   FIRST='^static inline int json_needs_escape'
+ *   NEXT='^static const char \*json_escape_str'
+ *   awk "/${FIRST}/,/${NEXT}/" linux/src/fftools_ffprobe.c | sed '$d' \
+ *       > /tmp/json_find_escape.inc
+ *   cc -O2 -I/tmp tools/fuzz/json_escape_fuzz.c -o json_escape_fuzz
+ *
+ * That builds the SSE2 version on x86 and the NEON version on ARM. Adding
+ * -U__SSE2__ or -U__ARM_NEON builds the scalar version.
+ *
+ * Usage: json_escape_fuzz [-n <iterations>] [-s <seed>]
+ *
+ * Runs 1000000 iterations by default. Exits with 1 and prints the buffer on
+ * the first mismatch.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define ff_ctz(v) __builtin_ctz(v)
+
+#include "json_find_escape.inc"
+
+#define MAX_SIZE 96
+
+/**
+ * The search json_escape_str() did before json_find_escape() was added.
+ */
+static const char *scalar_find_escape(const char *p, const char *end) {
+    for (; p < end; p++) {
+        unsigned char c = *p;
+        if (c < 32 || c == '"' || c == '\\')
+            break;
+    }
+    return p;
+}
+
+static uint64_t next(uint64_t *state) {
+    /* xorshift64* */
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static char random_char(uint64_t *state) {
+    static const unsigned char edges[] = {0,   1,    30,   31,   32,
+                                          33,  '"',  '\\', '!',  '#',
+                                          '[', ']',  127,  128,  159,
+                                          160, 0xdc, 0xfe, 0xff};
+    uint64_t r = next(state);
+
+    switch (r % 4) {
+    case 0:
+        return (char)edges[(r >> 8) % sizeof(edges)];
+    case 1:
+        return (char)(r >> 8);
+    default:
+        /* mostly printable ASCII, the common case */
+        return (char)(32 + (r >> 8) % 95);
+    }
+}
+
+int main(int argc, char **argv) {
+    long iterations = 1000000;
+    uint64_t seed = 1;
+    char buffer[MAX_SIZE + 16];
+    long i;
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0)
+            iterations = strtol(argv[i + 1], NULL, 10);
+        else if (strcmp(argv[i], "-s") == 0)
+            seed = strtoull(argv[i + 1], NULL, 10);
+        else
+            break;
+    }
+    if (i != argc || iterations <= 0 || seed == 0) {
+        fprintf(stderr, "Usage: %s [-n <iterations>] [-s <seed>]\n", argv[0]);
+        return 2;
+    }
+
+    for (i = 0; i < iterations; i++) {
+        uint64_t state = seed + (uint64_t)i * 0x9E3779B97F4A7C15ULL;
+        int size, clean, offset, n;
+
+        if (state == 0)
+            state = 1;
+        size = (int)(next(&state) % (MAX_SIZE + 1));
+
+        /* most strings need no escaping, keep long runs without any */
+        clean = next(&state) % 2;
+        for (n = 0; n < size; n++) {
+            char c = random_char(&state);
+            if (clean && n + 1 < size && (unsigned char)c < 32)
+                c = 'a';
+            if (clean && n + 1 < size && (c == '"' || c == '\\'))
+                c = 'b';
+            buffer[n] = c;
+        }
+
+        for (offset = 0; offset < 16 && offset <= size; offset++) {
+            const char *p = buffer + offset;
+            const char *end = buffer + size;
+            const char *expected = scalar_find_escape(p, end);
+            const char *found = json_find_escape(p, end);
+
+            if (found != expected) {
+                printf("mismatch at iteration %ld, offset %d: expected %ld, "
+                       "found %ld\n",
+                       i, offset, (long)(expected - p), (long)(found - p));
+                for (n = offset; n < size; n++)
+                    printf("%02x%c", (unsigned char)buffer[n],
+                           (n - offset) % 16 == 15 ? '\n' : ' ');
+                printf("\n");
+                return 1;
+            }
+        }
+    }
+
+    printf("%ld iterations, no mismatch\n", iterations);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures how long FFprobe and the in-process probe take to get the media
+ * information of each media file given and prints the median of both.
+ *
+ * Build it against a linux bundle created by linux.sh:
+ *
+ *   BUNDLE=prebuilt/bundle-linux/ffmpeg-kit
+ *   g++ -std=c++11 tools/parity/probe_benchmark.cpp -o probe_benchmark \
+ *       -I${BUNDLE}/include -L${BUNDLE}/lib -lffmpegkit -lpthread
+ *
+ * Usage: probe_benchmark [-n <runs>] <media file>...
+ *
+ * Each file is probed <runs> times with each method, 10 by default. The
+ * media information cache is not enabled, so every run opens the file. Exits
+ * with 1 if a file can't be probed.
+ */
+
+#include <FFmpegKitConfig.h>
+#include <FFprobeKit.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Runs probe the given number of times and returns the median duration in
+ * milliseconds, a negative value if a run fails.
+ */
+double measure(const int runs, const std::function<bool()> &probe) {
+    std::vector<double> durations;
+
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (!probe()) {
+            return -1;
+        }
+        auto end = std::chrono::steady_clock::now();
+        durations.push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(durations.begin(), durations.end());
+    return durations[durations.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 10;
+    int first = 1;
+    int failures = 0;
+
+    if (argc > 2 && std::strcmp(argv[1], "-n") == 0) {
+        runs = std::atoi(argv[2]);
+        first = 3;
+    }
+    if (first >= argc || runs <= 0) {
+        std::fprintf(stderr, "Usage: %s [-n <runs>] <media file>...\n",
+                     argv[0]);
+        return 2;
+    }
+
+    ffmpegkit::FFmpegKitConfig::setLogLevel(ffmpegkit::LevelAVLogError);
+
+    std::printf("%-48s %12s %12s %8s\n", "file", "ffprobe ms", "native ms",
+                "speedup");
+
+    for (int i = first; i < argc; i++) {
+        const std::string path(argv[i]);
+
+        double ffprobe = measure(runs, [&path]() {
+            return ffmpegkit::FFprobeKit::getMediaInformation(path)
+                       ->getMediaInformation() != nullptr;
+        });
+        double native = measure(runs, [&path]() {
+            return ffmpegkit::FFprobeKit::getMediaInformationNative(path)
+                       ->getMediaInformation() != nullptr;
+        });
+
+        if (ffprobe < 0 || native < 0) {
+            std::printf("%-48s %12s\n", path.c_str(), "failed");
+            failures++;
+            continue;
+        }
+
+        std::printf("%-48s %12.2f %12.2f %7.1fx\n", path.c_str(), ffprobe,
+                    native, native > 0 ? ffprobe / native : 0.0);
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 ARTHENICA LTD
+ *
+ * This file is part of FFmpegKit.
+ *
+ * FFmpegKit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpegKit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with FFmpegKit.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the media information FFprobe's json output gives for a media file
+ * with the one of the in-process probe and prints the keys that differ.
+ *
+ * Build it against a linux bundle created by linux.sh:
+ *
+ *   BUNDLE=prebuilt/bundle-linux/ffmpeg-kit
+ *   g++ -std=c++11 tools/parity/probe_parity.cpp -o probe_parity \
+ *       -I${BUNDLE}/include -L${BUNDLE}/lib -lffmpegkit -lavcodec -lavutil \
+ *       -lpthread
+ *
+ * Usage: probe_parity <media file>
+ *
+ * Exits with 1 if a key is missing or has a different value, not counting
+ * the keys MediaInformationProbe.h lists as not available.
+ */
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavutil/opt.h"
+}
+#include <FFmpegKitConfig.h>
+#include <FFprobeKit.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+/* stream keys the in-process probe does not have, as listed in
+ * MediaInformationProbe.h */
+const char *const OmittedStreamKeys[] = {
+    "coded_width",  "coded_height",  "closed_captions",
+    "film_grain",   "max_bit_rate",  "extradata_hash"};
+
+int differences = 0;
+
+bool isOmittedStreamKey(const rapidjson::Value &ffprobeStream,
+                        const char *key) {
+    for (const char *omitted : OmittedStreamKeys) {
+        if (std::strcmp(key, omitted) == 0) {
+            return true;
+        }
+    }
+
+    // PRIVATE OPTIONS OF THE DECODER
+    auto codecName = ffprobeStream.FindMember("codec_name");
+    if (codecName != ffprobeStream.MemberEnd() &&
+        codecName->value.IsString()) {
+        const AVCodec *codec =
+            avcodec_find_decoder_by_name(codecName->value.GetString());
+        if (codec != NULL && codec->priv_class != NULL &&
+            av_opt_find((void *)&codec->priv_class, key, NULL, 0,
+                        AV_OPT_SEARCH_FAKE_OBJ) != NULL) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string toString(const rapidjson::Value &value) {
+    if (value.IsString()) {
+        return std::string("\"") + value.GetString() + "\"";
+    } else if (value.IsInt64()) {
+        return std::to_string(value.GetInt64());
+    } else if (value.IsDouble()) {
+        return std::to_string(value.GetDouble());
+    } else if (value.IsBool()) {
+        return value.GetBool() ? "true" : "false";
+    } else if (value.IsObject()) {
+        return "{...}";
+    } else if (value.IsArray()) {
+        return "[...]";
+    }
+    return "null";
+}
+
+void report(const std::string &path, const char *what,
+            const std::string &details) {
+    std::printf("%-40s %-8s %s\n", path.c_str(), what, details.c_str());
+}
+
+void compare(const std::string &path, const rapidjson::Value &ffprobe,
+             const rapidjson::Value &native, bool stream) {
+    if (ffprobe.IsObject() && native.IsObject()) {
+        for (auto member = ffprobe.MemberBegin();
+             member != ffprobe.MemberEnd(); ++member) {
+            const char *key = member->name.GetString();
+            std::string memberPath = path + "." + key;
+            auto nativeMember = native.FindMember(key);
+
+            if (nativeMember != native.MemberEnd()) {
+                compare(memberPath, member->value, nativeMember->value, false);
+            } else if (stream && isOmittedStreamKey(ffprobe, key)) {
+                report(memberPath, "omitted", "");
+            } else {
+                report(memberPath, "missing", toString(member->value));
+                differences++;
+            }
+        }
+        for (auto member = native.MemberBegin(); member != native.MemberEnd();
+             ++member) {
+            if (!ffprobe.HasMember(member->name.GetString())) {
+                report(path + "." + member->name.GetString(), "extra",
+                       toString(member->value));
+                differences++;
+            }
+        }
+    } else if (ffprobe.IsArray() && native.IsArray()) {
+        if (ffprobe.Size() != native.Size()) {
+            report(path, "size",
+                   std::to_string(ffprobe.Size()) +
+                       " != " + std::to_string(native.Size()));
+            differences++;
+        }
+        for (rapidjson::SizeType i = 0;
+             i < ffprobe.Size() && i < native.Size(); i++) {
+            compare(path + "[" + std::to_string(i) + "]", ffprobe[i],
+                    native[i], path == ".streams");
+        }
+    } else if (toString(ffprobe) != toString(native)) {
+        report(path, "differs",
+               toString(ffprobe) + " != " + toString(native));
+        differences++;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <media file>\n", argv[0]);
+        return 2;
+    }
+
+    ffmpegkit::FFmpegKitConfig::setLogLevel(ffmpegkit::LevelAVLogError);
+
+    auto ffprobe =
+        ffmpegkit::FFprobeKit::getMediaInformation(argv[1])
+            ->getMediaInformation();
+    auto native = ffmpegkit::FFprobeKit::getMediaInformationNative(argv[1])
+                      ->getMediaInformation();
+    if (ffprobe == nullptr || native == nullptr) {
+        std::fprintf(stderr, "Could not get the media information of %s\n",
+                     argv[1]);
+        return 2;
+    }
+
+    auto ffprobeProperties = ffprobe->getAllProperties();
+    auto nativeProperties = native->getAllProperties();
+    if (ffprobeProperties == nullptr || nativeProperties == nullptr) {
+        std::fprintf(stderr, "No properties defined for %s\n", argv[1]);
+        return 2;
+    }
+
+    compare("", *ffprobeProperties, *nativeProperties, false);
+
+    std::printf("%d difference(s)\n", differences);
+
+    return differences > 0 ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+# Adds the file_fadvise and file_direct options to the file: protocol of
+# libavformat/file.c. The options are applied by the file_policy_* callbacks
+# of libavformat_file.c, which is appended to the same source file.
+
+/^typedef struct FileContext \{/ { in_context = 1 }
+in_context && /^\} FileContext;/ {
+    print "    int fadvise;"
+    print "    int direct;"
+    print "    struct FilePolicy *policy;"
+    in_context = 0
+}
+
+/^static const AVOption file_options\[\] = \{/ { in_options = 1 }
+in_options && /^    \{ NULL \}/ {
+    print "    { \"file_fadvise\", \"keep the file out of the page cache, evicting data behind the read or write position\", offsetof(FileContext, fadvise), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_ENCODING_PARAM | AV_OPT_FLAG_DECODING_PARAM },"
+    print "    { \"file_direct\", \"write aligned blocks with O_DIRECT, bypassing the page cache\", offsetof(FileContext, direct), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_ENCODING_PARAM },"
+    in_options = 0
+}
+
+/^const URLProtocol ff_file_protocol = \{/ {
+    print "static int file_policy_open(URLContext *h, const char *filename, int flags);"
+    print "static int file_policy_read(URLContext *h, unsigned char *buf, int size);"
+    print "static int file_policy_write(URLContext *h, const unsigned char *buf, int size);"
+    print "static int64_t file_policy_seek(URLContext *h, int64_t pos, int whence);"
+    print "static int file_policy_close(URLContext *h);"
+    print ""
+    in_protocol = 1
+}
+in_protocol {
+    sub(/= file_open,/, "= file_policy_open,")
+    sub(/= file_read,/, "= file_policy_read,")
+    sub(/= file_write,/, "= file_policy_write,")
+    sub(/= file_seek,/, "= file_policy_seek,")
+    sub(/= file_close,/, "= file_policy_close,")
+}
+in_protocol && /^\};/ { in_protocol = 0 }
+
+{ print }
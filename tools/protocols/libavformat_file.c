@@ -182,3 +182,1227 @@ const URLProtocol ff_saf_protocol = {
     .priv_data_class     = &saf_class,
     .default_whitelist   = "saf,crypto,data"
 };
+
+typedef struct MemoryContext {
+    const AVClass *class;
+    int id;
+} MemoryContext;
+
+static int memory_open(URLContext *h, const char *filename, int flags)
+{
+    MemoryContext *c = h->priv_data;
+    memory_open_function custom_memory_open = av_get_memory_open();
+    char *final;
+    int ret;
+
+    av_strstart(filename, "memory:", &filename);
+
+    /* an extension may follow the id to help format detection */
+    c->id = strtol(filename, &final, 10);
+    if (filename == final || (*final && *final != '.'))
+        return AVERROR(EINVAL);
+
+    if (custom_memory_open == NULL || av_get_memory_read() == NULL ||
+        av_get_memory_write() == NULL || av_get_memory_seek() == NULL)
+        return AVERROR_PROTOCOL_NOT_FOUND;
+
+    ret = custom_memory_open(c->id, flags);
+    if (ret < 0)
+        return ret;
+
+    h->is_streamed = !ret;
+
+    /* Hand bigger blocks to the write callback, there is no kernel buffer to
+     * absorb small writes */
+    if (flags & AVIO_FLAG_WRITE)
+        h->min_packet_size = h->max_packet_size = 262144;
+
+    return 0;
+}
+
+static int memory_read(URLContext *h, unsigned char *buf, int size)
+{
+    MemoryContext *c = h->priv_data;
+    int ret = av_get_memory_read()(c->id, buf, size);
+
+    return ret == 0 ? AVERROR_EOF : ret;
+}
+
+static int memory_write(URLContext *h, const unsigned char *buf, int size)
+{
+    MemoryContext *c = h->priv_data;
+
+    return av_get_memory_write()(c->id, buf, size);
+}
+
+static int64_t memory_seek(URLContext *h, int64_t pos, int whence)
+{
+    MemoryContext *c = h->priv_data;
+
+    if (h->is_streamed)
+        return AVERROR(ESPIPE);
+
+    return av_get_memory_seek()(c->id, pos, whence);
+}
+
+static const AVClass memory_class = {
+    .class_name = "memory",
+    .item_name  = av_default_item_name,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+const URLProtocol ff_memory_protocol = {
+    .name                = "memory",
+    .url_open            = memory_open,
+    .url_read            = memory_read,
+    .url_write           = memory_write,
+    .url_seek            = memory_seek,
+    .priv_data_size      = sizeof(MemoryContext),
+    .priv_data_class     = &memory_class,
+    .default_whitelist   = "memory,crypto,data"
+};
+
+/* Android app processes run under a seccomp policy that kills them on
+ * io_uring_setup instead of failing it */
+#if defined(__linux__) && !defined(__ANDROID__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define URING_SUPPORTED 1
+#endif
+#endif
+
+#ifdef URING_SUPPORTED
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#include "libavutil/file_open.h"
+#include "libavutil/thread.h"
+#include "libavutil/time.h"
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#define URING_FOLLOW_SUPPORTED 1
+#endif
+
+#define URING_MAX_DEPTH 32
+
+/* alignment of O_DIRECT buffers, offsets and sizes */
+#define DIRECT_IO_ALIGN 4096
+
+/* granularity of page cache eviction behind the read or write position */
+#define PAGE_CACHE_WINDOW (8 << 20)
+
+// evict the data that was read behind pos
+static void page_cache_evict_read(int fd, int64_t pos, int64_t *evicted)
+{
+#ifdef POSIX_FADV_DONTNEED
+    if (pos - *evicted < PAGE_CACHE_WINDOW)
+        return;
+
+    posix_fadvise(fd, *evicted, pos - *evicted, POSIX_FADV_DONTNEED);
+    *evicted = pos;
+#endif
+}
+
+// start the writeback of a completed write and evict what was written back
+static void page_cache_evict_write(int fd, int64_t offset, int64_t size,
+                                   int64_t *written, int64_t *evicted)
+{
+#if defined(SYNC_FILE_RANGE_WRITE) && defined(POSIX_FADV_DONTNEED)
+    sync_file_range(fd, offset, size, SYNC_FILE_RANGE_WRITE);
+    *written = FFMAX(*written, offset + size);
+
+    /* keep one window in writeback, wait for the one before it */
+    while (*written - *evicted >= 2 * PAGE_CACHE_WINDOW) {
+        sync_file_range(fd, *evicted, PAGE_CACHE_WINDOW,
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                        SYNC_FILE_RANGE_WAIT_AFTER);
+        posix_fadvise(fd, *evicted, PAGE_CACHE_WINDOW, POSIX_FADV_DONTNEED);
+        *evicted += PAGE_CACHE_WINDOW;
+    }
+#endif
+}
+
+typedef struct UringBuffer {
+    uint8_t *alloc;
+    uint8_t *data;
+    struct iovec iov;
+    int64_t offset;
+    /* bytes transferred or negative AVERROR code, valid when done */
+    int result;
+    int busy;
+    int done;
+    /* number of bytes already returned to the reader */
+    int consumed;
+} UringBuffer;
+
+typedef struct UringContext {
+    const AVClass *class;
+    int fd;
+    int depth;
+    int block_size;
+    int fadvise;
+    int direct;
+    int follow;
+    int64_t follow_timeout;
+
+    /* -1 when the pread/pwrite fallback is used */
+    int ring_fd;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+#ifdef URING_SUPPORTED
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    struct io_uring_cqe *cqes;
+#endif
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+
+    UringBuffer buffers[URING_MAX_DEPTH];
+    /* index of the oldest submitted buffer and number of buffers in use */
+    int head;
+    int nb_used;
+    /* reader position and offset of the next read to submit */
+    int64_t pos;
+    int64_t next_offset;
+    int eof;
+    /* first error of a background write, returned by the next call */
+    int write_error;
+
+    /* set while O_DIRECT is enabled on fd */
+    int direct_active;
+    /* end of the range evicted from the page cache */
+    int64_t evicted;
+    /* end of the range handed to the kernel for writeback */
+    int64_t written;
+
+    /* inotify instance watching the file in follow mode, -1 otherwise */
+    int inotify_fd;
+    /* set once the writer closed the file */
+    int writer_closed;
+
+    /* held while the ring is used, other openers of the file wait for the
+     * background writes with it */
+    AVMutex lock;
+    /* identity of the file and next entry of uring_writers */
+    dev_t dev;
+    ino_t ino;
+    struct UringContext *next_writer;
+} UringContext;
+
+/* contexts writing through a ring. ffmpeg opens outputs again for reading
+ * after avio_flush(), e.g. for -movflags +faststart or digests, and must see
+ * the data of writes that are still in flight */
+static AVMutex uring_writers_lock = AV_MUTEX_INITIALIZER;
+static UringContext *uring_writers;
+
+#define URING_OFFSET(x) offsetof(UringContext, x)
+static const AVOption uring_options[] = {
+    { "uring_depth", "number of blocks kept in flight", URING_OFFSET(depth), AV_OPT_TYPE_INT, { .i64 = 4 }, 1, URING_MAX_DEPTH, AV_OPT_FLAG_ENCODING_PARAM | AV_OPT_FLAG_DECODING_PARAM },
+    { "uring_block_size", "size of each block in bytes", URING_OFFSET(block_size), AV_OPT_TYPE_INT, { .i64 = 262144 }, 4096, INT_MAX / 2, AV_OPT_FLAG_ENCODING_PARAM | AV_OPT_FLAG_DECODING_PARAM },
+    { "fadvise", "keep the file out of the page cache, evicting data behind the read or write position", URING_OFFSET(fadvise), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_ENCODING_PARAM | AV_OPT_FLAG_DECODING_PARAM },
+    { "direct", "write aligned blocks with O_DIRECT, bypassing the page cache", URING_OFFSET(direct), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_ENCODING_PARAM },
+    { "follow", "wait for data appended to a growing file instead of returning EOF", URING_OFFSET(follow), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_DECODING_PARAM },
+    { "follow_timeout", "time without appended data after which a followed file ends, 0 to wait until the writer closes it", URING_OFFSET(follow_timeout), AV_OPT_TYPE_DURATION, { .i64 = 0 }, 0, INT64_MAX, AV_OPT_FLAG_DECODING_PARAM },
+    { NULL }
+};
+
+#ifdef URING_SUPPORTED
+
+static int uring_setup(UringContext *c)
+{
+    struct io_uring_params p;
+    int single_mmap;
+
+    memset(&p, 0, sizeof(p));
+    c->ring_fd = syscall(__NR_io_uring_setup, c->depth, &p);
+    if (c->ring_fd < 0)
+        return AVERROR(errno);
+
+    single_mmap = p.features & IORING_FEAT_SINGLE_MMAP;
+    c->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    c->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (single_mmap)
+        c->sq_ring_size = c->cq_ring_size = FFMAX(c->sq_ring_size, c->cq_ring_size);
+
+    c->sq_ring = mmap(NULL, c->sq_ring_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, c->ring_fd, IORING_OFF_SQ_RING);
+    if (c->sq_ring == MAP_FAILED) {
+        c->sq_ring = NULL;
+        return AVERROR(errno);
+    }
+
+    if (single_mmap) {
+        c->cq_ring = c->sq_ring;
+    } else {
+        c->cq_ring = mmap(NULL, c->cq_ring_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, c->ring_fd, IORING_OFF_CQ_RING);
+        if (c->cq_ring == MAP_FAILED) {
+            c->cq_ring = NULL;
+            return AVERROR(errno);
+        }
+    }
+
+    c->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    c->sqes = mmap(NULL, c->sqes_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, c->ring_fd, IORING_OFF_SQES);
+    if (c->sqes == MAP_FAILED) {
+        c->sqes = NULL;
+        return AVERROR(errno);
+    }
+
+    c->sq_head  = (unsigned *)((uint8_t *)c->sq_ring + p.sq_off.head);
+    c->sq_tail  = (unsigned *)((uint8_t *)c->sq_ring + p.sq_off.tail);
+    c->sq_mask  = (unsigned *)((uint8_t *)c->sq_ring + p.sq_off.ring_mask);
+    c->sq_array = (unsigned *)((uint8_t *)c->sq_ring + p.sq_off.array);
+    c->cq_head  = (unsigned *)((uint8_t *)c->cq_ring + p.cq_off.head);
+    c->cq_tail  = (unsigned *)((uint8_t *)c->cq_ring + p.cq_off.tail);
+    c->cq_mask  = (unsigned *)((uint8_t *)c->cq_ring + p.cq_off.ring_mask);
+    c->cqes     = (struct io_uring_cqe *)((uint8_t *)c->cq_ring + p.cq_off.cqes);
+
+    return 0;
+}
+
+static void uring_teardown(UringContext *c)
+{
+    if (c->sqes)
+        munmap(c->sqes, c->sqes_size);
+    if (c->cq_ring && c->cq_ring != c->sq_ring)
+        munmap(c->cq_ring, c->cq_ring_size);
+    if (c->sq_ring)
+        munmap(c->sq_ring, c->sq_ring_size);
+    if (c->ring_fd >= 0)
+        close(c->ring_fd);
+    c->sqes = NULL;
+    c->sq_ring = c->cq_ring = NULL;
+    c->ring_fd = -1;
+}
+
+static int uring_enter(UringContext *c, unsigned to_submit, unsigned min_complete)
+{
+    int ret;
+
+    do {
+        ret = syscall(__NR_io_uring_enter, c->ring_fd, to_submit, min_complete,
+                      min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while (ret < 0 && errno == EINTR);
+
+    return ret < 0 ? AVERROR(errno) : 0;
+}
+
+static int uring_submit(UringContext *c, int index, int write)
+{
+    UringBuffer *b = &c->buffers[index];
+    unsigned tail = *c->sq_tail;
+    unsigned idx = tail & *c->sq_mask;
+    struct io_uring_sqe *sqe = &c->sqes[idx];
+    int ret;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd        = c->fd;
+    sqe->off       = b->offset;
+    sqe->addr      = (uintptr_t)&b->iov;
+    sqe->len       = 1;
+    sqe->user_data = index;
+    c->sq_array[idx] = idx;
+
+    b->busy = 1;
+    b->done = 0;
+    b->consumed = 0;
+
+    __atomic_store_n(c->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    ret = uring_enter(c, 1, 0);
+
+    /* an entry the kernel did not take would be submitted by the next call,
+     * for a buffer that is reused by then */
+    if (__atomic_load_n(c->sq_head, __ATOMIC_ACQUIRE) == tail) {
+        __atomic_store_n(c->sq_tail, tail, __ATOMIC_RELEASE);
+        b->busy = 0;
+        return ret < 0 ? ret : AVERROR(EAGAIN);
+    }
+
+    /* once taken, the result of the entry arrives as a completion */
+    return 0;
+}
+
+// wait for the completion of the given buffer, reaping the others on the way
+static int uring_wait(UringContext *c, int index)
+{
+    while (!c->buffers[index].done) {
+        unsigned head = *c->cq_head;
+        int ret;
+
+        if (head == __atomic_load_n(c->cq_tail, __ATOMIC_ACQUIRE)) {
+            ret = uring_enter(c, 0, 1);
+            if (ret < 0)
+                return ret;
+            continue;
+        }
+
+        {
+            struct io_uring_cqe *cqe = &c->cqes[head & *c->cq_mask];
+            UringBuffer *b = &c->buffers[cqe->user_data];
+
+            b->result = cqe->res < 0 ? AVERROR(-cqe->res) : cqe->res;
+            b->done = 1;
+        }
+
+        __atomic_store_n(c->cq_head, head + 1, __ATOMIC_RELEASE);
+    }
+
+    return 0;
+}
+
+// wait for all the submitted buffers and forget about the ones not consumed
+static int uring_drain(UringContext *c)
+{
+    int ret = 0;
+
+    for (int i = 0; i < c->nb_used; i++) {
+        int index = (c->head + i) % c->depth;
+        int err = uring_wait(c, index);
+        if (err < 0)
+            return err;
+        if (c->buffers[index].result < 0 && !ret)
+            ret = c->buffers[index].result;
+        c->buffers[index].busy = 0;
+    }
+
+    c->head = 0;
+    c->nb_used = 0;
+
+    return ret;
+}
+
+#else
+
+static int uring_setup(UringContext *c)
+{
+    return AVERROR(ENOSYS);
+}
+
+static void uring_teardown(UringContext *c)
+{
+}
+
+static int uring_submit(UringContext *c, int index, int write)
+{
+    return AVERROR(ENOSYS);
+}
+
+static int uring_wait(UringContext *c, int index)
+{
+    return AVERROR(ENOSYS);
+}
+
+static int uring_drain(UringContext *c)
+{
+    return 0;
+}
+
+#endif
+
+static void uring_evict_read(UringContext *c)
+{
+    if (c->fadvise)
+        page_cache_evict_read(c->fd, c->pos, &c->evicted);
+}
+
+static void uring_evict_write(UringContext *c, int64_t offset, int64_t size)
+{
+    if (c->fadvise && !c->direct_active)
+        page_cache_evict_write(c->fd, offset, size, &c->written, &c->evicted);
+}
+
+// turn O_DIRECT off for an unaligned write at offset
+static int uring_direct_disable(UringContext *c, int64_t offset)
+{
+#ifdef O_DIRECT
+    if (!c->direct_active)
+        return 0;
+
+    /* the writes in flight were queued as direct I/O, clearing the flag under
+     * them would mix direct and buffered I/O on the same pages */
+    for (int i = 0; i < c->nb_used; i++) {
+        int ret = uring_wait(c, (c->head + i) % c->depth);
+        if (ret < 0)
+            return ret;
+    }
+
+    fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) & ~O_DIRECT);
+    c->direct_active = 0;
+    av_log(c, AV_LOG_DEBUG, "Unaligned write at %"PRId64", O_DIRECT disabled\n",
+           offset);
+#endif
+    return 0;
+}
+
+// check the result of a completed write, finishing short ones synchronously
+static int uring_write_complete(UringContext *c, UringBuffer *b)
+{
+    /* the kernel completes regular file writes fully unless an error
+     * occurs */
+    if (b->result >= 0 && b->result < b->iov.iov_len) {
+        size_t left = b->iov.iov_len - b->result;
+        /* the remainder is not aligned anymore */
+        int ret = uring_direct_disable(c, b->offset + b->result);
+
+        if (ret < 0)
+            return ret;
+        if (pwrite(c->fd, b->data + b->result, left,
+                   b->offset + b->result) != left)
+            b->result = AVERROR(EIO);
+    }
+    if (b->result < 0)
+        return b->result;
+
+    uring_evict_write(c, b->offset, b->iov.iov_len);
+
+    return 0;
+}
+
+// wait for all the background writes, finishing the short ones
+static int uring_flush_writes(UringContext *c)
+{
+    while (c->nb_used) {
+        UringBuffer *b = &c->buffers[c->head];
+        int ret = uring_wait(c, c->head);
+
+        /* the ring is unusable, the data of the buffer can not be released */
+        if (ret < 0)
+            return c->write_error = ret;
+
+        ret = uring_write_complete(c, b);
+        if (ret < 0 && !c->write_error)
+            c->write_error = ret;
+
+        b->busy = 0;
+        c->head = (c->head + 1) % c->depth;
+        c->nb_used--;
+    }
+
+    return c->write_error;
+}
+
+// wait for the background writes of other contexts to the file of st
+static void uring_wait_writers(const struct stat *st)
+{
+    ff_mutex_lock(&uring_writers_lock);
+    for (UringContext *w = uring_writers; w; w = w->next_writer) {
+        if (w->dev != st->st_dev || w->ino != st->st_ino)
+            continue;
+        ff_mutex_lock(&w->lock);
+        uring_flush_writes(w);
+        ff_mutex_unlock(&w->lock);
+    }
+    ff_mutex_unlock(&uring_writers_lock);
+}
+
+static void uring_remove_writer(UringContext *c)
+{
+    ff_mutex_lock(&uring_writers_lock);
+    for (UringContext **w = &uring_writers; *w; w = &(*w)->next_writer) {
+        if (*w == c) {
+            *w = c->next_writer;
+            break;
+        }
+    }
+    ff_mutex_unlock(&uring_writers_lock);
+}
+
+// block until the followed file is modified; returns AVERROR_EOF once the
+// writer closed it or nothing was appended for follow_timeout
+static int uring_follow_wait(URLContext *h, UringContext *c)
+{
+#ifdef URING_FOLLOW_SUPPORTED
+    int64_t idle_start = av_gettime_relative();
+
+    /* data written before the close may not have been read yet */
+    if (c->writer_closed)
+        return AVERROR_EOF;
+
+    while (1) {
+        struct pollfd pfd = { .fd = c->inotify_fd, .events = POLLIN };
+        /* wake up regularly to honour the interrupt callback */
+        int ret = poll(&pfd, 1, 100);
+
+        if (ret < 0 && errno != EINTR)
+            return AVERROR(errno);
+
+        if (ret > 0) {
+            char events[4096]
+                __attribute__((aligned(__alignof__(struct inotify_event))));
+            ssize_t len = read(c->inotify_fd, events, sizeof(events));
+            int modified = 0;
+
+            for (char *ptr = events; len > 0 && ptr < events + len;
+                 ptr += sizeof(struct inotify_event) +
+                        ((struct inotify_event *)ptr)->len) {
+                const struct inotify_event *event = (struct inotify_event *)ptr;
+
+                if (event->mask & IN_CLOSE_WRITE)
+                    c->writer_closed = 1;
+                if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+                    modified = 1;
+            }
+
+            if (modified)
+                return 0;
+        }
+
+        if (ff_check_interrupt(&h->interrupt_callback))
+            return AVERROR_EXIT;
+
+        if (c->follow_timeout &&
+            av_gettime_relative() - idle_start >= c->follow_timeout) {
+            av_log(h, AV_LOG_VERBOSE, "No data appended for %"PRId64"ms, "
+                   "ending the followed file\n", c->follow_timeout / 1000);
+            return AVERROR_EOF;
+        }
+    }
+#else
+    return AVERROR_EOF;
+#endif
+}
+
+static int uring_close(URLContext *h);
+
+static int uring_open(URLContext *h, const char *filename, int flags)
+{
+    UringContext *c = h->priv_data;
+    struct stat st;
+    int access;
+    int ret;
+
+    av_strstart(filename, "uring:", &filename);
+
+    c->ring_fd = -1;
+    c->inotify_fd = -1;
+
+    if (flags & AVIO_FLAG_WRITE && flags & AVIO_FLAG_READ) {
+        access = O_CREAT | O_RDWR;
+    } else if (flags & AVIO_FLAG_WRITE) {
+        access = O_CREAT | O_WRONLY | O_TRUNC;
+    } else {
+        access = O_RDONLY;
+    }
+#ifdef O_BINARY
+    access |= O_BINARY;
+#endif
+    c->fd = avpriv_open(filename, access, 0666);
+    if (c->fd == -1)
+        return AVERROR(errno);
+
+    ff_mutex_init(&c->lock, NULL);
+
+    if (fstat(c->fd, &st) < 0) {
+        ret = AVERROR(errno);
+        uring_close(h);
+        return ret;
+    }
+    h->is_streamed = S_ISFIFO(st.st_mode);
+
+    /* read what is still being written to the file by another context */
+    uring_wait_writers(&st);
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (c->fadvise && !h->is_streamed && !(flags & AVIO_FLAG_WRITE))
+        posix_fadvise(c->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    if (c->follow && !h->is_streamed && !(flags & AVIO_FLAG_WRITE)) {
+#ifdef URING_FOLLOW_SUPPORTED
+        c->inotify_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (c->inotify_fd < 0 ||
+            inotify_add_watch(c->inotify_fd, filename,
+                              IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+            ret = AVERROR(errno);
+            av_log(h, AV_LOG_ERROR, "Cannot watch %s: %s\n", filename,
+                   av_err2str(ret));
+            uring_close(h);
+            return ret;
+        }
+#else
+        av_log(h, AV_LOG_ERROR, "follow is not supported on this platform\n");
+        uring_close(h);
+        return AVERROR(ENOSYS);
+#endif
+        /* reads past the current end are waited for, not read ahead */
+        return 0;
+    }
+
+    /* rings are only used for one direction at a time on regular files, the
+     * rest goes through plain read and write calls */
+    if (h->is_streamed || (flags & AVIO_FLAG_READ_WRITE) == AVIO_FLAG_READ_WRITE)
+        return 0;
+
+    ret = uring_setup(c);
+    if (ret < 0) {
+        av_log(h, AV_LOG_VERBOSE, "io_uring is not available (%s), "
+               "using synchronous I/O\n", av_err2str(ret));
+        uring_teardown(c);
+        return 0;
+    }
+
+#ifdef O_DIRECT
+    /* O_DIRECT needs aligned buffers, so it is only used with the ring */
+    if (c->direct && flags & AVIO_FLAG_WRITE) {
+        c->block_size = FFALIGN(c->block_size, DIRECT_IO_ALIGN);
+        if (fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_DIRECT) < 0)
+            av_log(h, AV_LOG_VERBOSE, "O_DIRECT is not supported (%s)\n",
+                   av_err2str(AVERROR(errno)));
+        else
+            c->direct_active = 1;
+    }
+#endif
+
+    for (int i = 0; i < c->depth; i++) {
+        UringBuffer *b = &c->buffers[i];
+
+        b->alloc = av_malloc(c->block_size + DIRECT_IO_ALIGN - 1);
+        if (!b->alloc) {
+            uring_close(h);
+            return AVERROR(ENOMEM);
+        }
+        b->data = (uint8_t *)FFALIGN((uintptr_t)b->alloc, DIRECT_IO_ALIGN);
+    }
+
+    if (flags & AVIO_FLAG_WRITE) {
+        h->min_packet_size = h->max_packet_size = c->block_size;
+
+        c->dev = st.st_dev;
+        c->ino = st.st_ino;
+        ff_mutex_lock(&uring_writers_lock);
+        c->next_writer = uring_writers;
+        uring_writers = c;
+        ff_mutex_unlock(&uring_writers_lock);
+    }
+
+    return 0;
+}
+
+static int uring_read(URLContext *h, unsigned char *buf, int size)
+{
+    UringContext *c = h->priv_data;
+    UringBuffer *b;
+    int ret;
+
+    if (c->ring_fd < 0) {
+        ret = read(c->fd, buf, size);
+        while (ret == 0 && c->inotify_fd >= 0) {
+            ret = uring_follow_wait(h, c);
+            if (ret < 0)
+                return ret;
+            ret = read(c->fd, buf, size);
+        }
+        if (ret == 0)
+            return AVERROR_EOF;
+        if (ret < 0)
+            return AVERROR(errno);
+        c->pos += ret;
+        uring_evict_read(c);
+        return ret;
+    }
+
+    /* keep the read-ahead window full */
+    while (!c->eof && c->nb_used < c->depth) {
+        int index = (c->head + c->nb_used) % c->depth;
+
+        b = &c->buffers[index];
+        b->offset = c->next_offset;
+        b->iov.iov_base = b->data;
+        b->iov.iov_len = c->block_size;
+        ret = uring_submit(c, index, 0);
+        if (ret < 0)
+            return ret;
+
+        c->nb_used++;
+        c->next_offset += c->block_size;
+    }
+
+    if (!c->nb_used)
+        return AVERROR_EOF;
+
+    b = &c->buffers[c->head];
+    ret = uring_wait(c, c->head);
+    if (ret < 0)
+        return ret;
+    if (b->result < 0)
+        return b->result;
+
+    if (b->result == 0) {
+        /* nothing was read past this block either */
+        c->eof = 1;
+        uring_drain(c);
+        return AVERROR_EOF;
+    }
+
+    size = FFMIN(size, b->result - b->consumed);
+    memcpy(buf, b->data + b->consumed, size);
+    b->consumed += size;
+    c->pos += size;
+    uring_evict_read(c);
+
+    if (b->consumed == b->result) {
+        b->busy = 0;
+        c->head = (c->head + 1) % c->depth;
+        c->nb_used--;
+
+        /* a short read means the end of the file or a concurrent truncate,
+         * what follows must be read again from the current position */
+        if (b->result < c->block_size) {
+            ret = uring_drain(c);
+            c->next_offset = c->pos;
+            if (ret < 0)
+                return ret;
+        }
+    }
+
+    return size;
+}
+
+static int uring_write_ring(UringContext *c, const unsigned char *buf,
+                            int size)
+{
+    UringBuffer *b;
+    int index;
+    int ret;
+
+    if (c->write_error)
+        return c->write_error;
+
+    /* reuse the oldest buffer once all of them are in flight */
+    if (c->nb_used == c->depth) {
+        UringBuffer *oldest = &c->buffers[c->head];
+
+        ret = uring_wait(c, c->head);
+        if (ret < 0)
+            return ret;
+
+        ret = uring_write_complete(c, oldest);
+        if (ret < 0)
+            return c->write_error = ret;
+
+        oldest->busy = 0;
+        c->head = (c->head + 1) % c->depth;
+        c->nb_used--;
+    }
+
+    size = FFMIN(size, c->block_size);
+    if (c->pos % DIRECT_IO_ALIGN || size % DIRECT_IO_ALIGN) {
+        ret = uring_direct_disable(c, c->pos);
+        if (ret < 0)
+            return ret;
+    }
+
+    index = (c->head + c->nb_used) % c->depth;
+    b = &c->buffers[index];
+    memcpy(b->data, buf, size);
+    b->offset = c->pos;
+    b->iov.iov_base = b->data;
+    b->iov.iov_len = size;
+
+    ret = uring_submit(c, index, 1);
+    if (ret < 0)
+        return ret;
+
+    c->nb_used++;
+    c->pos += size;
+
+    /* AVIOContext hands over full blocks, a shorter one comes from
+     * avio_flush() and is expected in the file when the call returns */
+    if (size < c->block_size) {
+        ret = uring_flush_writes(c);
+        if (ret < 0)
+            return ret;
+    }
+
+    return size;
+}
+
+static int uring_write(URLContext *h, const unsigned char *buf, int size)
+{
+    UringContext *c = h->priv_data;
+    int ret;
+
+    if (c->ring_fd < 0) {
+        ret = write(c->fd, buf, size);
+        if (ret < 0)
+            return AVERROR(errno);
+        uring_evict_write(c, c->pos, ret);
+        c->pos += ret;
+        return ret;
+    }
+
+    ff_mutex_lock(&c->lock);
+    ret = uring_write_ring(c, buf, size);
+    ff_mutex_unlock(&c->lock);
+
+    return ret;
+}
+
+static int64_t uring_seek(URLContext *h, int64_t pos, int whence)
+{
+    UringContext *c = h->priv_data;
+    int64_t ret;
+
+    if (whence == AVSEEK_SIZE) {
+        struct stat st;
+        ret = fstat(c->fd, &st);
+        if (ret < 0)
+            return AVERROR(errno);
+        /* pending writes may extend the file */
+        return FFMAX(st.st_size, c->ring_fd >= 0 ? c->pos : 0);
+    }
+
+    if (c->ring_fd < 0) {
+        ret = lseek(c->fd, pos, whence);
+        if (ret < 0)
+            return AVERROR(errno);
+        c->pos = ret;
+        c->evicted = FFMIN(c->evicted, c->pos);
+        return ret;
+    }
+
+    if (whence == SEEK_CUR)
+        pos += c->pos;
+    else if (whence == SEEK_END) {
+        struct stat st;
+        if (fstat(c->fd, &st) < 0)
+            return AVERROR(errno);
+        pos += FFMAX(st.st_size, c->pos);
+    } else if (whence != SEEK_SET)
+        return AVERROR(EINVAL);
+    if (pos < 0)
+        return AVERROR(EINVAL);
+
+    /* a write after the seek may overlap one in flight, and the ring does not
+     * order them */
+    if (h->flags & AVIO_FLAG_WRITE) {
+        ff_mutex_lock(&c->lock);
+        ret = uring_flush_writes(c);
+        ff_mutex_unlock(&c->lock);
+        if (ret < 0)
+            return ret;
+    } else {
+        ret = uring_drain(c);
+        if (ret < 0 && ret != AVERROR_EOF)
+            av_log(h, AV_LOG_DEBUG, "Discarded read-ahead failed: %s\n",
+                   av_err2str(ret));
+        c->next_offset = pos;
+        c->eof = 0;
+        c->evicted = FFMIN(c->evicted, pos);
+    }
+
+    c->pos = pos;
+
+    return pos;
+}
+
+static int uring_close(URLContext *h)
+{
+    UringContext *c = h->priv_data;
+    int ret = 0;
+
+    uring_remove_writer(c);
+
+    if (c->ring_fd >= 0 && h->flags & AVIO_FLAG_WRITE)
+        ret = uring_flush_writes(c);
+    else if (c->ring_fd >= 0)
+        uring_drain(c);
+
+    uring_teardown(c);
+    ff_mutex_destroy(&c->lock);
+
+    if (c->inotify_fd >= 0)
+        close(c->inotify_fd);
+
+    for (int i = 0; i < URING_MAX_DEPTH; i++) {
+        av_freep(&c->buffers[i].alloc);
+        c->buffers[i].data = NULL;
+    }
+
+    if (close(c->fd) < 0 && !ret)
+        ret = AVERROR(errno);
+
+    return ret;
+}
+
+static int uring_get_handle(URLContext *h)
+{
+    return ((UringContext *)h->priv_data)->fd;
+}
+
+static const AVClass uring_class = {
+    .class_name = "uring",
+    .item_name  = av_default_item_name,
+    .option     = uring_options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+const URLProtocol ff_uring_protocol = {
+    .name                = "uring",
+    .url_open            = uring_open,
+    .url_read            = uring_read,
+    .url_write           = uring_write,
+    .url_seek            = uring_seek,
+    .url_close           = uring_close,
+    .url_get_file_handle = uring_get_handle,
+    .priv_data_size      = sizeof(UringContext),
+    .priv_data_class     = &uring_class,
+    .default_whitelist   = "uring,crypto,data"
+};
+
+#if CONFIG_FILE_PROTOCOL
+
+/* page cache state of a file: context with the file_fadvise or file_direct
+ * option, which libavformat_file.awk adds to the upstream protocol */
+typedef struct FilePolicy {
+    /* aligned copy of the data written with O_DIRECT */
+    uint8_t *direct_alloc;
+    uint8_t *direct_buffer;
+    int direct_size;
+    int direct_active;
+    int64_t pos;
+    int64_t evicted;
+    int64_t written;
+} FilePolicy;
+
+static int file_policy_open(URLContext *h, const char *filename, int flags)
+{
+    FileContext *c = h->priv_data;
+    FilePolicy *p;
+    int ret = file_open(h, filename, flags);
+
+    if (ret < 0 || h->is_streamed || !(c->fadvise || c->direct))
+        return ret;
+
+    p = c->policy = av_mallocz(sizeof(*p));
+    if (!p) {
+        file_close(h);
+        return AVERROR(ENOMEM);
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (c->fadvise && !(flags & AVIO_FLAG_WRITE))
+        posix_fadvise(c->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+#ifdef O_DIRECT
+    /* writes come in max_packet_size blocks, copied to an aligned buffer */
+    if (c->direct && (flags & AVIO_FLAG_READ_WRITE) == AVIO_FLAG_WRITE &&
+        h->max_packet_size) {
+        p->direct_size = FFALIGN(h->max_packet_size, DIRECT_IO_ALIGN);
+        p->direct_alloc = av_malloc(p->direct_size + DIRECT_IO_ALIGN - 1);
+        if (!p->direct_alloc) {
+            av_freep(&c->policy);
+            file_close(h);
+            return AVERROR(ENOMEM);
+        }
+        p->direct_buffer = (uint8_t *)FFALIGN((uintptr_t)p->direct_alloc,
+                                              DIRECT_IO_ALIGN);
+
+        if (fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_DIRECT) < 0)
+            av_log(h, AV_LOG_VERBOSE, "O_DIRECT is not supported (%s)\n",
+                   av_err2str(AVERROR(errno)));
+        else
+            p->direct_active = 1;
+    }
+#endif
+
+    return 0;
+}
+
+static int file_policy_read(URLContext *h, unsigned char *buf, int size)
+{
+    FileContext *c = h->priv_data;
+    FilePolicy *p = c->policy;
+    int ret = file_read(h, buf, size);
+
+    if (p && ret > 0) {
+        p->pos += ret;
+        if (c->fadvise)
+            page_cache_evict_read(c->fd, p->pos, &p->evicted);
+    }
+
+    return ret;
+}
+
+static int file_policy_write(URLContext *h, const unsigned char *buf, int size)
+{
+    FileContext *c = h->priv_data;
+    FilePolicy *p = c->policy;
+    int ret;
+
+    if (!p)
+        return file_write(h, buf, size);
+
+#ifdef O_DIRECT
+    if (p->direct_active) {
+        if (p->pos % DIRECT_IO_ALIGN || size % DIRECT_IO_ALIGN) {
+            /* writes are synchronous, none is in flight with O_DIRECT */
+            fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) & ~O_DIRECT);
+            p->direct_active = 0;
+            av_log(h, AV_LOG_DEBUG, "Unaligned write at %"PRId64", "
+                   "O_DIRECT disabled\n", p->pos);
+        } else {
+            size = FFMIN(size, p->direct_size);
+            memcpy(p->direct_buffer, buf, size);
+            buf = p->direct_buffer;
+        }
+    }
+#endif
+
+    ret = file_write(h, buf, size);
+    if (ret > 0) {
+        if (c->fadvise && !p->direct_active)
+            page_cache_evict_write(c->fd, p->pos, ret, &p->written,
+                                   &p->evicted);
+        p->pos += ret;
+    }
+
+    return ret;
+}
+
+static int64_t file_policy_seek(URLContext *h, int64_t pos, int whence)
+{
+    FileContext *c = h->priv_data;
+    FilePolicy *p = c->policy;
+    int64_t ret = file_seek(h, pos, whence);
+
+    if (p && ret >= 0 && whence != AVSEEK_SIZE) {
+        p->pos = ret;
+        p->evicted = FFMIN(p->evicted, ret);
+    }
+
+    return ret;
+}
+
+static int file_policy_close(URLContext *h)
+{
+    FileContext *c = h->priv_data;
+
+    if (c->policy) {
+        av_freep(&c->policy->direct_alloc);
+        av_freep(&c->policy);
+    }
+
+    return file_close(h);
+}
+
+#endif /* CONFIG_FILE_PROTOCOL */
+
+typedef struct BlockCacheContext {
+    const AVClass *class;
+    int fd;
+    struct stat st;
+    int64_t pos;
+} BlockCacheContext;
+
+static int blockcache_open(URLContext *h, const char *filename, int flags)
+{
+    BlockCacheContext *c = h->priv_data;
+    int access = O_RDONLY;
+
+    av_strstart(filename, "blockcache:", &filename);
+
+    if (flags & AVIO_FLAG_WRITE)
+        return AVERROR(ENOSYS);
+
+#ifdef O_BINARY
+    access |= O_BINARY;
+#endif
+    c->fd = avpriv_open(filename, access, 0666);
+    if (c->fd == -1)
+        return AVERROR(errno);
+
+    /* the identity of the file version is taken once, at open */
+    if (fstat(c->fd, &c->st) < 0 || !S_ISREG(c->st.st_mode)) {
+        av_log(h, AV_LOG_ERROR, "%s is not a regular file\n", filename);
+        close(c->fd);
+        return AVERROR(EINVAL);
+    }
+
+    return 0;
+}
+
+static int blockcache_read(URLContext *h, unsigned char *buf, int size)
+{
+    BlockCacheContext *c = h->priv_data;
+    int64_t mtime = c->st.st_mtim.tv_sec * INT64_C(1000000000) +
+                    c->st.st_mtim.tv_nsec;
+    int ret;
+
+    ret = av_blockcache_read(c->fd, c->st.st_dev, c->st.st_ino, mtime,
+                             c->st.st_size, c->pos, buf, size);
+    if (ret == 0)
+        return AVERROR_EOF;
+    if (ret > 0)
+        c->pos += ret;
+
+    return ret;
+}
+
+static int64_t blockcache_seek(URLContext *h, int64_t pos, int whence)
+{
+    BlockCacheContext *c = h->priv_data;
+
+    switch (whence) {
+    case AVSEEK_SIZE:
+        return c->st.st_size;
+    case SEEK_CUR:
+        pos += c->pos;
+        break;
+    case SEEK_END:
+        pos += c->st.st_size;
+        break;
+    case SEEK_SET:
+        break;
+    default:
+        return AVERROR(EINVAL);
+    }
+
+    if (pos < 0)
+        return AVERROR(EINVAL);
+
+    c->pos = pos;
+
+    return pos;
+}
+
+static int blockcache_close(URLContext *h)
+{
+    BlockCacheContext *c = h->priv_data;
+
+    return close(c->fd) < 0 ? AVERROR(errno) : 0;
+}
+
+static int blockcache_get_handle(URLContext *h)
+{
+    return ((BlockCacheContext *)h->priv_data)->fd;
+}
+
+static const AVClass blockcache_class = {
+    .class_name = "blockcache",
+    .item_name  = av_default_item_name,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+const URLProtocol ff_blockcache_protocol = {
+    .name                = "blockcache",
+    .url_open            = blockcache_open,
+    .url_read            = blockcache_read,
+    .url_seek            = blockcache_seek,
+    .url_close           = blockcache_close,
+    .url_get_file_handle = blockcache_get_handle,
+    .priv_data_size      = sizeof(BlockCacheContext),
+    .priv_data_class     = &blockcache_class,
+    .default_whitelist   = "blockcache,crypto,data"
+};
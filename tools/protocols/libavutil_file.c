@@ -19,6 +19,10 @@
 
 static saf_open_function _saf_open_function = NULL;
 static saf_close_function _saf_close_function = NULL;
+static memory_open_function _memory_open_function = NULL;
+static memory_read_function _memory_read_function = NULL;
+static memory_write_function _memory_write_function = NULL;
+static memory_seek_function _memory_seek_function = NULL;
 
 saf_open_function av_get_saf_open() {
     return _saf_open_function;
@@ -35,3 +39,262 @@ void av_set_saf_open(saf_open_function open_function) {
 void av_set_saf_close(saf_close_function close_function) {
     _saf_close_function = close_function;
 }
+
+memory_open_function av_get_memory_open() {
+    return _memory_open_function;
+}
+
+memory_read_function av_get_memory_read() {
+    return _memory_read_function;
+}
+
+memory_write_function av_get_memory_write() {
+    return _memory_write_function;
+}
+
+memory_seek_function av_get_memory_seek() {
+    return _memory_seek_function;
+}
+
+void av_set_memory_open(memory_open_function open_function) {
+    _memory_open_function = open_function;
+}
+
+void av_set_memory_read(memory_read_function read_function) {
+    _memory_read_function = read_function;
+}
+
+void av_set_memory_write(memory_write_function write_function) {
+    _memory_write_function = write_function;
+}
+
+void av_set_memory_seek(memory_seek_function seek_function) {
+    _memory_seek_function = seek_function;
+}
+
+#include <pthread.h>
+
+#define BLOCKCACHE_BLOCK_SIZE (64 * 1024)
+#define BLOCKCACHE_BUCKETS 4096
+
+typedef struct BlockCacheEntry {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t mtime;
+    int64_t file_size;
+    int64_t index;
+
+    uint8_t *data;
+    /* number of valid bytes, negative AVERROR code if loading failed */
+    int size;
+    /* set while a reader loads the block, other readers wait for it */
+    int loading;
+
+    struct BlockCacheEntry *hash_next;
+    struct BlockCacheEntry *lru_prev;
+    struct BlockCacheEntry *lru_next;
+} BlockCacheEntry;
+
+static pthread_mutex_t _blockcache_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _blockcache_cond = PTHREAD_COND_INITIALIZER;
+static BlockCacheEntry *_blockcache_buckets[BLOCKCACHE_BUCKETS];
+/* most recently used first */
+static BlockCacheEntry *_blockcache_lru_head = NULL;
+static BlockCacheEntry *_blockcache_lru_tail = NULL;
+static int64_t _blockcache_size = 0;
+static int64_t _blockcache_max_size = 128 * 1024 * 1024;
+static int64_t _blockcache_hits = 0;
+static int64_t _blockcache_misses = 0;
+static int64_t _blockcache_evictions = 0;
+
+static unsigned blockcache_hash(uint64_t dev, uint64_t ino, int64_t index) {
+    uint64_t h = (dev * 0x9E3779B97F4A7C15ULL) ^ (ino * 0xC2B2AE3D27D4EB4FULL) ^
+                 ((uint64_t)index * 0x165667B19E3779F9ULL);
+    return (h ^ (h >> 32)) % BLOCKCACHE_BUCKETS;
+}
+
+static void blockcache_lru_unlink(BlockCacheEntry *e) {
+    if (e->lru_prev)
+        e->lru_prev->lru_next = e->lru_next;
+    else
+        _blockcache_lru_head = e->lru_next;
+    if (e->lru_next)
+        e->lru_next->lru_prev = e->lru_prev;
+    else
+        _blockcache_lru_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = NULL;
+}
+
+static void blockcache_lru_push(BlockCacheEntry *e) {
+    e->lru_next = _blockcache_lru_head;
+    if (_blockcache_lru_head)
+        _blockcache_lru_head->lru_prev = e;
+    _blockcache_lru_head = e;
+    if (!_blockcache_lru_tail)
+        _blockcache_lru_tail = e;
+}
+
+static void blockcache_remove(BlockCacheEntry *e) {
+    BlockCacheEntry **p = &_blockcache_buckets[blockcache_hash(e->dev, e->ino,
+                                                               e->index)];
+
+    while (*p != e)
+        p = &(*p)->hash_next;
+    *p = e->hash_next;
+
+    blockcache_lru_unlink(e);
+    _blockcache_size -= BLOCKCACHE_BLOCK_SIZE;
+    av_free(e->data);
+    av_free(e);
+}
+
+// evict least recently used blocks until the cache fits in its limit,
+// blocks being loaded are skipped
+static void blockcache_trim(void) {
+    BlockCacheEntry *e = _blockcache_lru_tail;
+
+    while (e && _blockcache_size > _blockcache_max_size) {
+        BlockCacheEntry *prev = e->lru_prev;
+        if (!e->loading) {
+            blockcache_remove(e);
+            _blockcache_evictions++;
+        }
+        e = prev;
+    }
+}
+
+static BlockCacheEntry *blockcache_find(uint64_t dev, uint64_t ino,
+                                        int64_t mtime, int64_t file_size,
+                                        int64_t index) {
+    BlockCacheEntry *e =
+        _blockcache_buckets[blockcache_hash(dev, ino, index)];
+
+    for (; e; e = e->hash_next)
+        if (e->dev == dev && e->ino == ino && e->index == index &&
+            e->mtime == mtime && e->file_size == file_size)
+            return e;
+
+    return NULL;
+}
+
+static int blockcache_load(int fd, BlockCacheEntry *e) {
+    int64_t offset = e->index * BLOCKCACHE_BLOCK_SIZE;
+    int size = 0;
+
+    while (size < BLOCKCACHE_BLOCK_SIZE) {
+        ssize_t ret = pread(fd, e->data + size, BLOCKCACHE_BLOCK_SIZE - size,
+                            offset + size);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret < 0)
+            return AVERROR(errno);
+        if (ret == 0)
+            break;
+        size += ret;
+    }
+
+    return size;
+}
+
+int av_blockcache_read(int fd, uint64_t dev, uint64_t ino, int64_t mtime,
+                       int64_t file_size, int64_t offset, uint8_t *buf,
+                       int size) {
+    int64_t index = offset / BLOCKCACHE_BLOCK_SIZE;
+    int block_offset = offset % BLOCKCACHE_BLOCK_SIZE;
+    BlockCacheEntry *e;
+    int ret;
+
+    if (offset >= file_size)
+        return 0;
+
+    pthread_mutex_lock(&_blockcache_lock);
+
+    if (!_blockcache_max_size) {
+        pthread_mutex_unlock(&_blockcache_lock);
+        ret = pread(fd, buf, size, offset);
+        return ret < 0 ? AVERROR(errno) : ret;
+    }
+
+    while ((e = blockcache_find(dev, ino, mtime, file_size, index)) &&
+           e->loading)
+        pthread_cond_wait(&_blockcache_cond, &_blockcache_lock);
+
+    if (e && e->size >= 0) {
+        _blockcache_hits++;
+    } else {
+        /* a failed load is retried by the next reader */
+        if (e)
+            blockcache_remove(e);
+
+        _blockcache_misses++;
+
+        e = av_mallocz(sizeof(*e));
+        if (e)
+            e->data = av_malloc(BLOCKCACHE_BLOCK_SIZE);
+        if (!e || !e->data) {
+            av_free(e);
+            pthread_mutex_unlock(&_blockcache_lock);
+            return AVERROR(ENOMEM);
+        }
+        e->dev = dev;
+        e->ino = ino;
+        e->mtime = mtime;
+        e->file_size = file_size;
+        e->index = index;
+        e->loading = 1;
+
+        {
+            unsigned h = blockcache_hash(dev, ino, index);
+            e->hash_next = _blockcache_buckets[h];
+            _blockcache_buckets[h] = e;
+        }
+        blockcache_lru_push(e);
+        _blockcache_size += BLOCKCACHE_BLOCK_SIZE;
+
+        /* other sessions wait for this read instead of repeating it */
+        pthread_mutex_unlock(&_blockcache_lock);
+        ret = blockcache_load(fd, e);
+        pthread_mutex_lock(&_blockcache_lock);
+
+        e->size = ret;
+        e->loading = 0;
+        pthread_cond_broadcast(&_blockcache_cond);
+
+        if (ret < 0) {
+            blockcache_remove(e);
+            pthread_mutex_unlock(&_blockcache_lock);
+            return ret;
+        }
+    }
+
+    blockcache_lru_unlink(e);
+    blockcache_lru_push(e);
+
+    ret = FFMAX(0, FFMIN(size, e->size - block_offset));
+    memcpy(buf, e->data + block_offset, ret);
+
+    blockcache_trim();
+
+    pthread_mutex_unlock(&_blockcache_lock);
+
+    return ret;
+}
+
+void av_blockcache_set_size(int64_t size) {
+    pthread_mutex_lock(&_blockcache_lock);
+    _blockcache_max_size = FFMAX(size, 0);
+    blockcache_trim();
+    pthread_mutex_unlock(&_blockcache_lock);
+}
+
+void av_blockcache_get_stats(int64_t *hits, int64_t *misses,
+                             int64_t *evictions, int64_t *size,
+                             int64_t *max_size) {
+    pthread_mutex_lock(&_blockcache_lock);
+    *hits = _blockcache_hits;
+    *misses = _blockcache_misses;
+    *evictions = _blockcache_evictions;
+    *size = _blockcache_size;
+    *max_size = _blockcache_max_size;
+    pthread_mutex_unlock(&_blockcache_lock);
+}
@@ -32,4 +32,61 @@ void av_set_saf_open(saf_open_function);
 
 void av_set_saf_close(saf_close_function);
 
+/**
+ * Opens the memory handle with the given id for the given AVIO_FLAG_* flags.
+ * Returns 1 if the handle is seekable, 0 if it is not and a negative AVERROR
+ * code on failure.
+ */
+typedef int (*memory_open_function)(int, int);
+
+/**
+ * Returns the number of bytes read, 0 at the end of the stream and a negative
+ * AVERROR code on failure.
+ */
+typedef int (*memory_read_function)(int, uint8_t *, int);
+
+typedef int (*memory_write_function)(int, const uint8_t *, int);
+
+/**
+ * Accepts SEEK_SET, SEEK_CUR, SEEK_END and AVSEEK_SIZE as whence.
+ */
+typedef int64_t (*memory_seek_function)(int, int64_t, int);
+
+memory_open_function av_get_memory_open(void);
+
+memory_read_function av_get_memory_read(void);
+
+memory_write_function av_get_memory_write(void);
+
+memory_seek_function av_get_memory_seek(void);
+
+void av_set_memory_open(memory_open_function);
+
+void av_set_memory_read(memory_read_function);
+
+void av_set_memory_write(memory_write_function);
+
+void av_set_memory_seek(memory_seek_function);
+
+/**
+ * Reads from a regular file through the process wide block cache, shared by
+ * all sessions. dev, ino, mtime and file_size identify the version of the
+ * file. At most the rest of the block that contains offset is read.
+ *
+ * Returns the number of bytes read, 0 at the end of the file and a negative
+ * AVERROR code on failure.
+ */
+int av_blockcache_read(int fd, uint64_t dev, uint64_t ino, int64_t mtime,
+                       int64_t file_size, int64_t offset, uint8_t *buf,
+                       int size);
+
+/**
+ * Sets the memory limit of the block cache in bytes, 0 disables caching.
+ */
+void av_blockcache_set_size(int64_t size);
+
+void av_blockcache_get_stats(int64_t *hits, int64_t *misses,
+                             int64_t *evictions, int64_t *size,
+                             int64_t *max_size);
+
 #endif /* AVUTIL_FILE_FFMPEG_KIT_PROTOCOLS_H */